@@ -0,0 +1,331 @@
+/*******************************************************************************
+* Title                 :   Systick Benchmarks
+* Filename              :   bench/systick_bench.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host (simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file bench/systick_bench.c
+ *  @brief Benchmarks of the driver hot paths, run against the simulator so
+ *  		that interrupt timing is reproducible. Each result is printed as
+ *  		one JSON object per line, for diffing between releases:
+ *
+ *  - read_path: host nanoseconds per call of the tick readers, with the tick
+ *    interrupt preempting the readers as often as every few calls.
+ *  - dispatch: host nanoseconds per systick_irq_handler for 0 up to
+ *    SYSTICK_DISPATCH_MAX_SUBSCRIBERS subscribers.
+ *  - delay: overshoot distribution of systick_delay_us and systick_delay in
+ *    virtual time, at several tick rates.
+ *  - profile: cost of an empty profiler zone, in profiler clocks.
+ *
+ *  Build from the repository root:
+ *
+ *      gcc -O2 -Isim -I. bench/systick_bench.c $(ls systick*.c | grep -v linux) \
+ *          sim/systick_sim.c -o systick_bench
+ *
+ *  Host nanoseconds depend on the build machine; compare them between runs
+ *  on the same machine only. Virtual time results are exact.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_profile.h"
+#include "systick_sim.h"
+
+/**
+ * Core clock used by every benchmark
+ */
+#define BENCH_CORE_HZ			(16000000UL)
+
+/**
+ * Calls per read path measurement
+ */
+#define BENCH_READ_CALLS		(2000000UL)
+
+/**
+ * Virtual cycles between two reader calls in the read path benchmark,
+ * together with BENCH_READ_TICK_HZ it makes a tick every 20 reader calls
+ */
+#define BENCH_READ_STEP			(10UL)
+
+/**
+ * Tick rate of the read path benchmark, far above normal to force contention
+ */
+#define BENCH_READ_TICK_HZ		(80000UL)
+
+/**
+ * Handler calls per dispatch measurement
+ */
+#define BENCH_DISPATCH_CALLS	(1000000UL)
+
+/**
+ * Delays measured per delay distribution
+ */
+#define BENCH_DELAY_RUNS		(400U)
+
+/**
+ * Virtual cycles consumed per register access in the delay benchmark
+ */
+#define BENCH_DELAY_AUTOSTEP	(7UL)
+
+/**
+ * Tick reader under test
+ */
+typedef struct
+{
+	const char *name;			/**<Function name as printed */
+	void (*call)(void);			/**<Calls the reader once */
+}bench_reader_t;
+
+static volatile uint64_t sink;	/**<Keeps reader results alive */
+
+static void read_none(void)		{ }
+static void read_tick(void)		{ sink += systick_get_tick(); }
+static void read_tick64(void)	{ sink += systick_get_tick64(); }
+static void read_cycles(void)	{ sink += systick_get_cycles(); }
+static void read_time_us(void)	{ sink += systick_get_time_us(); }
+
+/**
+ * Distinct subscribers, the dispatch table holds each function once
+ */
+static void sub0(void) { sink++; }
+static void sub1(void) { sink++; }
+static void sub2(void) { sink++; }
+static void sub3(void) { sink++; }
+static void sub4(void) { sink++; }
+static void sub5(void) { sink++; }
+static void sub6(void) { sink++; }
+static void sub7(void) { sink++; }
+
+static systick_callback_t const subscribers[] = {sub0, sub1, sub2, sub3, sub4, sub5, sub6, sub7};
+
+static uint32_t ticks_seen;		/**<Tick interrupts taken during a measurement */
+
+/**
+ * Counts tick interrupts on top of the driver handler
+ */
+static void bench_tick_handler(void)
+{
+	systick_irq_handler();
+	ticks_seen++;
+}
+
+/**
+ * Host monotonic time in nanoseconds
+ */
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+}
+
+/**
+ * Resets the simulator and starts the systick at the given rate
+ */
+static void bench_start(uint32_t tick_hz, uint32_t autostep)
+{
+	systick_config_t config = {SYSTICK_ENABLED, tick_hz, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+
+	systick_sim_reset();
+	SystemCoreClock = BENCH_CORE_HZ;
+	systick_dispatch_init();
+	systick_init(&config);
+	systick_sim_vector_set(SysTick_IRQn, bench_tick_handler);
+	systick_sim_autostep_set(autostep);
+}
+
+/**
+ * qsort comparison of two int64_t
+ */
+static int bench_compare(const void *a, const void *b)
+{
+	int64_t x = *(const int64_t *)a;
+	int64_t y = *(const int64_t *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * Tick reader cost while the tick interrupt keeps preempting the readers.
+ * Virtual time is stepped between calls so the readers that touch no
+ * register are preempted as often as the others; the baseline row is the
+ * cost of that step and of the preempting handlers alone.
+ */
+static void bench_read_path(void)
+{
+	static const bench_reader_t readers[] =
+	{
+		{"baseline", read_none},
+		{"systick_get_tick", read_tick},
+		{"systick_get_tick64", read_tick64},
+		{"systick_get_cycles", read_cycles},
+		{"systick_get_time_us", read_time_us}
+	};
+	uint64_t start;
+	uint64_t spent;
+	uint32_t r;
+	uint32_t i;
+
+	for (r = 0; r < (sizeof(readers) / sizeof(readers[0])); r++)
+	{
+		bench_start(BENCH_READ_TICK_HZ, 0UL);
+		ticks_seen = 0;
+		start = bench_now_ns();
+		for (i = 0; i < BENCH_READ_CALLS; i++)
+		{
+			systick_sim_advance(BENCH_READ_STEP);
+			readers[r].call();
+		}
+		spent = bench_now_ns() - start;
+		printf("{\"bench\":\"read_path\",\"fn\":\"%s\",\"calls\":%lu,\"isr_preemptions\":%lu,"
+			   "\"ns_per_call\":%.2f}\n", readers[r].name, (unsigned long)BENCH_READ_CALLS,
+			   (unsigned long)ticks_seen, (double)spent / BENCH_READ_CALLS);
+	}
+}
+
+/**
+ * Tick handler cost against the number of subscribers
+ */
+static void bench_dispatch(void)
+{
+	uint64_t start;
+	uint64_t spent;
+	uint32_t count;
+	uint32_t i;
+
+	for (count = 0; count <= SYSTICK_DISPATCH_MAX_SUBSCRIBERS; count++)
+	{
+		bench_start(1000UL, 0UL);
+		for (i = 0; (i < count) && (i < (sizeof(subscribers) / sizeof(subscribers[0]))); i++)
+		{
+			(void)systick_subscribe(subscribers[i], 1, (uint8_t)i);
+		}
+		start = bench_now_ns();
+		for (i = 0; i < BENCH_DISPATCH_CALLS; i++)
+		{
+			systick_irq_handler();
+		}
+		spent = bench_now_ns() - start;
+		printf("{\"bench\":\"dispatch\",\"subscribers\":%lu,\"calls\":%lu,\"ns_per_tick\":%.2f}\n",
+			   (unsigned long)systick_subscriber_count(), (unsigned long)BENCH_DISPATCH_CALLS,
+			   (double)spent / BENCH_DISPATCH_CALLS);
+	}
+}
+
+/**
+ * Prints the distribution of runs overshoots, in virtual nanoseconds. A
+ * negative overshoot is a delay that returned early; those are also counted.
+ */
+static void bench_delay_print(const char *fn, uint32_t tick_hz, int64_t *overshoot_cycles)
+{
+	double to_ns = 1e9 / BENCH_CORE_HZ;
+	uint32_t early = 0;
+	uint32_t i;
+
+	qsort(overshoot_cycles, BENCH_DELAY_RUNS, sizeof(int64_t), bench_compare);
+	for (i = 0; (i < BENCH_DELAY_RUNS) && (overshoot_cycles[i] < 0); i++)
+	{
+		early++;
+	}
+	printf("{\"bench\":\"delay\",\"fn\":\"%s\",\"tick_hz\":%lu,\"runs\":%u,\"early\":%lu,\"overshoot_ns\":"
+		   "{\"min\":%.0f,\"p50\":%.0f,\"p90\":%.0f,\"p99\":%.0f,\"max\":%.0f}}\n",
+		   fn, (unsigned long)tick_hz, BENCH_DELAY_RUNS, (unsigned long)early,
+		   overshoot_cycles[0] * to_ns,
+		   overshoot_cycles[BENCH_DELAY_RUNS / 2U] * to_ns,
+		   overshoot_cycles[(BENCH_DELAY_RUNS * 9U) / 10U] * to_ns,
+		   overshoot_cycles[(BENCH_DELAY_RUNS * 99U) / 100U] * to_ns,
+		   overshoot_cycles[BENCH_DELAY_RUNS - 1U] * to_ns);
+}
+
+/**
+ * Overshoot of the microsecond and millisecond delays at several tick rates,
+ * from a random phase within the tick each time
+ */
+static void bench_delay(void)
+{
+	static const uint32_t tick_rates[] = {100UL, 1000UL, 1500UL, 10000UL};
+	static int64_t overshoot[BENCH_DELAY_RUNS];
+	uint64_t start;
+	uint64_t wanted;
+	uint32_t delay;
+	uint32_t r;
+	uint32_t i;
+
+	srand(1);
+	for (r = 0; r < (sizeof(tick_rates) / sizeof(tick_rates[0])); r++)
+	{
+		bench_start(tick_rates[r], BENCH_DELAY_AUTOSTEP);
+		for (i = 0; i < BENCH_DELAY_RUNS; i++)
+		{
+			systick_sim_advance((uint64_t)rand() % (BENCH_CORE_HZ / tick_rates[r]));
+			delay = 1UL + ((uint32_t)rand() % 2000UL);
+			start = systick_sim_cycles();
+			(void)systick_delay_us(delay);
+			wanted = ((uint64_t)delay * BENCH_CORE_HZ) / 1000000ULL;
+			overshoot[i] = (int64_t)(systick_sim_cycles() - start) - (int64_t)wanted;
+		}
+		bench_delay_print("systick_delay_us", tick_rates[r], overshoot);
+
+		for (i = 0; i < BENCH_DELAY_RUNS; i++)
+		{
+			systick_sim_advance((uint64_t)rand() % (BENCH_CORE_HZ / tick_rates[r]));
+			delay = 1UL + ((uint32_t)rand() % 20UL);
+			start = systick_sim_cycles();
+			systick_delay(delay);
+			wanted = ((uint64_t)delay * BENCH_CORE_HZ) / 1000ULL;
+			overshoot[i] = (int64_t)(systick_sim_cycles() - start) - (int64_t)wanted;
+		}
+		bench_delay_print("systick_delay", tick_rates[r], overshoot);
+	}
+}
+
+/**
+ * Profiler marker cost as measured by the profiler itself
+ */
+static void bench_profile(void)
+{
+	bench_start(1000UL, BENCH_DELAY_AUTOSTEP);
+	systick_profile_init();
+	printf("{\"bench\":\"profile\",\"marker_overhead_clocks\":%lu,\"clock_hz\":%lu,"
+		   "\"sim_cycles_per_access\":%lu}\n", (unsigned long)systick_profile_overhead(),
+		   (unsigned long)systick_profile_clock_hz(), (unsigned long)BENCH_DELAY_AUTOSTEP);
+}
+
+int main(void)
+{
+	bench_read_path();
+	bench_dispatch();
+	bench_delay();
+	bench_profile();
+	return (0);
+}
@@ -0,0 +1,196 @@
+/*******************************************************************************
+* Title                 :   Cortex-M4 Core Header (Simulator)
+* Filename              :   core_cm4.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Linux (systick simulator)
+* Notes                 :   Stand-in for the CMSIS core header, only the parts
+*                           used by the systick driver are provided
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file sim/core_cm4.h
+ *  @brief Minimal replacement of CMSIS core_cm4.h which routes every SysTick,
+ *  		SCB, DWT and CoreDebug access, the NVIC calls and the core
+ *  		intrinsics into the simulator in systick_sim.c.
+ *
+ *  SysTick, SCB, DWT and CoreDebug are function calls returning the simulated register blocks.
+ *  The simulator uses each access as a synchronisation point: it picks up
+ *  what software wrote since the previous access, optionally advances virtual
+ *  time and takes pending exceptions, just as an interrupt would preempt the
+ *  instruction stream on target.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef __CORE_CM4_H_GENERIC
+#define __CORE_CM4_H_GENERIC
+
+#include <stdint.h>
+
+/**
+ * SysTick register block, layout as in CMSIS
+ */
+typedef struct
+{
+	volatile uint32_t CTRL;		/**<Control and status register */
+	volatile uint32_t LOAD;		/**<Reload value register */
+	volatile uint32_t VAL;		/**<Current value register */
+	volatile uint32_t CALIB;	/**<Calibration register */
+}SysTick_Type;
+
+/**
+ * System control block, only the registers the simulator models
+ */
+typedef struct
+{
+	volatile uint32_t CPUID;	/**<CPUID base register */
+	volatile uint32_t ICSR;		/**<Interrupt control and state register */
+}SCB_Type;
+
+/**
+ * Data watchpoint and trace unit, only the cycle counter
+ */
+typedef struct
+{
+	volatile uint32_t CTRL;		/**<Control register */
+	volatile uint32_t CYCCNT;	/**<Cycle count register */
+}DWT_Type;
+
+/**
+ * Core debug registers
+ */
+typedef struct
+{
+	volatile uint32_t DHCSR;	/**<Debug halting control and status register */
+	volatile uint32_t DCRSR;	/**<Debug core register selector register */
+	volatile uint32_t DCRDR;	/**<Debug core register data register */
+	volatile uint32_t DEMCR;	/**<Debug exception and monitor control register */
+}CoreDebug_Type;
+
+#define SysTick_CTRL_COUNTFLAG_Pos		16U
+#define SysTick_CTRL_COUNTFLAG_Msk		(1UL << SysTick_CTRL_COUNTFLAG_Pos)
+#define SysTick_CTRL_CLKSOURCE_Pos		2U
+#define SysTick_CTRL_CLKSOURCE_Msk		(1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_TICKINT_Pos		1U
+#define SysTick_CTRL_TICKINT_Msk		(1UL << SysTick_CTRL_TICKINT_Pos)
+#define SysTick_CTRL_ENABLE_Pos			0U
+#define SysTick_CTRL_ENABLE_Msk			(1UL << SysTick_CTRL_ENABLE_Pos)
+
+#define SysTick_LOAD_RELOAD_Pos			0U
+#define SysTick_LOAD_RELOAD_Msk			(0xFFFFFFUL << SysTick_LOAD_RELOAD_Pos)
+
+#define SysTick_VAL_CURRENT_Pos			0U
+#define SysTick_VAL_CURRENT_Msk			(0xFFFFFFUL << SysTick_VAL_CURRENT_Pos)
+
+#define SysTick_CALIB_NOREF_Pos			31U
+#define SysTick_CALIB_NOREF_Msk			(1UL << SysTick_CALIB_NOREF_Pos)
+#define SysTick_CALIB_SKEW_Pos			30U
+#define SysTick_CALIB_SKEW_Msk			(1UL << SysTick_CALIB_SKEW_Pos)
+#define SysTick_CALIB_TENMS_Pos			0U
+#define SysTick_CALIB_TENMS_Msk			(0xFFFFFFUL << SysTick_CALIB_TENMS_Pos)
+
+#define SCB_ICSR_PENDSVSET_Pos			28U
+#define SCB_ICSR_PENDSVSET_Msk			(1UL << SCB_ICSR_PENDSVSET_Pos)
+#define SCB_ICSR_PENDSVCLR_Pos			27U
+#define SCB_ICSR_PENDSVCLR_Msk			(1UL << SCB_ICSR_PENDSVCLR_Pos)
+#define SCB_ICSR_PENDSTSET_Pos			26U
+#define SCB_ICSR_PENDSTSET_Msk			(1UL << SCB_ICSR_PENDSTSET_Pos)
+#define SCB_ICSR_PENDSTCLR_Pos			25U
+#define SCB_ICSR_PENDSTCLR_Msk			(1UL << SCB_ICSR_PENDSTCLR_Pos)
+
+#define DWT_CTRL_NOCYCCNT_Pos			25U
+#define DWT_CTRL_NOCYCCNT_Msk			(1UL << DWT_CTRL_NOCYCCNT_Pos)
+#define DWT_CTRL_CYCCNTENA_Pos			0U
+#define DWT_CTRL_CYCCNTENA_Msk			(1UL << DWT_CTRL_CYCCNTENA_Pos)
+
+#define CoreDebug_DEMCR_TRCENA_Pos		24U
+#define CoreDebug_DEMCR_TRCENA_Msk		(1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+SysTick_Type *systick_sim_systick(void);
+SCB_Type *systick_sim_scb(void);
+DWT_Type *systick_sim_dwt(void);
+CoreDebug_Type *systick_sim_coredebug(void);
+void systick_sim_nvic_priority_set(int32_t irq, uint32_t priority);
+void systick_sim_nvic_enable(int32_t irq, uint32_t enable);
+void systick_sim_primask_set(uint32_t primask);
+uint32_t systick_sim_primask_get(void);
+void systick_sim_basepri_set(uint32_t basepri, uint32_t raise_only);
+uint32_t systick_sim_basepri_get(void);
+void systick_sim_wfi(void);
+void systick_sim_wfe(void);
+void systick_sim_sev(void);
+void systick_sim_nop(void);
+
+#define SysTick		(systick_sim_systick())	/**<Simulated SysTick register block */
+#define SCB			(systick_sim_scb())		/**<Simulated system control block */
+#define DWT			(systick_sim_dwt())		/**<Simulated cycle counter */
+#define CoreDebug	(systick_sim_coredebug())	/**<Simulated core debug registers */
+
+/**
+ * CMSIS NVIC_SetPriority, recorded by the simulator
+ */
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+	systick_sim_nvic_priority_set((int32_t)IRQn, priority);
+}
+
+/**
+ * CMSIS NVIC_EnableIRQ, gates a peripheral interrupt in the simulator
+ */
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	systick_sim_nvic_enable((int32_t)IRQn, 1U);
+}
+
+/**
+ * CMSIS NVIC_DisableIRQ
+ */
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	systick_sim_nvic_enable((int32_t)IRQn, 0U);
+}
+
+/**
+ * CMSIS NVIC_ClearPendingIRQ. Peripheral interrupts are modelled as level
+ * sensitive lines with nothing latched, so there is nothing to clear.
+ */
+static inline void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+	(void)IRQn;
+}
+
+static inline void __disable_irq(void)				{ systick_sim_primask_set(1U); }
+static inline void __enable_irq(void)				{ systick_sim_primask_set(0U); }
+static inline uint32_t __get_PRIMASK(void)			{ return (systick_sim_primask_get()); }
+static inline void __set_PRIMASK(uint32_t primask)	{ systick_sim_primask_set(primask); }
+static inline uint32_t __get_BASEPRI(void)			{ return (systick_sim_basepri_get()); }
+static inline void __set_BASEPRI(uint32_t basepri)	{ systick_sim_basepri_set(basepri, 0U); }
+static inline void __set_BASEPRI_MAX(uint32_t basepri)	{ systick_sim_basepri_set(basepri, 1U); }
+static inline void __WFI(void)						{ systick_sim_wfi(); }
+static inline void __WFE(void)						{ systick_sim_wfe(); }
+static inline void __SEV(void)						{ systick_sim_sev(); }
+static inline void __DMB(void)						{ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB(void)						{ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB(void)						{ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __NOP(void)						{ systick_sim_nop(); }
+
+#endif
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Title                 :   STM32F411 Device Header (Simulator)
+* Filename              :   stm32f411xe.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Linux (systick simulator)
+* Notes                 :   Stand-in for the ST device header, only the parts
+*                           used by the systick driver are provided
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file sim/stm32f411xe.h
+ *  @brief Minimal replacement of the STM32F411 device header for host builds
+ *  		against the systick simulator. Put the sim directory first on the
+ *  		include path so this file shadows the vendor one.
+ *
+ *  TIM5 and RCC are function calls into systick_sim.c, synchronisation
+ *  points like the core registers of core_cm4.h.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef __STM32F411xE_H
+#define __STM32F411xE_H
+
+/**
+ * Interrupt numbers known to the simulator, matching the STM32F411 vector table
+ */
+typedef enum
+{
+	PendSV_IRQn		= -2,	/**<Pendable request for system service */
+	SysTick_IRQn	= -1,	/**<System tick timer */
+	TIM5_IRQn		= 50	/**<TIM5 global interrupt */
+}IRQn_Type;
+
+/**
+ * Number of NVIC priority bits implemented, as on the STM32F4
+ */
+#define __NVIC_PRIO_BITS	4U
+
+#include "core_cm4.h"
+
+/**
+ * General purpose timer registers, only those the simulator models
+ */
+typedef struct
+{
+	volatile uint32_t CR1;		/**<Control register 1 */
+	volatile uint32_t DIER;		/**<DMA/interrupt enable register */
+	volatile uint32_t SR;		/**<Status register, flags cleared by writing 0 */
+	volatile uint32_t EGR;		/**<Event generation register */
+	volatile uint32_t CNT;		/**<Counter */
+	volatile uint32_t PSC;		/**<Prescaler */
+	volatile uint32_t ARR;		/**<Auto-reload register */
+}TIM_TypeDef;
+
+/**
+ * Reset and clock control registers, only those the simulator models
+ */
+typedef struct
+{
+	volatile uint32_t CFGR;		/**<Clock configuration register */
+	volatile uint32_t APB1ENR;	/**<APB1 peripheral clock enable register */
+}RCC_TypeDef;
+
+#define TIM_CR1_CEN_Pos					0U
+#define TIM_CR1_CEN						(1UL << TIM_CR1_CEN_Pos)
+#define TIM_DIER_UIE_Pos				0U
+#define TIM_DIER_UIE					(1UL << TIM_DIER_UIE_Pos)
+#define TIM_SR_UIF_Pos					0U
+#define TIM_SR_UIF						(1UL << TIM_SR_UIF_Pos)
+#define TIM_EGR_UG_Pos					0U
+#define TIM_EGR_UG						(1UL << TIM_EGR_UG_Pos)
+
+#define RCC_CFGR_PPRE1_Pos				10U
+#define RCC_CFGR_PPRE1					(0x7UL << RCC_CFGR_PPRE1_Pos)
+#define RCC_APB1ENR_TIM5EN_Pos			3U
+#define RCC_APB1ENR_TIM5EN				(1UL << RCC_APB1ENR_TIM5EN_Pos)
+
+TIM_TypeDef *systick_sim_tim5(void);
+RCC_TypeDef *systick_sim_rcc(void);
+
+#define TIM5		(systick_sim_tim5())	/**<Simulated TIM5 register block */
+#define RCC			(systick_sim_rcc())		/**<Simulated reset and clock control */
+
+#endif
@@ -0,0 +1,1207 @@
+/*******************************************************************************
+* Title                 :   Systick Simulator
+* Filename              :   systick_sim.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Linux (systick simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file sim/systick_sim.c
+ *  @brief Cycle-level model of the SysTick peripheral and of the two system
+ *  exceptions the driver uses (SysTick and PendSV).
+ *
+ *  Modelled behaviour:
+ *  - the counter decrements once per counter clock (core clock, or core
+ *    clock / 8 for the external reference as on the STM32F4), sets COUNTFLAG
+ *    and pends the SysTick exception on the 1 -> 0 transition (if TICKINT),
+ *    and reloads from LOAD on the following clock.
+ *  - a write to VAL clears it and COUNTFLAG. Writes are detected by comparing
+ *    against the last published value, so writing the value VAL already holds
+ *    goes unnoticed.
+ *  - COUNTFLAG is not cleared by reads of CTRL, which the model cannot see.
+ *  - enabling the counter while VAL is 0 reloads it at once, and the reload
+ *    still takes the first counter clock. Hardware reloads on that first clock,
+ *    before the next instruction can rewrite LOAD or read VAL back as 0; the
+ *    model only sees time move when told to, so it moves the reload to the
+ *    enable instead.
+ *  - the DWT cycle counter counts core cycles while both DEMCR.TRCENA and
+ *    DWT_CTRL.CYCCNTENA are set, and may be written like on target.
+ *  - TIM5 counts up at the APB1 timer clock divided by PSC + 1 while its
+ *    RCC clock and CR1.CEN are enabled, and on the clock after CNT reaches ARR
+ *    it restarts from 0 and sets SR.UIF. EGR.UG does the same at once and
+ *    loads PSC. Its interrupt line is UIF & UIE, gated by NVIC_EnableIRQ.
+ *  - pending exceptions are taken at the next synchronisation point while
+ *    PRIMASK is clear and BASEPRI does not mask their priority; SysTick and
+ *    TIM5 preempt PendSV, none preempts itself or the other.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_sim.h"
+#include "systick_interface.h"
+#include "systick_instance.h"
+#if SYSTICK_DEFER_ENABLED
+#include "systick_defer.h"
+#endif
+
+/**
+ * Value reported when no counter event is scheduled
+ */
+#define SIM_NEVER		(0xFFFFFFFFFFFFFFFFULL)
+
+/**
+ * Number of exceptions the vector table holds, indexed by -IRQn
+ */
+#define SIM_NUM_VECTORS	(3U)
+
+/**
+ * Execution levels, a handler may only preempt a lower level
+ */
+typedef enum
+{
+	SIM_LEVEL_THREAD,
+	SIM_LEVEL_PENDSV,
+	SIM_LEVEL_SYSTICK
+}sim_level_t;
+
+/**
+ * Virtual core clock. Starts at the 16 MHz HSI like the STM32F411 out of reset.
+ */
+uint32_t SystemCoreClock = 16000000UL;
+
+static SysTick_Type systick_regs;			/**<Registers as seen by software */
+static SCB_Type scb_regs;					/**<SCB as seen by software */
+static uint32_t published_val;				/**<VAL as last published by the model */
+static uint32_t published_icsr;				/**<ICSR as last published by the model */
+static uint32_t was_enabled;				/**<CTRL.ENABLE at the last synchronisation */
+static uint32_t reload_hold;				/**<Next counter clock is the reload done at enable */
+static DWT_Type dwt_regs;					/**<DWT as seen by software */
+static CoreDebug_Type coredebug_regs;		/**<CoreDebug as seen by software */
+static uint32_t published_cyccnt;			/**<CYCCNT as last published by the model */
+static uint32_t cyccnt_running;				/**<Cycle counter enabled at the last synchronisation */
+static uint32_t cyccnt_offset;				/**<CYCCNT minus the low word of sim_cycles */
+static TIM_TypeDef tim5_regs;				/**<TIM5 as seen by software */
+static RCC_TypeDef rcc_regs;				/**<RCC as seen by software */
+static uint32_t published_tim5_sr;			/**<TIM5 SR as last published by the model */
+static uint32_t published_tim5_cnt;			/**<TIM5 CNT as last published by the model */
+static uint32_t tim5_psc;					/**<Prescaler in effect, loaded on update events */
+static uint64_t tim5_phase;					/**<Core cycles since the last TIM5 count */
+static uint32_t tim5_irq_enabled;			/**<NVIC enable of TIM5_IRQn */
+
+static uint64_t sim_cycles;					/**<Virtual core cycles since reset */
+static uint32_t prescale_phase;				/**<Core cycles since the last counter clock */
+static uint32_t autostep_cycles;			/**<Cycles consumed by each register access */
+static uint64_t wake_cycle = SIM_NEVER;		/**<Next externally scheduled wake-up */
+static uint32_t event_register;				/**<WFE event latch */
+static int32_t clock_error_ppb;				/**<Error of the simulated oscillator against SystemCoreClock */
+
+static uint32_t primask;					/**<Simulated PRIMASK */
+static uint32_t basepri;					/**<Simulated BASEPRI */
+static uint32_t systick_pending;			/**<SysTick exception pending */
+static uint32_t pendsv_pending;				/**<PendSV exception pending */
+static sim_level_t active_level;			/**<Level of the code currently executing */
+static uint32_t in_model;					/**<Set while the model itself is stepping */
+static uint32_t priorities[SIM_NUM_VECTORS];	/**<Priorities set through NVIC_SetPriority */
+static uint32_t tim5_priority;				/**<Priority of TIM5_IRQn */
+
+/**
+ * Default TIM5 vector, the second tick source of systick_instance.c
+ */
+static void sim_tim5_default_handler(void)
+{
+	systick_instance_irq_handler(SYSTICK_2);
+}
+
+/**
+ * Vector table, indexed by -IRQn. SysTick and PendSV default to the driver
+ * handlers, PendSV only when SYSTICK_DEFER_ENABLED is set.
+ */
+#if SYSTICK_DEFER_ENABLED
+static systick_sim_handler_t vectors[SIM_NUM_VECTORS] = {NULL, systick_irq_handler, systick_defer_handler};
+#else
+static systick_sim_handler_t vectors[SIM_NUM_VECTORS] = {NULL, systick_irq_handler, NULL};
+#endif
+static systick_sim_handler_t tim5_vector = sim_tim5_default_handler;	/**<TIM5_IRQn handler */
+
+/**
+ * Picks up software writes to TIM5: counter writes, software update events
+ * and flags cleared by writing 0
+ */
+static void sim_tim5_sync_in(void)
+{
+	if (tim5_regs.CNT != published_tim5_cnt)
+	{
+		tim5_phase = 0;
+	}
+	if (tim5_regs.SR != published_tim5_sr)
+	{
+		tim5_regs.SR &= published_tim5_sr;
+	}
+	if (tim5_regs.EGR & TIM_EGR_UG)
+	{
+		tim5_regs.CNT = 0UL;
+		tim5_psc = tim5_regs.PSC;
+		tim5_phase = 0;
+		tim5_regs.SR |= TIM_SR_UIF;
+	}
+	tim5_regs.EGR = 0UL;
+}
+
+/**
+ * Publishes the TIM5 state so later software writes can be told apart
+ */
+static void sim_tim5_sync_out(void)
+{
+	published_tim5_sr = tim5_regs.SR;
+	published_tim5_cnt = tim5_regs.CNT;
+}
+
+/**
+ * Non-zero while TIM5 is counting
+ */
+static uint32_t sim_tim5_running(void)
+{
+	return (((rcc_regs.APB1ENR & RCC_APB1ENR_TIM5EN) != 0) && ((tim5_regs.CR1 & TIM_CR1_CEN) != 0)
+			&& (tim5_regs.ARR != 0));
+}
+
+/**
+ * Non-zero while the TIM5 interrupt line is raised and enabled in the NVIC
+ */
+static uint32_t sim_tim5_irq_raised(void)
+{
+	return ((tim5_irq_enabled != 0) && ((tim5_regs.SR & TIM_SR_UIF) != 0)
+			&& ((tim5_regs.DIER & TIM_DIER_UIE) != 0));
+}
+
+/**
+ * Core cycles per TIM5 count: the APB1 timer clock as the port derives it
+ * from RCC_CFGR, then the prescaler
+ */
+static uint64_t sim_tim5_divider(void)
+{
+	uint32_t ppre1 = (rcc_regs.CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+	uint64_t apb1_divider = (ppre1 < 4UL) ? 1ULL : (1ULL << (ppre1 - 4UL));
+
+	return (apb1_divider * ((uint64_t)tim5_psc + 1ULL));
+}
+
+/**
+ * Number of core cycles until the next TIM5 update event
+ */
+static uint64_t sim_tim5_cycles_to_update(void)
+{
+	uint64_t counts;
+
+	if (sim_tim5_running() == 0)
+	{
+		return (SIM_NEVER);
+	}
+	counts = (tim5_regs.CNT < tim5_regs.ARR) ? ((uint64_t)tim5_regs.ARR - tim5_regs.CNT + 1ULL) : 1ULL;
+	return ((counts * sim_tim5_divider()) - tim5_phase);
+}
+
+/**
+ * Advances TIM5 by a number of core cycles in constant time and returns the
+ * number of update events on the way. Does not move sim_cycles.
+ */
+static uint64_t sim_tim5_step(uint64_t cycles)
+{
+	uint64_t divider;
+	uint64_t counts;
+	uint64_t to_update;
+	uint64_t period;
+	uint64_t updates = 0;
+
+	if (sim_tim5_running() == 0)
+	{
+		return (0);
+	}
+	divider = sim_tim5_divider();
+	counts = (tim5_phase + cycles) / divider;
+	tim5_phase = (tim5_phase + cycles) % divider;
+	to_update = (tim5_regs.CNT < tim5_regs.ARR) ? ((uint64_t)tim5_regs.ARR - tim5_regs.CNT + 1ULL) : 1ULL;
+	if (counts < to_update)
+	{
+		tim5_regs.CNT += (uint32_t)counts;
+	}
+	else
+	{
+		counts -= to_update;
+		period = (uint64_t)tim5_regs.ARR + 1ULL;
+		updates = 1ULL + (counts / period);
+		tim5_regs.CNT = (uint32_t)(counts % period);
+		tim5_psc = tim5_regs.PSC;
+		tim5_regs.SR |= TIM_SR_UIF;
+	}
+	return (updates);
+}
+
+/**
+ * Picks up the register writes software has made since the last publish
+ */
+static void sim_sync_in(void)
+{
+	uint32_t icsr = scb_regs.ICSR;
+
+	sim_tim5_sync_in();
+	if (systick_regs.VAL != published_val)
+	{
+		systick_regs.VAL = 0UL;
+		systick_regs.CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+		reload_hold = 0;
+	}
+	systick_regs.LOAD &= SysTick_LOAD_RELOAD_Msk;
+
+	if (systick_regs.CTRL & SysTick_CTRL_ENABLE_Msk)
+	{
+		if ((was_enabled == 0) && (systick_regs.VAL == 0) && (systick_regs.LOAD != 0))
+		{
+			systick_regs.VAL = systick_regs.LOAD;
+			reload_hold = 1;
+		}
+		was_enabled = 1;
+	}
+	else
+	{
+		was_enabled = 0;
+	}
+
+	if (icsr != published_icsr)
+	{
+		if (icsr & SCB_ICSR_PENDSTCLR_Msk)
+		{
+			systick_pending = 0;
+		}
+		else if (icsr & SCB_ICSR_PENDSTSET_Msk)
+		{
+			systick_pending = 1;
+		}
+		if (icsr & SCB_ICSR_PENDSVCLR_Msk)
+		{
+			pendsv_pending = 0;
+		}
+		else if (icsr & SCB_ICSR_PENDSVSET_Msk)
+		{
+			pendsv_pending = 1;
+		}
+	}
+}
+
+/**
+ * Publishes the model state so later software writes can be told apart
+ */
+static void sim_sync_out(void)
+{
+	scb_regs.ICSR = (systick_pending ? SCB_ICSR_PENDSTSET_Msk : 0UL)
+				  | (pendsv_pending ? SCB_ICSR_PENDSVSET_Msk : 0UL);
+	published_icsr = scb_regs.ICSR;
+	published_val = systick_regs.VAL;
+	sim_tim5_sync_out();
+}
+
+/**
+ * Brings the cycle counter up to date, picking up software writes to CYCCNT
+ * and to its enable bits first
+ */
+static void sim_dwt_sync(void)
+{
+	uint32_t running = ((coredebug_regs.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0)
+					&& ((dwt_regs.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0);
+
+	if ((dwt_regs.CYCCNT != published_cyccnt) || (running != cyccnt_running))
+	{
+		cyccnt_offset = dwt_regs.CYCCNT - (uint32_t)sim_cycles;
+	}
+	cyccnt_running = running;
+	if (running != 0)
+	{
+		dwt_regs.CYCCNT = (uint32_t)sim_cycles + cyccnt_offset;
+	}
+	published_cyccnt = dwt_regs.CYCCNT;
+}
+
+/**
+ * Core clocks per counter clock for the selected clock source
+ */
+static uint32_t sim_divider(void)
+{
+	return ((systick_regs.CTRL & SysTick_CTRL_CLKSOURCE_Msk) ? 1UL : 8UL);
+}
+
+/**
+ * Number of core cycles until the next 1 -> 0 transition of the counter
+ */
+static uint64_t sim_cycles_to_underflow(void)
+{
+	uint64_t edges;
+
+	if ((systick_regs.CTRL & SysTick_CTRL_ENABLE_Msk) == 0)
+	{
+		return (SIM_NEVER);
+	}
+	if (systick_regs.VAL != 0)
+	{
+		edges = (uint64_t)systick_regs.VAL + reload_hold;
+	}
+	else if (systick_regs.LOAD != 0)
+	{
+		edges = (uint64_t)systick_regs.LOAD + 1ULL;
+	}
+	else
+	{
+		return (SIM_NEVER);
+	}
+	return ((edges * sim_divider()) - prescale_phase);
+}
+
+/**
+ * Advances the counter by a number of core cycles in constant time and
+ * returns how many 1 -> 0 transitions happened on the way
+ */
+static uint64_t sim_counter_step(uint64_t cycles)
+{
+	uint64_t edges;
+	uint64_t underflows = 0;
+	uint64_t period;
+	uint64_t remainder;
+	uint32_t divider = sim_divider();
+	uint32_t load = systick_regs.LOAD;
+	uint32_t val = systick_regs.VAL;
+
+	sim_cycles += cycles;
+	edges = ((uint64_t)prescale_phase + cycles) / divider;
+	prescale_phase = (uint32_t)(((uint64_t)prescale_phase + cycles) % divider);
+
+	if (((systick_regs.CTRL & SysTick_CTRL_ENABLE_Msk) == 0) || (edges == 0))
+	{
+		return (0);
+	}
+	if (reload_hold != 0)
+	{
+		reload_hold = 0;							/* reload edge, done at enable */
+		edges--;
+	}
+	else if (val == 0)
+	{
+		if (load == 0)
+		{
+			return (0);
+		}
+		val = load;									/* reload edge */
+		edges--;
+	}
+	if (edges < val)
+	{
+		val -= (uint32_t)edges;
+	}
+	else
+	{
+		edges -= val;
+		val = 0;
+		underflows = 1;
+		if (load != 0)
+		{
+			period = (uint64_t)load + 1ULL;
+			underflows += edges / period;
+			remainder = edges % period;
+			val = (remainder != 0) ? (uint32_t)(load - (remainder - 1ULL)) : 0UL;
+		}
+	}
+	systick_regs.VAL = val;
+	if (underflows != 0)
+	{
+		systick_regs.CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+	}
+	return (underflows);
+}
+
+/**
+ * Runs a handler at the given level, keeping the register view consistent
+ */
+static void sim_exception_run(systick_sim_handler_t handler, sim_level_t level)
+{
+	sim_level_t preempted = active_level;
+
+	active_level = level;
+	sim_sync_out();
+	handler();
+	sim_sync_in();
+	active_level = preempted;
+}
+
+/**
+ * Checks an exception priority against BASEPRI
+ */
+static uint32_t sim_unmasked(uint32_t priority)
+{
+	return ((basepri == 0) || ((priority << (8U - __NVIC_PRIO_BITS)) < basepri));
+}
+
+/**
+ * Takes every pending exception that may preempt the current level
+ */
+static void sim_dispatch(void)
+{
+	for (;;)
+	{
+		if (primask != 0)
+		{
+			return;
+		}
+		if (systick_pending && (active_level < SIM_LEVEL_SYSTICK) && (vectors[-SysTick_IRQn] != NULL)
+			&& sim_unmasked(priorities[-SysTick_IRQn]))
+		{
+			systick_pending = 0;
+			sim_exception_run(vectors[-SysTick_IRQn], SIM_LEVEL_SYSTICK);
+		}
+		else if (sim_tim5_irq_raised() && (active_level < SIM_LEVEL_SYSTICK) && (tim5_vector != NULL)
+				 && sim_unmasked(tim5_priority))
+		{
+			sim_exception_run(tim5_vector, SIM_LEVEL_SYSTICK);
+		}
+		else if (pendsv_pending && (active_level < SIM_LEVEL_PENDSV) && (vectors[-PendSV_IRQn] != NULL)
+				 && sim_unmasked(priorities[-PendSV_IRQn]))
+		{
+			pendsv_pending = 0;
+			sim_exception_run(vectors[-PendSV_IRQn], SIM_LEVEL_PENDSV);
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+/**
+ * Advances virtual time underflow by underflow, taking the tick exception at
+ * the exact cycle it is raised
+ */
+static void sim_run(uint64_t cycles)
+{
+	uint64_t to_event;
+	uint64_t to_update;
+
+	while (cycles > 0)
+	{
+		sim_sync_in();
+		to_event = sim_cycles_to_underflow();
+		to_update = sim_tim5_cycles_to_update();
+		if (to_update < to_event)
+		{
+			to_event = to_update;
+		}
+		if (to_event > cycles)
+		{
+			to_event = cycles;
+		}
+		in_model++;
+		(void)sim_tim5_step(to_event);
+		if ((sim_counter_step(to_event) != 0) && (systick_regs.CTRL & SysTick_CTRL_TICKINT_Msk))
+		{
+			systick_pending = 1;
+		}
+		in_model--;
+		cycles -= to_event;
+		sim_sync_out();
+		sim_dispatch();
+	}
+}
+
+/**
+ * Common part of every register access from driver code
+ */
+static void sim_access(void)
+{
+	if (in_model == 0)
+	{
+		sim_sync_in();
+		if (autostep_cycles != 0)
+		{
+			in_model++;
+			sim_run(autostep_cycles);
+			in_model--;
+		}
+		sim_sync_out();
+		if (in_model == 0)
+		{
+			sim_dispatch();
+		}
+	}
+}
+
+/**
+ * Advances time until the next event able to wake the core from sleep
+ */
+static void sim_sleep(void)
+{
+	uint64_t to_tick = SIM_NEVER;
+	uint64_t to_wake = SIM_NEVER;
+
+	uint64_t to_update = SIM_NEVER;
+
+	sim_sync_in();
+	if (systick_pending || pendsv_pending || sim_tim5_irq_raised())
+	{
+		return;
+	}
+	if (systick_regs.CTRL & SysTick_CTRL_TICKINT_Msk)
+	{
+		to_tick = sim_cycles_to_underflow();
+	}
+	if ((tim5_irq_enabled != 0) && (tim5_regs.DIER & TIM_DIER_UIE))
+	{
+		to_update = sim_tim5_cycles_to_update();
+	}
+	if (to_update < to_tick)
+	{
+		to_tick = to_update;
+	}
+	if ((wake_cycle != SIM_NEVER) && (wake_cycle > sim_cycles))
+	{
+		to_wake = wake_cycle - sim_cycles;
+	}
+	if (to_wake < to_tick)
+	{
+		to_tick = to_wake;
+		wake_cycle = SIM_NEVER;
+	}
+	if (to_tick != SIM_NEVER)
+	{
+		sim_run(to_tick);
+	}
+}
+
+/******************************************************************************
+* Function: systick_sim_reset()
+*//**
+* \b Description:
+*
+* 	Returns the simulator to its power-on state: virtual time at zero, SysTick
+* 	registers at their reset values, no pending exceptions and PRIMASK clear.
+* 	CALIB reports a 10 ms reload for the external (core / 8) reference.
+*
+*	PRE-CONDITION: SystemCoreClock holds the desired virtual core clock
+*
+*	POST-CONDITION: The model is in its reset state
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	SystemCoreClock = 100000000UL;
+*	systick_sim_reset();
+*	systick_init(tick_config);
+*	@endcode
+*
+*	@see	systick_sim_advance
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_reset(void)
+{
+	uint32_t i;
+
+	systick_regs.CTRL = 0UL;
+	systick_regs.LOAD = 0UL;
+	systick_regs.VAL = 0UL;
+	systick_regs.CALIB = SysTick_CALIB_SKEW_Msk
+					   | (((SystemCoreClock / 8UL / 100UL) - 1UL) & SysTick_CALIB_TENMS_Msk);
+	scb_regs.CPUID = 0x410FC241UL;
+	dwt_regs.CTRL = 0UL;
+	dwt_regs.CYCCNT = 0UL;
+	coredebug_regs.DEMCR = 0UL;
+	published_cyccnt = 0UL;
+	cyccnt_running = 0;
+	cyccnt_offset = 0UL;
+	tim5_regs.CR1 = 0UL;
+	tim5_regs.DIER = 0UL;
+	tim5_regs.SR = 0UL;
+	tim5_regs.EGR = 0UL;
+	tim5_regs.CNT = 0UL;
+	tim5_regs.PSC = 0UL;
+	tim5_regs.ARR = 0xFFFFFFFFUL;
+	rcc_regs.CFGR = 0UL;
+	rcc_regs.APB1ENR = 0UL;
+	tim5_psc = 0UL;
+	tim5_phase = 0;
+	tim5_irq_enabled = 0;
+	was_enabled = 0;
+	reload_hold = 0;
+	systick_pending = 0;
+	pendsv_pending = 0;
+	primask = 0;
+	basepri = 0;
+	active_level = SIM_LEVEL_THREAD;
+	in_model = 0;
+	sim_cycles = 0;
+	prescale_phase = 0;
+	autostep_cycles = 0;
+	wake_cycle = SIM_NEVER;
+	event_register = 0;
+	clock_error_ppb = 0;
+	for (i = 0; i < SIM_NUM_VECTORS; i++)
+	{
+		priorities[i] = 0;
+	}
+	tim5_priority = 0;
+	sim_sync_out();
+}
+
+/******************************************************************************
+* Function: systick_sim_advance()
+*//**
+* \b Description:
+*
+* 	Advances virtual time by a number of core cycles. Every tick exception
+* 	raised on the way is taken at the cycle it is raised, so the driver ISR runs
+* 	once per tick exactly as on target. Cost is proportional to the number of
+* 	ticks crossed, not to the number of cycles.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: Virtual time has moved forward by cycles
+*
+*	@param 		cycles	number of core clock cycles to simulate
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_sim_advance(SystemCoreClock);	//one second, 1000 ticks at 1 kHz
+*	@endcode
+*
+*	@see	systick_sim_warp
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_advance(uint64_t cycles)
+{
+	sim_run(cycles);
+}
+
+/******************************************************************************
+* Function: systick_sim_warp()
+*//**
+* \b Description:
+*
+* 	Advances virtual time by any number of core cycles in constant time. The
+* 	counter ends exactly where systick_sim_advance would leave it, but instead
+* 	of running the ISR once per tick, the ticks crossed are credited in one go
+* 	through systick_tick_advance. Registered callbacks do not run for the
+* 	warped ticks. TIM5 is moved on too, its update events merging into one
+* 	pending interrupt as they would with interrupts masked.
+*
+*	PRE-CONDITION: The driver has been initialised
+*
+*	POST-CONDITION: Virtual time and the driver tick have moved forward
+*
+*	@param 		cycles	number of core clock cycles to skip
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	//49.7 days at 100 MHz, brings a 1 kHz tick right up to its 32 bit wrap
+*	systick_sim_warp(4294967000ULL * 100000ULL);
+*	@endcode
+*
+*	@see	systick_sim_advance
+*	@see	systick_tick_advance
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_warp(uint64_t cycles)
+{
+	uint64_t underflows;
+
+	sim_sync_in();
+	in_model++;
+	(void)sim_tim5_step(cycles);
+	underflows = sim_counter_step(cycles);
+	in_model--;
+	sim_sync_out();
+	if ((underflows != 0) && (systick_regs.CTRL & SysTick_CTRL_TICKINT_Msk))
+	{
+		while (underflows > 0xFFFFFFFFULL)
+		{
+			systick_tick_advance(0xFFFFFFFFUL);
+			underflows -= 0xFFFFFFFFULL;
+		}
+		systick_tick_advance((uint32_t)underflows);
+	}
+}
+
+/******************************************************************************
+* Function: systick_sim_cycles()
+*//**
+* \b Description:
+*
+* 	Returns the virtual time in core cycles since the last reset
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint64_t virtual core cycles since systick_sim_reset
+*
+* \b Example:
+*
+*	@code
+*	uint64_t start = systick_sim_cycles();
+*	systick_delay(10);
+*	uint64_t spent = systick_sim_cycles() - start;
+*	@endcode
+*
+*	@see	systick_sim_advance
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint64_t systick_sim_cycles(void)
+{
+	return (sim_cycles);
+}
+
+/******************************************************************************
+* Function: systick_sim_clock_error_set()
+*//**
+* \b Description:
+*
+* 	Makes the simulated oscillator run error_ppb parts per billion faster
+* 	(positive) or slower than SystemCoreClock. Virtual cycles are unchanged,
+* 	so the driver sees nothing; only the true time of systick_sim_reference_us
+* 	moves at the other rate, as a perfect reference clock would.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The reference time counts at the injected error
+*
+*	@param 		error_ppb	oscillator error in parts per billion
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_sim_clock_error_set(-42000);		//crystal 42 ppm slow
+*	@endcode
+*
+*	@see	systick_sim_reference_us
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_clock_error_set(int32_t error_ppb)
+{
+	clock_error_ppb = error_ppb;
+}
+
+/******************************************************************************
+* Function: systick_sim_reference_us()
+*//**
+* \b Description:
+*
+* 	Returns the true time since reset, in microseconds, of virtual cycles run
+* 	by an oscillator with the error set by systick_sim_clock_error_set. Feeds
+* 	calibration code the reference a GPS or a network clock would give.
+*
+*	PRE-CONDITION: The error has not changed since reset
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint64_t true microseconds since systick_sim_reset
+*
+* \b Example:
+*
+*	@code
+*	systick_calib_reference(systick_get_time_us(), (uint32_t)systick_sim_reference_us());
+*	@endcode
+*
+*	@see	systick_sim_clock_error_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint64_t systick_sim_reference_us(void)
+{
+	uint64_t true_millihz = ((uint64_t)SystemCoreClock * (uint64_t)(1000000000LL + clock_error_ppb)) / 1000000ULL;
+	uint64_t milli_cycles = sim_cycles * 1000ULL;
+
+	return (((milli_cycles / true_millihz) * 1000000ULL)
+			+ (((milli_cycles % true_millihz) * 1000000ULL) / true_millihz));
+}
+
+/******************************************************************************
+* Function: systick_sim_autostep_set()
+*//**
+* \b Description:
+*
+* 	Makes every SysTick/SCB register access consume a fixed number of virtual
+* 	cycles. Needed for driver code which busy-waits on the counter or on the
+* 	tick (systick_delay and friends), which would otherwise never see time move.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: Register accesses advance virtual time by cycles_per_access
+*
+*	@param 		cycles_per_access	virtual cycles per access, 0 disables stepping
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_sim_autostep_set(20);
+*	systick_delay(100);		//returns after ~100 ms of virtual time
+*	@endcode
+*
+*	@see	systick_sim_advance
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_autostep_set(uint32_t cycles_per_access)
+{
+	autostep_cycles = cycles_per_access;
+}
+
+/******************************************************************************
+* Function: systick_sim_vector_set()
+*//**
+* \b Description:
+*
+* 	Installs the handler the simulator calls when an exception is taken. The
+* 	SysTick vector defaults to systick_irq_handler, the PendSV one to
+* 	systick_defer_handler (when SYSTICK_DEFER_ENABLED is set) and the TIM5 one to systick_instance_irq_handler
+* 	for SYSTICK_2.
+*
+*	PRE-CONDITION: irq is SysTick_IRQn, PendSV_IRQn or TIM5_IRQn
+*
+*	POST-CONDITION: The exception is routed to handler (NULL leaves it pending)
+*
+*	@param 		irq			the exception to route
+*	@param 		handler		the function to call
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_sim_vector_set(SysTick_IRQn, &my_tick_handler);
+*	@endcode
+*
+*	@see	systick_sim_reset
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_vector_set(IRQn_Type irq, systick_sim_handler_t handler)
+{
+	if (irq == TIM5_IRQn)
+	{
+		tim5_vector = handler;
+	}
+	else if ((irq < 0) && ((uint32_t)(-irq) < SIM_NUM_VECTORS))
+	{
+		vectors[-irq] = handler;
+	}
+}
+
+/******************************************************************************
+* Function: systick_sim_wake_at()
+*//**
+* \b Description:
+*
+* 	Schedules a wake-up from WFI/WFE at an absolute virtual cycle, standing in
+* 	for an interrupt from some other peripheral.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: A sleep in progress at cycle ends there
+*
+*	@param 		cycle	absolute virtual cycle of the wake-up
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_sim_wake_at(systick_sim_cycles() + 12345);
+*	@endcode
+*
+*	@see	systick_sim_cycles
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sim_wake_at(uint64_t cycle)
+{
+	wake_cycle = cycle;
+}
+
+/******************************************************************************
+* Function: systick_sim_priority_get()
+*//**
+* \b Description:
+*
+* 	Returns the priority last given to an exception through NVIC_SetPriority
+*
+*	PRE-CONDITION: irq is SysTick_IRQn or PendSV_IRQn
+*
+*	POST-CONDITION: None
+*
+*	@param 		irq		the exception to query
+*
+*	@return 	uint32_t the recorded priority
+*
+* \b Example:
+*
+*	@code
+*	uint32_t prio = systick_sim_priority_get(SysTick_IRQn);
+*	@endcode
+*
+*	@see	systick_sim_vector_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_sim_priority_get(IRQn_Type irq)
+{
+	uint32_t priority = 0;
+
+	if ((irq < 0) && ((uint32_t)(-irq) < SIM_NUM_VECTORS))
+	{
+		priority = priorities[-irq];
+	}
+	return (priority);
+}
+
+/**
+ * SysTick register access hook used by the simulated core_cm4.h
+ */
+SysTick_Type *systick_sim_systick(void)
+{
+	sim_access();
+	return (&systick_regs);
+}
+
+/**
+ * SCB register access hook used by the simulated core_cm4.h
+ */
+SCB_Type *systick_sim_scb(void)
+{
+	sim_access();
+	return (&scb_regs);
+}
+
+/**
+ * DWT register access hook used by the simulated core_cm4.h
+ */
+DWT_Type *systick_sim_dwt(void)
+{
+	sim_access();
+	sim_dwt_sync();
+	return (&dwt_regs);
+}
+
+/**
+ * CoreDebug register access hook used by the simulated core_cm4.h
+ */
+CoreDebug_Type *systick_sim_coredebug(void)
+{
+	sim_access();
+	sim_dwt_sync();
+	return (&coredebug_regs);
+}
+
+/**
+ * TIM5 register access hook used by the simulated stm32f411xe.h
+ */
+TIM_TypeDef *systick_sim_tim5(void)
+{
+	sim_access();
+	return (&tim5_regs);
+}
+
+/**
+ * RCC register access hook used by the simulated stm32f411xe.h
+ */
+RCC_TypeDef *systick_sim_rcc(void)
+{
+	sim_access();
+	return (&rcc_regs);
+}
+
+/**
+ * NVIC_EnableIRQ/NVIC_DisableIRQ hook, only TIM5 is a peripheral interrupt
+ */
+void systick_sim_nvic_enable(int32_t irq, uint32_t enable)
+{
+	if (irq == (int32_t)TIM5_IRQn)
+	{
+		tim5_irq_enabled = (enable != 0);
+		if ((enable != 0) && (in_model == 0))
+		{
+			sim_sync_in();
+			sim_dispatch();
+		}
+	}
+}
+
+/**
+ * NVIC_SetPriority hook used by the simulated core_cm4.h
+ */
+void systick_sim_nvic_priority_set(int32_t irq, uint32_t priority)
+{
+	if ((irq < 0) && ((uint32_t)(-irq) < SIM_NUM_VECTORS))
+	{
+		priorities[-irq] = priority;
+	}
+	else if (irq == (int32_t)TIM5_IRQn)
+	{
+		tim5_priority = priority;
+	}
+}
+
+/**
+ * PRIMASK write hook. Clearing PRIMASK takes any exception left pending.
+ */
+void systick_sim_primask_set(uint32_t value)
+{
+	primask = value & 1UL;
+	if ((primask == 0) && (in_model == 0))
+	{
+		sim_sync_in();
+		sim_dispatch();
+	}
+}
+
+/**
+ * PRIMASK read hook
+ */
+uint32_t systick_sim_primask_get(void)
+{
+	return (primask);
+}
+
+/**
+ * BASEPRI write hook. With raise_only set (BASEPRI_MAX) the write only takes
+ * effect if it masks more; lowering the mask takes any exception it released.
+ */
+void systick_sim_basepri_set(uint32_t value, uint32_t raise_only)
+{
+	value &= 0xFFUL;
+	if ((raise_only != 0) && ((value == 0) || ((basepri != 0) && (value >= basepri))))
+	{
+		return;
+	}
+	basepri = value;
+	if (in_model == 0)
+	{
+		sim_sync_in();
+		sim_dispatch();
+	}
+}
+
+/**
+ * BASEPRI read hook
+ */
+uint32_t systick_sim_basepri_get(void)
+{
+	return (basepri);
+}
+
+/**
+ * WFI hook, sleeps until an exception is pending or a wake-up is due
+ */
+void systick_sim_wfi(void)
+{
+	sim_sleep();
+}
+
+/**
+ * WFE hook, returns at once if the event latch is set, otherwise sleeps like WFI
+ */
+void systick_sim_wfe(void)
+{
+	if (event_register != 0)
+	{
+		event_register = 0;
+		return;
+	}
+	sim_sleep();
+}
+
+/**
+ * SEV hook, sets the event latch
+ */
+void systick_sim_sev(void)
+{
+	event_register = 1;
+}
+
+/**
+ * NOP hook, a synchronisation point like any register access
+ */
+void systick_sim_nop(void)
+{
+	sim_access();
+}
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* Title                 :   Systick Simulator
+* Filename              :   systick_sim.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Linux (systick simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file sim/systick_sim.h
+ *  @brief Deterministic virtual-time model of the Cortex-M4 SysTick. Building
+ *  		systick.c and systick_stm32f411.c with the sim directory first on
+ *  		the include path links the unmodified backend against this model.
+ *
+ *  Time only moves when the host calls systick_sim_advance/systick_sim_warp,
+ *  when the driver sleeps (WFI/WFE), or, if enabled, by a fixed number of
+ *  cycles on every register access.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_SIM_H
+#define _SYSTICK_SIM_H
+
+#include "stm32f411xe.h"
+
+/**
+ * Simulated exception handler
+ */
+typedef void (*systick_sim_handler_t) (void);
+
+void systick_sim_reset(void);
+void systick_sim_advance(uint64_t cycles);
+void systick_sim_warp(uint64_t cycles);
+uint64_t systick_sim_cycles(void);
+void systick_sim_clock_error_set(int32_t error_ppb);
+uint64_t systick_sim_reference_us(void);
+void systick_sim_autostep_set(uint32_t cycles_per_access);
+void systick_sim_vector_set(IRQn_Type irq, systick_sim_handler_t handler);
+void systick_sim_wake_at(uint64_t cycle);
+uint32_t systick_sim_priority_get(IRQn_Type irq);
+
+#endif
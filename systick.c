@@ -0,0 +1,1362 @@
+/*******************************************************************************
+* Title                 :   Systick Implementation
+* Filename              :   systick.c
+* Author                :   Marko Galevski
+* Origin Date           :   11/02/2020
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick.c
+ *  @brief Portable implementation of the systick interface. Tick accounting,
+ *  delays and callback dispatch live here, while every access to the timer
+ *  hardware goes through the backend declared in systick_port.h.
+ *
+ *  Time is accounted in nanoseconds per tick with a Bresenham error term, so
+ *  the millisecond tick stays exact for any tick rate, including rates which
+ *  do not divide the counter clock or are not a whole number of kHz: the
+ *  truncated part of each tick period is carried into the next instead of
+ *  being lost.
+ *
+ *  @note Link exactly one backend (e.g. systick_stm32f411.c or systick_linux.c)
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <assert.h>
+#include <stdatomic.h>
+#include "systick_interface.h"
+#include "systick_port.h"
+#include "systick_ms.h"
+#include "systick_dispatch.h"
+#if SYSTICK_TIMERS_ENABLED
+#include "systick_timer.h"
+#endif
+#if SYSTICK_DEFER_ENABLED
+#include "systick_defer.h"
+#endif
+#if SYSTICK_ISR_STATS_ENABLED
+#include "systick_isr_stats.h"
+#endif
+#if SYSTICK_LOAD_ENABLED
+#include "systick_load.h"
+#endif
+
+/**
+ * Definition of NULL in case it is not defined elsewhere
+ */
+#ifndef NULL
+#define NULL (void *) 0
+#endif
+
+volatile uint32_t systick_tick_ms = 0;		/**<Tick value, exported read-only for the inline readers */
+static volatile uint32_t tick_ms_hi = 0;	/**<Upper 32 bits of the 64 bit tick, see systick_get_tick64 */
+static volatile uint32_t tick_count = 0;	/**<Number of tick periods elapsed */
+static uint32_t cycles_base = 0;			/**<Keeps systick_get_cycles continuous across systick_reconfigure */
+static uint32_t tick_reload;				/**<Counter clocks per tick minus one */
+static uint32_t counter_hz;					/**<Counter clock after the trim, the denominator of tick_ns_frac */
+static uint32_t counter_hz_nominal;			/**<Counter clock as the port reports it */
+static int32_t counter_trim_ppb = 0;		/**<Counter clock error set by systick_trim_set */
+static uint32_t tick_ns;					/**<Whole nanoseconds per tick */
+static uint32_t tick_ns_frac;				/**<Remaining nanoseconds per tick, in 1/counter_hz ns */
+uint32_t systick_slack_ms;					/**<Milliseconds tick timeouts add for the phase of their start */
+static volatile uint32_t tick_ns_err = 0;	/**<Accumulated tick_ns_frac, below counter_hz */
+static volatile uint32_t tick_sub_ns = 0;	/**<Nanoseconds past systick_tick_ms, below one ms */
+
+/**
+ * Callback installed through systick_callback_register. It is an ordinary
+ * every-tick subscriber of the dispatch table; tick accounting no longer
+ * depends on it.
+ */
+static systick_callback_t systick_callback = NULL;
+
+/**
+ * Takes a consistent snapshot of the tick accounting and of the counter.
+ * The tick values are re-read until no tick interrupt slipped in between, and
+ * a tick which is pending but not yet serviced (e.g. the caller runs with
+ * interrupts masked) is accounted here, the counter being re-read after the
+ * pending check so it is guaranteed to be past the reload. On a backend whose
+ * tick runs on another core, systick_port_read_begin holds it off meanwhile.
+ */
+static void systick_snapshot(uint32_t *ms, uint32_t *sub_ns, uint32_t *count, uint32_t *elapsed)
+{
+	uint32_t snap_ms;
+	uint32_t snap_sub_ns;
+	uint32_t snap_err;
+	uint32_t snap_count;
+	uint32_t val;
+	uint32_t pending;
+	uint32_t state = systick_port_read_begin();
+
+	do
+	{
+		snap_count = tick_count;
+		snap_ms = systick_tick_ms;
+		snap_sub_ns = tick_sub_ns;
+		snap_err = tick_ns_err;
+		val = systick_port_counter_get();
+		pending = systick_port_tick_pending();
+		if (pending != 0)
+		{
+			val = systick_port_counter_get();
+		}
+	} while (snap_count != tick_count);
+	systick_port_read_end(state);
+
+	if (pending != 0)
+	{
+		snap_ms += systick_ms_step(&snap_sub_ns, &snap_err, tick_ns, tick_ns_frac, counter_hz);
+		snap_count++;
+	}
+	*ms = snap_ms;
+	*sub_ns = snap_sub_ns;
+	*count = snap_count;
+	*elapsed = systick_port_clocks_since_edge(tick_reload, val);
+}
+
+#if SYSTICK_ISR_STATS_ENABLED
+/**
+ * Records the latency of the tick interrupt, from the counter value read at
+ * handler entry, and the handler's run time up to now
+ */
+static void systick_isr_sample(uint32_t entry_val)
+{
+	uint32_t exit_val = systick_port_counter_get();
+	uint32_t latency = systick_port_clocks_since_edge(tick_reload, entry_val);
+	uint32_t exec = (entry_val >= exit_val) ? (entry_val - exit_val)
+											: ((entry_val + tick_reload + 1UL) - exit_val);
+
+	systick_isr_stats_record(latency, exec);
+}
+#endif
+
+/**
+ * Rounds a duration given in units of 1/scale seconds up to counter clocks
+ */
+static uint64_t systick_clocks_from(uint32_t duration, uint32_t scale)
+{
+	return ((((uint64_t)duration * counter_hz) + scale - 1UL) / scale);
+}
+
+/**
+ * Busy-waits for a number of counter clocks by accumulating the decrements of
+ * the counter itself, so it keeps time with interrupts masked and across any
+ * number of reloads. Returns by how many clocks the wait overshot. A reload
+ * the loop does not observe (preempted for longer than a tick) goes uncounted,
+ * which can only lengthen the wait.
+ */
+static uint32_t systick_spin_clocks(uint64_t clocks)
+{
+	uint32_t period = tick_reload + 1UL;
+	uint32_t prev = systick_port_counter_get();
+	uint32_t now;
+	uint64_t elapsed = 0;
+
+	while (elapsed < clocks)
+	{
+		systick_port_spin();
+		now = systick_port_counter_get();
+		elapsed += (prev >= now) ? (prev - now) : ((prev + period) - now);
+		prev = now;
+	}
+	return ((uint32_t)(elapsed - clocks));
+}
+
+/**
+ * Reload value giving the tick rate requested by config, rounded to the
+ * nearest counter clock. The rounding error only changes how often the
+ * interrupt fires: the time credited per tick is exact.
+ */
+static uint32_t systick_reload_compute(const systick_config_t *config)
+{
+	uint32_t clock_hz = systick_port_counter_hz(config->clock_source);
+	uint32_t period;
+
+	assert((config->tick_freq_hz != 0UL) && (config->tick_freq_hz <= clock_hz / 2UL));
+	period = (clock_hz + (config->tick_freq_hz / 2UL)) / config->tick_freq_hz;
+	assert(period - 1UL <= SYSTICK_PORT_RELOAD_MAX);
+	return (period - 1UL);
+}
+
+/**
+ * Counter clock corrected by the trim, to the nearest Hz
+ */
+static uint32_t systick_hz_trimmed(uint32_t clock_hz)
+{
+	int64_t error = (int64_t)clock_hz * counter_trim_ppb;
+
+	error += (error < 0) ? -500000000LL : 500000000LL;
+	return ((uint32_t)((int64_t)clock_hz + (error / 1000000000LL)));
+}
+
+/**
+ * Derives the per-tick time increments from a new tick period. The
+ * sub-millisecond time already accounted is kept; the error term is
+ * restarted, which loses less than a nanosecond. clock_hz is the nominal
+ * counter clock, the trim is applied here. The caller programs the counter.
+ */
+static void systick_period_set(uint32_t reload, uint32_t clock_hz)
+{
+	uint64_t period_ns = (uint64_t)(reload + 1UL) * 1000000000ULL;
+
+	tick_reload = reload;
+	counter_hz_nominal = clock_hz;
+	counter_hz = systick_hz_trimmed(clock_hz);
+	assert(period_ns / counter_hz <= 1000000000ULL);
+	tick_ns = (uint32_t)(period_ns / counter_hz);
+	tick_ns_frac = (uint32_t)(period_ns % counter_hz);
+	tick_ns_err = 0;
+	systick_slack_ms = (tick_ns + 999999UL) / 1000000UL;
+	if ((((tick_ns % 1000000UL) != 0) || (tick_ns_frac != 0))
+		&& (((uint64_t)counter_hz % ((uint64_t)(reload + 1UL) * 1000ULL)) != 0))
+	{
+		/* neither a whole number of ms nor of ticks per ms: the ms count may
+		 * then lag true time by up to a tick plus a ms */
+		systick_slack_ms++;
+	}
+}
+
+/**
+ * Adds whole milliseconds to the 64 bit tick, low word first
+ */
+static void systick_tick_add(uint64_t ms)
+{
+	uint64_t new_tick = ((((uint64_t)tick_ms_hi) << 32) | systick_tick_ms) + ms;
+
+	systick_tick_ms = (uint32_t)new_tick;
+	atomic_thread_fence(memory_order_release);		/* low word must be visible first */
+	tick_ms_hi = (uint32_t)(new_tick >> 32);
+}
+
+/******************************************************************************
+* Function: systick_init()
+*//**
+* \b Description:
+*
+* 	Carries out the initialisation of the the systick based on information in the
+* 	config table
+*
+*	PRE-CONDITION: The clock system (RCC) has been initialised.
+*	PRE-CONDITION: The desired frequency (tick_freq_hz) is between 1 Hz and
+*					half the counter clock, and its period fits the 0xFFFFFF mask
+*	PRE-CONDITION: (Soft Assert) the systick is enabled through its config register
+*
+*	POST-CONDITION: The systick has been configured to count with the desired frequency
+*	POST-CONDITION: The systick interrupt has been enabled (if desired) and its priority
+*						set to maximum.
+*	POST-CONDITION: The systick clock source has been set to the desired option
+*
+*	@param 		config	a pointer to the systick configuration structure
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_config_t *tick_config = systick_config_get();
+*	systick_init(tick_config);
+*	@endcode
+*
+*	@see	systick_config_get
+*	@see	systick_init_reload
+*	@see	systick_tick_freq_set
+*	@see	systick_pause
+*	@see	systick_resume
+*	@see	systick_interrupt_control
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_init(systick_config_t *config)
+{
+	if (config->enable_systick == SYSTICK_ENABLED)
+	{
+		systick_init_reload(systick_reload_compute(config),
+							systick_port_counter_hz(config->clock_source),
+							config->clock_source, config->enable_systick_interrupt);
+	}
+}
+
+/******************************************************************************
+* Function: systick_init_reload()
+*//**
+* \b Description:
+*
+* 	Initialises the systick from a precomputed reload value, skipping the
+* 	runtime division and checks of systick_init. Meant for configurations
+* 	fixed at build time, where the reload is computed and range checked by the
+* 	compiler (see systick.hpp); systick_init is a thin wrapper around it.
+*
+*	PRE-CONDITION: The clock system (RCC) has been initialised
+*	PRE-CONDITION: reload is at most SYSTICK_PORT_RELOAD_MAX and makes a tick
+*					last at most a second
+*
+*	POST-CONDITION: The systick is counting with the given period
+*	POST-CONDITION: The systick interrupt has been enabled (if desired) and its
+*					priority set to maximum
+*
+*	@param 		reload				counter clocks per tick minus one
+*	@param 		clock_hz			counter clock in Hz (see systick_port_counter_hz)
+*	@param 		clock_source		counter clock source
+*	@param 		interrupt_control	whether the tick interrupt is enabled
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	//100 MHz core clock, 1 kHz tick
+*	systick_init_reload(99999UL, 100000000UL, SYSTICK_INTERNAL_CLOCK, SYSTICK_INT_ENABLED);
+*	@endcode
+*
+*	@see	systick_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_init_reload(uint32_t reload, uint32_t clock_hz, systick_clock_source_t clock_source,
+						 systick_interrupt_t interrupt_control)
+{
+	systick_pause();
+#if SYSTICK_TIMERS_ENABLED
+	systick_timer_init();
+#endif
+#if SYSTICK_DEFER_ENABLED
+	systick_defer_init();
+#endif
+	systick_period_set(reload, clock_hz);
+	systick_port_reload_set(tick_reload);					/* set reload register */
+	systick_port_init(clock_source);						/* max priority and clock source */
+	systick_interrupt_control(interrupt_control);
+	systick_resume();
+}
+
+/******************************************************************************
+* Function: systick_tick_freq_set()
+*//**
+* \b Description:
+*
+* 	Sets the frequency of the systick update to the desired value in Hz. Any
+* 	rate is kept drift free: the reload is rounded to the nearest counter
+* 	clock and the time credited per tick is the exact period it gives.
+* 	The counter must be paused; use systick_reconfigure to change the period
+* 	of a running systick.
+*
+*	PRE-CONDITION: The desired frequency (tick_freq_hz) is between 1 Hz and
+*					half the counter clock, and its period fits the 0xFFFFFF mask
+*	PRE-CONDITION: (Soft Assert) the systick is enabled through its config register
+*	PRE-CONDITION: (Soft Assert) the systick is paused
+*
+*
+*	POST-CONDITION: The systick has been configured to count with the desired frequency
+*
+*	@param 		config	a pointer to the systick configuration structure
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_config_t *tick_config = systick_config_get();
+*	systick_init(tick_config);
+*	//... later ...
+*	systick_pause();
+*	tick_config->tick_freq_hz = 1500; //Hz
+*	systick_tick_freq_set(tick_config);
+*	systick_resume();
+*	@endcode
+*
+*	@see	systick_init
+*	@see	systick_config_get
+*	@see	systick_pause
+*	@see	systick_resume
+*	@see	systick_reconfigure
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_tick_freq_set(systick_config_t *config)
+{
+	if (config->enable_systick == SYSTICK_ENABLED)
+	{
+		if (systick_port_is_running() == 0)
+		{
+			systick_period_set(systick_reload_compute(config),
+							   systick_port_counter_hz(config->clock_source));
+			systick_port_reload_set(tick_reload);
+		}
+
+	}
+}
+/******************************************************************************
+* Function: systick_reconfigure()
+*//**
+* \b Description:
+*
+* 	Switches the running systick to a new counter clock or tick rate without
+* 	stopping it, e.g. right after SystemCoreClock has been scaled. The part of
+* 	the current tick already elapsed is credited at the old rate, the counter
+* 	restarts a full tick of the new period from there, and the functions
+* 	subscribed through systick_clock_change_subscribe are then called. The
+* 	millisecond tick, systick_get_time_us and systick_get_cycles stay
+* 	continuous; only the phase of the tick interrupt moves.
+*
+*	PRE-CONDITION: The systick has been initialised and is running
+*	PRE-CONDITION: SystemCoreClock holds the new core clock, and the clock was
+*					switched just before the call: counter clocks between the
+*					switch and the call are credited at the old rate
+*	PRE-CONDITION: The desired frequency (tick_freq_hz) is between 1 Hz and
+*					half the counter clock, and its period fits the 0xFFFFFF mask
+*
+*	POST-CONDITION: The systick counts with the new period
+*	POST-CONDITION: The clock change subscribers have been called
+*
+*	@param 		config	a pointer to the systick configuration structure
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	rcc_sysclk_set(RCC_SYSCLK_16MHZ);		//power save
+*	SystemCoreClockUpdate();
+*	systick_reconfigure(tick_config);		//same tick rate, new reload
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+*	@see	systick_clock_change_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_reconfigure(systick_config_t *config)
+{
+	systick_clock_change_t change;
+	uint32_t state;
+	uint32_t val;
+	uint32_t elapsed;
+	uint32_t ns;
+
+	if (config->enable_systick != SYSTICK_ENABLED)
+	{
+		return;
+	}
+	change.old_counter_hz = counter_hz_nominal;
+	change.old_reload = tick_reload;
+	change.new_counter_hz = systick_port_counter_hz(config->clock_source);
+	change.new_reload = systick_reload_compute(config);
+
+	state = systick_port_irq_save();
+	if (systick_port_tick_pending() != 0)
+	{
+		/* a tick ended under the mask, service it with the old period */
+		systick_port_tick_pending_clear();
+		systick_irq_handler();
+	}
+	val = systick_port_counter_get();
+	systick_port_reload_set(change.new_reload);			/* new period starts here */
+	elapsed = systick_port_clocks_since_edge(tick_reload, val);
+	if (systick_port_tick_pending() != 0)
+	{
+		/* the tick ended between the read and the restart */
+		systick_port_tick_pending_clear();
+		systick_irq_handler();
+		elapsed = 0;
+	}
+
+	ns = tick_sub_ns + (uint32_t)(((uint64_t)elapsed * 1000000000ULL) / counter_hz);
+	tick_sub_ns = ns % 1000000UL;
+	systick_tick_add(ns / 1000000UL);
+	cycles_base += (tick_count * (tick_reload + 1UL)) + elapsed
+				 - (tick_count * (change.new_reload + 1UL));
+	systick_period_set(change.new_reload, change.new_counter_hz);
+	systick_port_irq_restore(state);
+
+	systick_dispatch_clock_change(&change);
+}
+
+/******************************************************************************
+* Function: systick_pause()
+*//**
+* \b Description:
+*
+* 	Pauses the counting of the systick.
+*
+*	PRE-CONDITION: None
+*
+*
+*	POST-CONDITION: The systick timer is paused
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_pause();
+*	//... do things....
+*	systick_resume();
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+*	@see	systick_resume
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_pause(void)
+{
+	systick_port_pause();
+}
+
+/******************************************************************************
+* Function: systick_resume()
+*//**
+* \b Description:
+*
+* 	Resume the counting of the systick.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The systick timer is running
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_pause();
+*	//... do things....
+*	systick_resume();
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+*	@see	systick_pause
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_resume(void)
+{
+	systick_port_resume();
+}
+
+/******************************************************************************
+* Function: systick_interrupt_control()
+*//**
+* \b Description:
+*
+* 	Enables or disables the systick interrupt
+*
+*	PRE-CONDITION: (Soft Assert) The systick is paused
+*
+*
+*	POST-CONDITION: The systick interrupt is enabled or disabled, as per the input
+*
+*	@param		interrupt_control Control parameter defining if the interrupt will be
+*				activated or deactivated
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_pause();
+*	systick_interrupt_control(SYSTICK_INT_ENABLED);
+*	systick_resume();
+*	@endcode
+*
+*	@see	systick_init
+*	@see	systick_tick_freq_set
+*	@see	systick_pause
+*	@see	systick_resume
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_interrupt_control(systick_interrupt_t interrupt_control)
+{
+	if(systick_port_is_running() == 0)
+	{
+		systick_port_interrupt_set(interrupt_control);
+	}
+
+}
+
+
+/******************************************************************************
+* Function: systick_get_tick()
+*//**
+* \b Description:
+*
+* 	DReturns the current value of the systick_tick_ms variable
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The function has returned the current value of the tick variable.
+**
+*	@return 	uint32_t the current tick value
+*
+* \b Example:
+*
+*	@code
+*	uint32_t current_tick = systick_get_tick();
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+*	@see	systick_delay
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_get_tick(void)
+{
+	return(systick_tick_ms);
+}
+
+/******************************************************************************
+* Function: systick_get_tick64()
+*//**
+* \b Description:
+*
+* 	Returns the tick as a 64 bit value which never wraps in practice. The ISR
+* 	writes the low word before carrying into the high word, so the reader only
+* 	has to re-read the high word and retry if it changed: no interrupt masking,
+* 	and in the common case just three loads and a compare.
+*
+* 	Lock-free on target only, where the ISR completes before the reader
+* 	resumes. The Linux backend's tick thread may run on another core, so
+* 	there systick_port_read_begin holds it off for the read.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None. Safe from thread mode and from ISRs of lower priority
+*					than the systick.
+*
+*	@return 	uint64_t the current 64 bit tick value
+*
+* \b Example:
+*
+*	@code
+*	uint64_t uptime_ms = systick_get_tick64();
+*	@endcode
+*
+*	@see	systick_get_tick
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint64_t systick_get_tick64(void)
+{
+	uint32_t state = systick_port_read_begin();
+	uint64_t tick = systick_ms_read64(&systick_tick_ms, &tick_ms_hi);
+
+	systick_port_read_end(state);
+	return (tick);
+}
+
+/******************************************************************************
+* Function: systick_get_cycles()
+*//**
+* \b Description:
+*
+* 	Returns a counter clock timestamp combining the number of elapsed ticks with
+* 	the live value of the down-counter, giving single counter clock resolution
+* 	without a dedicated timer. The value wraps modulo 2^32, so differences
+* 	between two timestamps are valid as long as they are less than 2^32 clocks
+* 	apart (~42 s at 100 MHz).
+*
+*	PRE-CONDITION: The systick has been initialised with its interrupt enabled
+*
+*	POST-CONDITION: None. Monotonic even when called with interrupts masked,
+*					as long as less than one tick period is left unserviced.
+*
+*	@return 	uint32_t counter clocks elapsed since the systick was started
+*
+* \b Example:
+*
+*	@code
+*	uint32_t start = systick_get_cycles();
+*	do_work();
+*	uint32_t spent = systick_get_cycles() - start;
+*	@endcode
+*
+*	@see	systick_get_time_us
+*	@see	systick_get_tick
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_get_cycles(void)
+{
+	uint32_t ms;
+	uint32_t sub_ns;
+	uint32_t count;
+	uint32_t elapsed;
+
+	systick_snapshot(&ms, &sub_ns, &count, &elapsed);
+	return (cycles_base + (count * (tick_reload + 1UL)) + elapsed);
+}
+
+/******************************************************************************
+* Function: systick_get_time_us()
+*//**
+* \b Description:
+*
+* 	Returns the tick time in microseconds, interpolated within the current tick
+* 	period from the live value of the down-counter. The value wraps modulo 2^32
+* 	(~71 minutes) consistently with systick_get_tick.
+*
+*	PRE-CONDITION: The systick has been initialised with its interrupt enabled
+*
+*	POST-CONDITION: None. Monotonic even when called with interrupts masked,
+*					as long as less than one tick period is left unserviced.
+*
+*	@return 	uint32_t the current time in microseconds
+*
+* \b Example:
+*
+*	@code
+*	uint32_t start = systick_get_time_us();
+*	do_work();
+*	uint32_t latency_us = systick_get_time_us() - start;
+*	@endcode
+*
+*	@see	systick_get_cycles
+*	@see	systick_get_tick
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_get_time_us(void)
+{
+	uint32_t ms;
+	uint32_t sub_ns;
+	uint32_t count;
+	uint32_t elapsed;
+	uint64_t sub_tick_ns;
+
+	systick_snapshot(&ms, &sub_ns, &count, &elapsed);
+	sub_tick_ns = (((uint64_t)elapsed * 1000000000ULL) / counter_hz) + sub_ns;
+	return ((ms * 1000UL) + (uint32_t)(sub_tick_ns / 1000ULL));
+}
+
+/******************************************************************************
+* Function: systick_delay()
+*//**
+* \b Description:
+*
+* 	Delays the program for the duration of delay_ms in milliseconds. The
+* 	millisecond count lags true time by up to a tick period (plus a
+* 	millisecond when the period is not a whole number of them), so that much
+* 	is added to the wait; the delay is never short, whatever the tick rate
+* 	and the phase of the call within the tick.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: At least delay_ms have gone by and the rest of the program will resume
+*
+*	@param		delay_ms is the length of time the user wishes to way
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_delay(200);
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+*	@see	systick_get_tick
+*	@see	systick_delay_us
+*	@see	systick_delay_sleep
+
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_delay(uint32_t delay_ms)
+{
+	uint32_t start = systick_get_tick();
+	uint32_t current_tick = systick_get_tick();
+	if (delay_ms < 0xFFFFFFFFUL)
+	{
+		delay_ms += systick_slack_ms;
+	}
+	while (current_tick - start < delay_ms)
+	{
+		systick_port_spin();
+		current_tick = systick_get_tick();
+	}
+}
+
+/******************************************************************************
+* Function: systick_delay_cycles()
+*//**
+* \b Description:
+*
+* 	Busy-waits for a number of counter clocks, polling the counter directly
+* 	for sub-tick accuracy. Unlike systick_delay it does not depend on the tick
+* 	interrupt, so it may be used with interrupts masked and from ISRs.
+*
+*	PRE-CONDITION: The systick is running
+*	PRE-CONDITION: The caller is not held off the CPU for a whole tick period
+*
+*	POST-CONDITION: At least cycles counter clocks have gone by
+*
+*	@param		cycles	number of counter clocks to wait (core clocks with
+*						SYSTICK_INTERNAL_CLOCK)
+*
+*	@return 	uint32_t measured overshoot in counter clocks
+*
+* \b Example:
+*
+*	@code
+*	GPIO_SET(SCK);
+*	(void)systick_delay_cycles(40);
+*	GPIO_CLEAR(SCK);
+*	@endcode
+*
+*	@see	systick_delay_us
+*	@see	systick_get_cycles
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_delay_cycles(uint32_t cycles)
+{
+	return (systick_spin_clocks(cycles));
+}
+
+/******************************************************************************
+* Function: systick_delay_us()
+*//**
+* \b Description:
+*
+* 	Busy-waits for a number of microseconds, polling the counter directly
+* 	for sub-tick accuracy. The wait is rounded up to a whole counter clock.
+*
+*	PRE-CONDITION: The systick is running
+*	PRE-CONDITION: The caller is not held off the CPU for a whole tick period
+*
+*	POST-CONDITION: At least delay_us microseconds have gone by
+*
+*	@param		delay_us	number of microseconds to wait
+*
+*	@return 	uint32_t measured overshoot in counter clocks
+*
+* \b Example:
+*
+*	@code
+*	lcd_write_cmd(LCD_CLEAR);
+*	(void)systick_delay_us(1520);
+*	@endcode
+*
+*	@see	systick_delay_cycles
+*	@see	systick_delay_sleep
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_delay_us(uint32_t delay_us)
+{
+	return (systick_spin_clocks(systick_clocks_from(delay_us, 1000000UL)));
+}
+
+/******************************************************************************
+* Function: systick_delay_sleep()
+*//**
+* \b Description:
+*
+* 	Waits for delay_ms milliseconds, sleeping (WFI) between tick interrupts
+* 	while more than a tick is left and busy-waiting on the counter for the
+* 	last partial tick. Meant for long waits where systick_delay would burn the
+* 	whole time in a poll loop.
+*
+*	PRE-CONDITION: Called from thread mode with the systick interrupt enabled
+*
+*	POST-CONDITION: At least delay_ms milliseconds have gone by
+*
+*	@param		delay_ms	number of milliseconds to wait
+*
+*	@return 	uint32_t measured overshoot in counter clocks
+*
+* \b Example:
+*
+*	@code
+*	uint32_t overshoot = systick_delay_sleep(500);
+*	@endcode
+*
+*	@see	systick_delay
+*	@see	systick_delay_us
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_delay_sleep(uint32_t delay_ms)
+{
+	uint32_t period = tick_reload + 1UL;
+	uint64_t clocks = systick_clocks_from(delay_ms, 1000UL);
+	uint64_t elapsed = 0;
+	uint32_t prev = systick_get_cycles();
+	uint32_t now;
+
+	while ((elapsed < clocks) && ((clocks - elapsed) > period))
+	{
+#if SYSTICK_LOAD_ENABLED
+		systick_load_idle_enter();
+		systick_port_sleep();
+		systick_load_idle_exit();
+#else
+		systick_port_sleep();
+#endif
+		now = systick_get_cycles();
+		elapsed += (uint32_t)(now - prev);		/* woken at least once per tick, cannot wrap */
+		prev = now;
+	}
+	if (elapsed >= clocks)
+	{
+		return ((uint32_t)(elapsed - clocks));
+	}
+	return (systick_spin_clocks(clocks - elapsed));
+}
+
+/******************************************************************************
+* Function: systick_increment()
+*//**
+* \b Description:
+*
+* 	Credits one tick period: its exact length in nanoseconds is added to the
+* 	sub-millisecond accumulator and the whole milliseconds carried into the
+* 	tick. Called within systick_irq_handler.
+*
+*	PRE-CONDITION: None.
+*
+*	POST-CONDITION: systick_tick_ms has incremented by the milliseconds completed during
+*					the tick period, carrying into the upper word of the 64 bit tick on
+*					wraparound
+*
+*	@return		void
+*
+* \b Example:
+* @code
+*
+*	//Called automatically upon SysTick interrupt
+* 	SysTick_IRQHandler(void)
+* 	{
+* 		systick_irq_handler();
+* 	}
+* @endcode
+*
+* @see systick_callback_register
+* @see systick_irq_handler
+*
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_increment(void)
+{
+	uint32_t sub_ns = tick_sub_ns;
+	uint32_t err = tick_ns_err;
+	uint32_t carry = systick_ms_step(&sub_ns, &err, tick_ns, tick_ns_frac, counter_hz);
+
+	tick_sub_ns = sub_ns;
+	tick_ns_err = err;
+	systick_ms_add(&systick_tick_ms, &tick_ms_hi, carry);
+	tick_count++;
+}
+
+/******************************************************************************
+* Function: systick_tick_advance()
+*//**
+* \b Description:
+*
+* 	Credits several tick periods at once, as if systick_increment had run
+* 	num_ticks times. Meant for code which let the counter run without taking
+* 	the tick interrupt (tickless idle, the host simulator's time warp).
+*
+*	PRE-CONDITION: The ticks being credited have really elapsed and have not
+*					been accounted by systick_increment
+*
+*	POST-CONDITION: systick_tick_ms has incremented by the milliseconds completed during
+*					num_ticks tick periods
+*
+*	@param		num_ticks	number of tick periods to credit
+*
+*	@return		void
+*
+* \b Example:
+* @code
+*	systick_tick_advance(slept_ticks);
+* @endcode
+*
+* @see systick_increment
+*
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_tick_advance(uint32_t num_ticks)
+{
+	uint64_t frac = ((uint64_t)num_ticks * tick_ns_frac) + tick_ns_err;
+	uint64_t ns = ((uint64_t)num_ticks * tick_ns) + tick_sub_ns + (frac / counter_hz);
+
+	tick_ns_err = (uint32_t)(frac % counter_hz);
+	tick_sub_ns = (uint32_t)(ns % 1000000ULL);
+	systick_tick_add(ns / 1000000ULL);
+	tick_count += num_ticks;
+}
+
+/******************************************************************************
+* Function: systick_tick_reload_get()
+*//**
+* \b Description:
+*
+* 	Returns the reload value programmed by systick_tick_freq_set, i.e. the
+* 	number of counter clocks per tick minus one. Code which reprograms the
+* 	counter temporarily (tickless idle) uses it to restore the tick period.
+*
+*	PRE-CONDITION: systick_tick_freq_set has been called (through systick_init)
+*
+*	POST-CONDITION: None
+*
+*	@return		uint32_t counter clocks per tick minus one
+*
+* \b Example:
+* @code
+*	uint32_t clocks_per_tick = systick_tick_reload_get() + 1UL;
+* @endcode
+*
+* @see systick_tick_freq_set
+*
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_tick_reload_get(void)
+{
+	return (tick_reload);
+}
+
+/******************************************************************************
+* Function: systick_counter_hz_get()
+*//**
+* \b Description:
+*
+* 	Returns the frequency of the counter clock, i.e. the unit of
+* 	systick_get_cycles and of the reload value. Includes the correction set
+* 	with systick_trim_set.
+*
+*	PRE-CONDITION: The systick has been initialised
+*
+*	POST-CONDITION: None
+*
+*	@return		uint32_t counter clocks per second
+*
+* \b Example:
+* @code
+*	uint32_t spent_us = (uint32_t)(((uint64_t)spent * 1000000ULL) / systick_counter_hz_get());
+* @endcode
+*
+* @see systick_get_cycles
+*
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_counter_hz_get(void)
+{
+	return (counter_hz);
+}
+
+/******************************************************************************
+* Function: systick_trim_set()
+*//**
+* \b Description:
+*
+* 	Corrects the tick accounting for a counter clock that runs error_ppb parts
+* 	per billion faster (positive) or slower (negative) than SystemCoreClock
+* 	says. The time credited per tick, the sub-tick time and the microsecond
+* 	delays all use the corrected clock, to the nearest Hz. The tick interrupt
+* 	keeps its rate; only the time it stands for changes. The trim is kept
+* 	across systick_init and systick_reconfigure.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: Time is counted at the corrected clock from the next tick on
+*
+*	@param		error_ppb	counter clock error in parts per billion
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_trim_set(flash_config->crystal_ppb);	//from production calibration
+*	@endcode
+*
+*	@see	systick_calib_reference
+*	@see	systick_trim_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_trim_set(int32_t error_ppb)
+{
+	uint32_t state = systick_port_irq_save();
+
+	counter_trim_ppb = error_ppb;
+	if (counter_hz_nominal != 0)
+	{
+		systick_period_set(tick_reload, counter_hz_nominal);
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_trim_get()
+*//**
+* \b Description:
+*
+* 	Returns the counter clock error last set with systick_trim_set
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	int32_t counter clock error in parts per billion
+*
+* \b Example:
+*
+*	@code
+*	flash_config->crystal_ppb = systick_trim_get();		//keep for the next boot
+*	@endcode
+*
+*	@see	systick_trim_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+int32_t systick_trim_get(void)
+{
+	return (counter_trim_ppb);
+}
+
+/******************************************************************************
+* Function: systick_callback_register()
+*//**
+* \b Description:
+*
+* 	Registers the callback function as the desired on-interrupt functionality.
+* 	The callback is called on every tick, after the tick accounting, and
+* 	replaces the callback of any earlier call. Registering systick_increment
+* 	(the old default) simply removes the registered callback. With
+* 	SYSTICK_DEFER_ENABLED set the callback runs in the bottom half of
+* 	systick_defer.c rather than in the tick ISR.
+*
+*	PRE-CONDITION: A slot is free in the dispatch table
+*
+*	POST-CONDITION: the systick_callback function pointer variable now points to
+*					the desired function
+*
+*	@param		callback_func 	a function pointer to a void (*function)(void)
+*	@return		void
+*
+* \b Example:
+* @code
+*
+*	systick_callback_register(&interrupt_behaviour);
+*
+*	//the irq handler will now call interrupt_behaviour
+* 	SysTick_IRQHandler(void)
+* 	{
+* 		systick_irq_handler();
+* 	}
+* @endcode
+*
+*
+* @see systick_irq_handler
+* @see systick_subscribe
+*
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_callback_register(systick_callback_t callback_func)
+{
+	if (systick_callback != NULL)
+	{
+#if SYSTICK_DEFER_ENABLED
+		(void)systick_defer_unsubscribe(systick_callback);
+#else
+		(void)systick_unsubscribe(systick_callback);
+#endif
+	}
+	systick_callback = NULL;
+	if ((callback_func != NULL) && (callback_func != systick_increment))
+	{
+#if SYSTICK_DEFER_ENABLED
+		if (systick_defer_subscribe(callback_func, 1, 0) == SYSTICK_DISPATCH_OK)
+#else
+		if (systick_subscribe(callback_func, 1, 0) == SYSTICK_DISPATCH_OK)
+#endif
+		{
+			systick_callback = callback_func;
+		}
+	}
+}
+
+/******************************************************************************
+* Function: systick_irq_handler()
+*//**
+* \b Description:
+*
+* 	Accounts the tick through systick_increment, advances the software timers
+* 	when SYSTICK_TIMERS_ENABLED is set, and then calls every due subscriber of
+* 	the dispatch table (including a callback from systick_callback_register).
+* 	With SYSTICK_DEFER_ENABLED set, the tick is then handed to the bottom half
+* 	of systick_defer.c, which runs the deferred subscribers at the lowest
+* 	priority. With SYSTICK_ISR_STATS_ENABLED set, the counter is also sampled
+* 	on entry and exit to record the interrupt latency and the handler's run time.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: the tick has been accounted and the due subscribers called
+*
+
+*	@return		void
+*
+* \b Example:
+* @code
+*
+*	systick_callback_register(&interrupt_behaviour);
+*
+*	//the irq handler will now call interrupt_behaviour
+* 	SysTick_IRQHandler(void)
+* 	{
+* 		systick_irq_handler();
+* 	}
+* @endcode
+*
+*
+* @see	systick_callback_register
+* @see	systick_subscribe
+* @see	systick_increment
+*
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_irq_handler(void)
+{
+#if SYSTICK_ISR_STATS_ENABLED
+	uint32_t entry_val = systick_port_counter_get();
+#endif
+
+	systick_increment();
+#if SYSTICK_TIMERS_ENABLED
+	systick_timer_process();
+#endif
+	systick_dispatch_run();
+#if SYSTICK_DEFER_ENABLED
+	systick_defer_tick();
+#endif
+#if SYSTICK_ISR_STATS_ENABLED
+	systick_isr_sample(entry_val);
+#endif
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+* Title                 :   Systick C++ Interface
+* Filename              :   systick.hpp
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   g++ (C++11 or later)
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick.hpp
+ *  @brief Header-only C++ front end for a systick whose core clock and tick
+ *  		rate are fixed at build time. The reload value is computed and range
+ *  		checked by the compiler, so initialisation is a handful of register
+ *  		writes and reading the tick is a single load. Everything else goes
+ *  		through the C driver, which C callers keep using unchanged.
+ *
+ *  @code
+ *  using tick = systick::driver<100000000UL, 1000UL>;	//100 MHz core, 1 kHz tick
+ *
+ *  tick::init();
+ *  auto start = tick::clock::now();
+ *  ...
+ *  auto took = tick::clock::now() - start;				//std::chrono duration
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_HPP
+#define _SYSTICK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+extern "C"
+{
+#include "systick_interface.h"
+#include "systick_port.h"
+#include "systick_profile.h"
+}
+
+namespace systick
+{
+
+/**
+ * std::chrono clock reading the millisecond tick. The 64 bit tick is used so
+ * time points never wrap.
+ */
+struct clock
+{
+	typedef int64_t rep;
+	typedef std::milli period;
+	typedef std::chrono::duration<rep, period> duration;
+	typedef std::chrono::time_point<clock> time_point;
+	static constexpr bool is_steady = true;
+
+	static time_point now() noexcept
+	{
+		return (time_point(duration(static_cast<rep>(systick_get_tick64()))));
+	}
+};
+
+/**
+ * Profiles the enclosing scope as one zone of systick_profile.h
+ *
+ * @code
+ * {
+ * 	systick::profile_scope scope(PROFILE_ZONE_FFT);
+ * 	fft_run(samples);
+ * }
+ * @endcode
+ */
+class profile_scope
+{
+public:
+	explicit profile_scope(uint32_t zone) noexcept : zone_(zone), start_(systick_profile_begin())
+	{
+	}
+
+	~profile_scope()
+	{
+		systick_profile_end(zone_, start_);
+	}
+
+	profile_scope(const profile_scope &) = delete;
+	profile_scope &operator=(const profile_scope &) = delete;
+
+private:
+	uint32_t zone_;			/**<Zone the scope is counted in */
+	uint32_t start_;		/**<Time at construction */
+};
+
+/**
+ * Systick specialised for a fixed core clock and tick rate.
+ *
+ * @tparam CoreClockHz	core (AHB) clock in Hz
+ * @tparam TickRateHz	tick interrupts per second; need not divide the counter
+ * 						clock, the tick is kept drift free by the C driver
+ * @tparam ClockSource	counter clock, the external one runs at CoreClockHz / 8
+ */
+template <uint32_t CoreClockHz, uint32_t TickRateHz,
+		  systick_clock_source_t ClockSource = SYSTICK_INTERNAL_CLOCK>
+class driver
+{
+public:
+	typedef systick::clock clock;
+
+	static constexpr uint32_t counter_hz = (ClockSource == SYSTICK_INTERNAL_CLOCK) ?
+										   CoreClockHz : (CoreClockHz / 8UL);
+	static constexpr uint32_t reload = (TickRateHz != 0UL) ?
+									   (((counter_hz + (TickRateHz / 2UL)) / TickRateHz) - 1UL) : 0UL;
+
+	static_assert(TickRateHz > 0UL, "tick rate must be at least 1 Hz");
+	static_assert(TickRateHz <= counter_hz / 2UL,
+				  "tick period must be at least two counter clocks");
+	static_assert(reload <= SYSTICK_PORT_RELOAD_MAX,
+				  "tick period does not fit the 24 bit reload register");
+
+	/**
+	 * Starts the systick with the compile-time reload, skipping the runtime
+	 * division and checks of systick_init
+	 */
+	static void init(systick_interrupt_t interrupt_control = SYSTICK_INT_ENABLED) noexcept
+	{
+		systick_init_reload(reload, counter_hz, ClockSource, interrupt_control);
+	}
+
+	/**
+	 * Millisecond tick, inlined to one load of the tick variable
+	 */
+	static uint32_t get_tick() noexcept
+	{
+		return (systick_tick_ms);
+	}
+
+	/**
+	 * Blocks for at least the given duration, rounded up to whole milliseconds
+	 */
+	template <class Rep, class Period>
+	static void delay(std::chrono::duration<Rep, Period> duration) noexcept
+	{
+		std::chrono::milliseconds ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+
+		if (ms < duration)
+		{
+			ms += std::chrono::milliseconds(1);
+		}
+		systick_delay(static_cast<uint32_t>(ms.count()));
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*******************************************************************************
+* Title                 :   Systick Clock Calibration
+* Filename              :   systick_calib.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_calib.c
+ *  @brief Counter clock error measurement behind systick_calib.h. Reference
+ *  		intervals are compared with the local time already corrected by
+ *  		the current trim, so each measurement is the remaining error and is
+ *  		compounded onto the trim.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include "systick_calib.h"
+#include "systick_port.h"
+
+#define PPB_PER_UNIT	1000000000LL	/**<Parts per billion in one */
+
+static uint32_t anchor_local;			/**<Local time of the sample intervals are measured from */
+static uint32_t anchor_reference;		/**<Reference time of that sample */
+static volatile uint32_t anchored = 0;	/**<Non-zero once a sample has been taken */
+
+/**
+ * Checks a clock error against SYSTICK_CALIB_MAX_PPB
+ */
+static uint32_t calib_in_range(int64_t error_ppb)
+{
+	return ((error_ppb >= -SYSTICK_CALIB_MAX_PPB) && (error_ppb <= SYSTICK_CALIB_MAX_PPB));
+}
+
+/******************************************************************************
+* Function: systick_calib_tenms()
+*//**
+* \b Description:
+*
+* 	Compares the external reference clock the driver assumes (SystemCoreClock
+* 	/ 8 on the STM32F411) with the one the SysTick calibration register gives
+* 	and trims the tick accounting by the difference. The register value holds
+* 	for the clock the part was designed to run at only, and resolves one
+* 	count in ten milliseconds of the reference.
+*
+*	PRE-CONDITION: The core runs at the clock the calibration register was set for
+*
+*	POST-CONDITION: On SYSTICK_CALIB_OK the trim is set to the measured error
+*
+*	@param		error_ppb	set to the measured error in parts per billion,
+*							positive if the clock is faster than assumed
+*
+*	@return 	systick_calib_status_t SYSTICK_CALIB_OK,
+*				SYSTICK_CALIB_NO_REFERENCE if the core has no calibration
+*				value, or SYSTICK_CALIB_OUT_OF_RANGE
+*
+* \b Example:
+*
+*	@code
+*	int32_t error_ppb;
+*
+*	if (systick_calib_tenms(&error_ppb) == SYSTICK_CALIB_OUT_OF_RANGE)
+*	{
+*		fault_report(FAULT_CORE_CLOCK);		//SystemCoreClock is wrong
+*	}
+*	@endcode
+*
+*	@see	systick_trim_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_calib_status_t systick_calib_tenms(int32_t *error_ppb)
+{
+	uint32_t calib_hz = systick_port_calib_tenms() * 100UL;
+	uint32_t assumed_hz = systick_port_counter_hz(SYSTICK_EXTERNAL_CLOCK);
+	int64_t error;
+
+	if ((calib_hz == 0) || (assumed_hz == 0))
+	{
+		return (SYSTICK_CALIB_NO_REFERENCE);
+	}
+	error = (((int64_t)calib_hz - (int64_t)assumed_hz) * PPB_PER_UNIT) / (int64_t)assumed_hz;
+	if (calib_in_range(error) == 0)
+	{
+		return (SYSTICK_CALIB_OUT_OF_RANGE);
+	}
+	*error_ppb = (int32_t)error;
+	systick_trim_set((int32_t)error);
+	return (SYSTICK_CALIB_OK);
+}
+
+/******************************************************************************
+* Function: systick_calib_reference_reset()
+*//**
+* \b Description:
+*
+* 	Forgets the reference samples taken so far, e.g. after the reference was
+* 	lost or stepped. The trim already applied is kept.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The next sample starts a new measurement interval
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	if (gps_fix_lost())
+*	{
+*		systick_calib_reference_reset();
+*	}
+*	@endcode
+*
+*	@see	systick_calib_reference
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_calib_reference_reset(void)
+{
+	anchored = 0;
+}
+
+/******************************************************************************
+* Function: systick_calib_reference()
+*//**
+* \b Description:
+*
+* 	Takes one sample of a reference time stream: the reference time of an
+* 	event and the local time (systick_get_time_us) it was seen at. Once
+* 	SYSTICK_CALIB_SPAN_US of reference time have passed since the interval
+* 	began, the counter clock error over the interval is compounded onto the
+* 	trim and the next interval begins at this sample. Repeated intervals
+* 	track the crystal as it drifts with temperature and age.
+*
+*	PRE-CONDITION: Samples are less than 2^31 us apart in both time bases
+*	PRE-CONDITION: Not called concurrently with itself
+*
+*	POST-CONDITION: On SYSTICK_CALIB_OK the trim holds the measured error
+*
+*	@param		local_us		systick_get_time_us when the event was seen
+*	@param		reference_us	time of the event in the reference clock
+*
+*	@return 	systick_calib_status_t SYSTICK_CALIB_OK once an interval is
+*				complete, SYSTICK_CALIB_PENDING before, or
+*				SYSTICK_CALIB_OUT_OF_RANGE if the interval disagrees by more
+*				than SYSTICK_CALIB_MAX_PPB (the interval is dropped)
+*
+* \b Example:
+*
+*	@code
+*	void gateway_time_received(uint32_t gateway_us)
+*	{
+*		systick_calib_reference(systick_get_time_us(), gateway_us);
+*	}
+*	@endcode
+*
+*	@see	systick_calib_reference_reset
+*	@see	systick_trim_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_calib_status_t systick_calib_reference(uint32_t local_us, uint32_t reference_us)
+{
+	uint32_t reference_span = reference_us - anchor_reference;
+	uint32_t local_span = local_us - anchor_local;
+	int64_t residual;
+	int64_t trim;
+
+	if ((anchored == 0) || (reference_span < SYSTICK_CALIB_SPAN_US))
+	{
+		if (anchored == 0)
+		{
+			anchor_local = local_us;
+			anchor_reference = reference_us;
+			anchored = 1;
+		}
+		return (SYSTICK_CALIB_PENDING);
+	}
+	anchor_local = local_us;
+	anchor_reference = reference_us;
+
+	residual = (((int64_t)local_span - (int64_t)reference_span) * PPB_PER_UNIT) / (int64_t)reference_span;
+	trim = systick_trim_get();
+	trim += residual + ((trim * residual) / PPB_PER_UNIT);
+	if ((calib_in_range(residual) == 0) || (calib_in_range(trim) == 0))
+	{
+		return (SYSTICK_CALIB_OUT_OF_RANGE);
+	}
+	systick_trim_set((int32_t)trim);
+	return (SYSTICK_CALIB_OK);
+}
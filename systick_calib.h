@@ -0,0 +1,77 @@
+/*******************************************************************************
+* Title                 :   Systick Clock Calibration
+* Filename              :   systick_calib.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_calib.h
+ *  @brief Measures the error of the counter clock and corrects the tick
+ *  		accounting for it through systick_trim_set.
+ *
+ *  Two references are supported:
+ *  - the SysTick calibration register (systick_calib_tenms), which catches a
+ *    SystemCoreClock that does not match the clock the part was built for.
+ *    It is fixed in silicon, so it cannot see the crystal's own error. On the
+ *    STM32F411 the external SysTick reference is HCLK / 8, from the same
+ *    oscillator, so comparing the two clock sources cannot see it either.
+ *  - a stream of reference timestamps (systick_calib_reference), e.g. a GPS
+ *    pulse per second or time stamps from a gateway, each paired with the
+ *    local time it was seen at. This measures the crystal error.
+ *
+ *  @code
+ *  void EXTI0_IRQHandler(void)							//GPS pulse per second
+ *  {
+ *  	static uint32_t pps_us = 0;
+ *
+ *  	EXTI->PR = EXTI_PR_PR0;
+ *  	pps_us += 1000000UL;
+ *  	systick_calib_reference(systick_get_time_us(), pps_us);
+ *  }
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_CALIB_H
+#define _SYSTICK_CALIB_H
+
+#include "systick_interface.h"
+
+/**
+ * Result of a calibration step
+ */
+typedef enum
+{
+	SYSTICK_CALIB_OK,				/**<The error was measured and the trim applied */
+	SYSTICK_CALIB_PENDING,			/**<Not enough reference time yet, nothing changed */
+	SYSTICK_CALIB_NO_REFERENCE,		/**<The reference is not available */
+	SYSTICK_CALIB_OUT_OF_RANGE		/**<The error exceeds SYSTICK_CALIB_MAX_PPB, nothing changed */
+}systick_calib_status_t;
+
+systick_calib_status_t systick_calib_tenms(int32_t *error_ppb);
+void systick_calib_reference_reset(void);
+systick_calib_status_t systick_calib_reference(uint32_t local_us, uint32_t reference_us);
+
+#endif
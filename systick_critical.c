@@ -0,0 +1,437 @@
+/*******************************************************************************
+* Title                 :   Systick Critical Section Tracker
+* Filename              :   systick_critical.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_critical.c
+ *  @brief Timing behind systick_critical.h. A section is timed if it masks
+ *  		more than every section open when it starts (PRIMASK masks more
+ *  		than any BASEPRI level, and a more urgent BASEPRI level more than
+ *  		a less urgent one); it is then pushed as a frame, its start stamped
+ *  		after the mask is set and its end before the mask is lifted. Any
+ *  		other section is nested in the frame on top. Preemption is last
+ *  		in, first out, so the frames form one stack across contexts: an
+ *  		interrupt left unmasked by a BASEPRI section times its own sections
+ *  		rather than being counted as nested in the interrupted one.
+ *
+ *  The table is updated after the mask is lifted, so the bookkeeping does
+ *  not lengthen the sections it measures.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include "systick_critical.h"
+#include "systick_interface.h"
+
+#if SYSTICK_CRITICAL_STATS_ENABLED
+
+/**
+ * A timed section on its way from the exit to the table
+ */
+typedef struct
+{
+	uintptr_t site;				/**<Return address of the enter call */
+	uint32_t clocks;			/**<Masked time in counter clocks */
+	uint32_t tick_held;			/**<Non-zero if the tick was pending at the exit */
+}critical_section_t;
+
+/**
+ * A timed section still open
+ */
+typedef struct
+{
+	uint32_t level;				/**<0 for PRIMASK, else the BASEPRI priority */
+	uint32_t nested;			/**<Untimed sections open inside it */
+	uint32_t entry_clocks;		/**<systick_get_cycles at the enter */
+	uintptr_t site;				/**<Return address of the enter call */
+}critical_frame_t;
+
+#define CRITICAL_LEVEL_PRIMASK	(0UL)	/**<Masking level of systick_critical_enter */
+#define CRITICAL_FRAMES			(16U)	/**<PRIMASK plus every BASEPRI level of a 4 bit NVIC */
+
+static critical_frame_t frames[CRITICAL_FRAMES];	/**<Timed sections, innermost last */
+static volatile uint32_t frame_count = 0;			/**<Valid entries in frames */
+static systick_critical_stats_t critical_stats;		/**<Statistics since the last reset */
+
+/**
+ * Accounts an enter at a masking level, stamping the section if it masks
+ * more than every open one
+ */
+static void critical_open(uint32_t level, uintptr_t site)
+{
+	uint32_t now = systick_get_cycles();
+	uint32_t count = frame_count;
+
+	if ((count != 0) && ((level >= frames[count - 1U].level) || (count == CRITICAL_FRAMES)))
+	{
+		frames[count - 1U].nested++;
+	}
+	else
+	{
+		frames[count].level = level;
+		frames[count].nested = 0;
+		frames[count].entry_clocks = now;
+		frames[count].site = site;
+		frame_count = count + 1U;
+	}
+}
+
+/**
+ * Accounts an exit, returning non-zero and the timed section if it ends a
+ * timed one
+ */
+static uint32_t critical_close(critical_section_t *section)
+{
+	uint32_t now = systick_get_cycles();
+	uint32_t count = frame_count;
+	critical_frame_t *frame;
+
+	if (count == 0)
+	{
+		return (0);			/* unbalanced exit */
+	}
+	frame = &frames[count - 1U];
+	if (frame->nested != 0)
+	{
+		frame->nested--;
+		return (0);
+	}
+	section->clocks = now - frame->entry_clocks;
+	section->site = frame->site;
+	section->tick_held = systick_port_tick_pending();
+	frame_count = count - 1U;
+	return (1);
+}
+
+/**
+ * Adds a section to the statistics, keeping the table sorted longest first
+ * with one entry per call site
+ */
+static void critical_record(const critical_section_t *section)
+{
+	uint32_t state = systick_port_irq_save();
+	systick_critical_entry_t swap;
+	uint32_t slot;
+
+	critical_stats.sections++;
+	if (section->tick_held != 0)
+	{
+		critical_stats.ticks_held++;
+	}
+	for (slot = 0; (slot < critical_stats.count) && (critical_stats.top[slot].site != section->site); slot++);
+	if (slot == critical_stats.count)
+	{
+		if (critical_stats.count < SYSTICK_CRITICAL_TOP_N)
+		{
+			critical_stats.count++;
+		}
+		else if (section->clocks > critical_stats.top[SYSTICK_CRITICAL_TOP_N - 1].clocks)
+		{
+			slot = SYSTICK_CRITICAL_TOP_N - 1;		/* evict the shortest */
+		}
+		else
+		{
+			systick_port_irq_restore(state);
+			return;
+		}
+		critical_stats.top[slot].site = section->site;
+		critical_stats.top[slot].clocks = 0;
+	}
+	if (section->clocks >= critical_stats.top[slot].clocks)
+	{
+		critical_stats.top[slot].clocks = section->clocks;
+		while ((slot > 0) && (critical_stats.top[slot - 1].clocks < critical_stats.top[slot].clocks))
+		{
+			swap = critical_stats.top[slot - 1];
+			critical_stats.top[slot - 1] = critical_stats.top[slot];
+			critical_stats.top[slot] = swap;
+			slot--;
+		}
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_critical_enter()
+*//**
+* \b Description:
+*
+* 	Masks interrupts through PRIMASK, like systick_port_irq_save, and starts
+* 	timing the section unless a PRIMASK section is already open. Nests
+* 	correctly.
+*
+*	PRE-CONDITION: The systick has been initialised
+*
+*	POST-CONDITION: Interrupts are masked
+*
+*	@return 	uint32_t the mask state to pass to systick_critical_exit
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_critical_enter();
+*	fifo_push(&rx_fifo, byte);
+*	systick_critical_exit(state);
+*	@endcode
+*
+*	@see	systick_critical_exit
+*	@see	systick_critical_enter_priority
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_critical_enter(void)
+{
+	uint32_t state = systick_port_irq_save();
+
+	critical_open(CRITICAL_LEVEL_PRIMASK, (uintptr_t)__builtin_return_address(0));
+	return (state);
+}
+/******************************************************************************
+* Function: systick_critical_exit()
+*//**
+* \b Description:
+*
+* 	Ends a section begun with systick_critical_enter and, if it was timed,
+* 	adds its time to the statistics once interrupts are unmasked
+*
+*	PRE-CONDITION: state comes from the matching systick_critical_enter
+*
+*	POST-CONDITION: PRIMASK is back to its state before the matching enter
+*
+*	@param		state	the value returned by systick_critical_enter
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_critical_enter();
+*	fifo_push(&rx_fifo, byte);
+*	systick_critical_exit(state);
+*	@endcode
+*
+*	@see	systick_critical_enter
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_critical_exit(uint32_t state)
+{
+	critical_section_t section;
+	uint32_t timed = critical_close(&section);
+
+	systick_port_irq_restore(state);
+	if (timed != 0)
+	{
+		critical_record(&section);
+	}
+}
+
+/******************************************************************************
+* Function: systick_critical_enter_priority()
+*//**
+* \b Description:
+*
+* 	Masks the interrupts of the given priority and below through BASEPRI, like
+* 	systick_port_irq_raise, and starts timing the section unless one masking
+* 	as much is already open. Nests correctly, with itself and with
+* 	systick_critical_enter.
+*
+*	PRE-CONDITION: The systick has been initialised
+*	PRE-CONDITION: 0 < priority < (1 << __NVIC_PRIO_BITS)
+*
+*	POST-CONDITION: Interrupts at priority and below are masked
+*
+*	@param		priority	the most urgent priority to mask, unshifted as
+*							for NVIC_SetPriority
+*
+*	@return 	uint32_t the mask state to pass to systick_critical_exit_priority
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_critical_enter_priority(UART_IRQ_PRIORITY);
+*	fifo_push(&rx_fifo, byte);
+*	systick_critical_exit_priority(state);
+*	@endcode
+*
+*	@see	systick_critical_exit_priority
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_critical_enter_priority(uint32_t priority)
+{
+	uint32_t state = systick_port_irq_raise(priority);
+
+	critical_open(priority, (uintptr_t)__builtin_return_address(0));
+	return (state);
+}
+/******************************************************************************
+* Function: systick_critical_exit_priority()
+*//**
+* \b Description:
+*
+* 	Ends a section begun with systick_critical_enter_priority and, if it was
+* 	timed, adds its time to the statistics once the mask is lowered
+*
+*	PRE-CONDITION: state comes from the matching systick_critical_enter_priority
+*
+*	POST-CONDITION: BASEPRI is back to its value before the matching enter
+*
+*	@param		state	the value returned by systick_critical_enter_priority
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_critical_enter_priority(UART_IRQ_PRIORITY);
+*	fifo_push(&rx_fifo, byte);
+*	systick_critical_exit_priority(state);
+*	@endcode
+*
+*	@see	systick_critical_enter_priority
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_critical_exit_priority(uint32_t state)
+{
+	critical_section_t section;
+	uint32_t timed = critical_close(&section);
+
+	systick_port_irq_lower(state);
+	if (timed != 0)
+	{
+		critical_record(&section);
+	}
+}
+
+/******************************************************************************
+* Function: systick_critical_stats_get()
+*//**
+* \b Description:
+*
+* 	Copies the statistics out, consistently with respect to sections ending
+* 	meanwhile
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@param		stats	filled with the statistics since the last reset
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_critical_stats_t stats;
+*	uint32_t i;
+*
+*	systick_critical_stats_get(&stats);
+*	for (i = 0; i < stats.count; i++)
+*	{
+*		printf("%08lx %lu clocks\n", (unsigned long)stats.top[i].site, stats.top[i].clocks);
+*	}
+*	@endcode
+*
+*	@see	systick_critical_stats_reset
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_critical_stats_get(systick_critical_stats_t *stats)
+{
+	uint32_t state = systick_port_irq_save();
+
+	*stats = critical_stats;
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_critical_stats_reset()
+*//**
+* \b Description:
+*
+* 	Clears the statistics, e.g. after start-up when only steady state
+* 	sections matter. A section open meanwhile is still timed when it ends.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The table is empty
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	app_init();
+*	systick_critical_stats_reset();
+*	@endcode
+*
+*	@see	systick_critical_stats_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_critical_stats_reset(void)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	critical_stats.sections = 0;
+	critical_stats.ticks_held = 0;
+	critical_stats.count = 0;
+	for (i = 0; i < SYSTICK_CRITICAL_TOP_N; i++)
+	{
+		critical_stats.top[i].site = 0;
+		critical_stats.top[i].clocks = 0;
+	}
+	systick_port_irq_restore(state);
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Title                 :   Systick Critical Section Tracker
+* Filename              :   systick_critical.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_critical.h
+ *  @brief Critical section wrappers which find the sections that hold
+ *  		interrupts off the longest. systick_critical_enter masks through
+ *  		PRIMASK and systick_critical_enter_priority through BASEPRI; each
+ *  		pairs with its own exit.
+ *
+ *  With SYSTICK_CRITICAL_STATS_ENABLED set, every section which masks more
+ *  than the sections open when it starts is timed in counter clocks from systick_get_cycles and kept in a
+ *  table of the SYSTICK_CRITICAL_TOP_N longest, one entry per call site. The
+ *  call site is the return address of the enter call, to be looked up with
+ *  addr2line (clear bit 0 on Thumb). Times are exact while the section is
+ *  shorter than a tick period; a longer one has held the tick off for more
+ *  than a period, loses whole periods from its time and is counted in
+ *  ticks_held like any section that held the tick off.
+ *
+ *  With SYSTICK_CRITICAL_STATS_ENABLED at 0 the wrappers are inline calls of
+ *  the port mask functions and systick_critical.c compiles to nothing.
+ *
+ *  @code
+ *  uint32_t state = systick_critical_enter();
+ *  fifo_push(&rx_fifo, byte);
+ *  systick_critical_exit(state);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_CRITICAL_H
+#define _SYSTICK_CRITICAL_H
+
+#include "systick_stm32f411_config.h"
+#include "systick_port.h"
+
+/**
+ * Longest section seen at one call site
+ */
+typedef struct
+{
+	uintptr_t site;				/**<Return address of the enter call */
+	uint32_t clocks;			/**<Longest masked time, in counter clocks */
+}systick_critical_entry_t;
+
+/**
+ * Copy of the statistics
+ */
+typedef struct
+{
+	uint32_t sections;			/**<Sections timed */
+	uint32_t ticks_held;		/**<Sections which ended with the tick interrupt pending */
+	uint32_t count;				/**<Valid entries in top */
+	systick_critical_entry_t top[SYSTICK_CRITICAL_TOP_N];	/**<Longest first */
+}systick_critical_stats_t;
+
+#if SYSTICK_CRITICAL_STATS_ENABLED
+uint32_t systick_critical_enter(void);
+void systick_critical_exit(uint32_t state);
+uint32_t systick_critical_enter_priority(uint32_t priority);
+void systick_critical_exit_priority(uint32_t state);
+#else
+/**
+ * Masks interrupts through PRIMASK, untimed
+ */
+static inline uint32_t systick_critical_enter(void)
+{
+	return (systick_port_irq_save());
+}
+
+/**
+ * Ends a section begun with systick_critical_enter
+ */
+static inline void systick_critical_exit(uint32_t state)
+{
+	systick_port_irq_restore(state);
+}
+
+/**
+ * Masks interrupts at priority and below through BASEPRI, untimed
+ */
+static inline uint32_t systick_critical_enter_priority(uint32_t priority)
+{
+	return (systick_port_irq_raise(priority));
+}
+
+/**
+ * Ends a section begun with systick_critical_enter_priority
+ */
+static inline void systick_critical_exit_priority(uint32_t state)
+{
+	systick_port_irq_lower(state);
+}
+#endif
+
+void systick_critical_stats_get(systick_critical_stats_t *stats);
+void systick_critical_stats_reset(void);
+
+#endif
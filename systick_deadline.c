@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Title                 :   Systick Deadlines
+* Filename              :   systick_deadline.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_deadline.c
+ *  @brief Blocking wait on top of the deadline objects in systick_deadline.h
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include "systick_deadline.h"
+#include "systick_port.h"
+
+/******************************************************************************
+* Function: systick_wait_until()
+*//**
+* \b Description:
+*
+* 	Waits until predicate returns non-zero or timeout_ms milliseconds pass.
+* 	The predicate is first polled SYSTICK_WAIT_SPIN_POLLS times back to back,
+* 	which catches conditions that settle within microseconds at full speed;
+* 	after that the core waits for an event (WFE) between polls, so it sleeps
+* 	until an interrupt (at the latest the next tick) or an SEV. The predicate
+* 	is checked once more after the timeout, so a condition met just in time
+* 	is not reported as a timeout.
+*
+*	PRE-CONDITION: Called from thread mode with the systick interrupt enabled
+*	PRE-CONDITION: predicate is non-NULL and has no side effects beyond polling
+*
+*	POST-CONDITION: The predicate is true, or timeout_ms have gone by
+*
+*	@param		predicate	condition to wait for
+*	@param		arg			argument passed to predicate
+*	@param		timeout_ms	longest wait in milliseconds, at most SYSTICK_DEADLINE_MAX_MS
+*
+*	@return 	systick_wait_status_t SYSTICK_WAIT_OK if the predicate became
+*				true, SYSTICK_WAIT_TIMEOUT otherwise
+*
+* \b Example:
+*
+*	@code
+*	static uint32_t dma_idle(void *arg)
+*	{
+*		return ((((DMA_Stream_TypeDef *)arg)->CR & DMA_SxCR_EN) == 0);
+*	}
+*
+*	if (systick_wait_until(&dma_idle, DMA2_Stream7, 10) == SYSTICK_WAIT_TIMEOUT)
+*	{
+*		dma_abort(DMA2_Stream7);
+*	}
+*	@endcode
+*
+*	@see	systick_deadline_expired
+*	@see	systick_port_wait_event
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_wait_status_t systick_wait_until(systick_predicate_t predicate, void *arg, uint32_t timeout_ms)
+{
+	systick_deadline_t deadline;
+	uint32_t polls = 0;
+
+	systick_deadline_start(&deadline, timeout_ms);
+	while ((*predicate)(arg) == 0)
+	{
+		if (systick_deadline_expired(&deadline))
+		{
+			return (((*predicate)(arg) != 0) ? SYSTICK_WAIT_OK : SYSTICK_WAIT_TIMEOUT);
+		}
+		if (polls < SYSTICK_WAIT_SPIN_POLLS)
+		{
+			polls++;
+			systick_port_spin();
+		}
+		else
+		{
+			systick_port_wait_event();
+		}
+	}
+	return (SYSTICK_WAIT_OK);
+}
@@ -0,0 +1,238 @@
+/*******************************************************************************
+* Title                 :   Systick Deadlines
+* Filename              :   systick_deadline.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_deadline.h
+ *  @brief Timeout objects for driver poll loops. A deadline stores the tick
+ *  		on which it expires, so checking it is one load of the tick and one
+ *  		signed compare, correct across the 32 bit tick wrap. The checks are
+ *  		inline and read systick_tick_ms directly.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_DEADLINE_H
+#define _SYSTICK_DEADLINE_H
+
+#include "systick_interface.h"
+
+/**
+ * Longest timeout a deadline can hold, in milliseconds (about 24.8 days).
+ * Longer timeouts are clamped to it.
+ */
+#define SYSTICK_DEADLINE_MAX_MS		(0x7FFFFFFFUL)
+
+/**
+ * A point in time in systick milliseconds
+ */
+typedef struct
+{
+	uint32_t expires;	/**<Tick value at which the deadline has passed */
+}systick_deadline_t;
+
+/**
+ * Condition polled by systick_wait_until, non-zero once satisfied
+ */
+typedef uint32_t (*systick_predicate_t) (void *arg);
+
+/**
+ * Outcome of systick_wait_until
+ */
+typedef enum
+{
+	SYSTICK_WAIT_OK,		/**<The predicate became true */
+	SYSTICK_WAIT_TIMEOUT	/**<The timeout passed first */
+}systick_wait_status_t;
+
+/******************************************************************************
+* Function: systick_deadline_start()
+*//**
+* \b Description:
+*
+* 	Sets a deadline timeout_ms milliseconds from now. The millisecond tick
+* 	lags true time by up to systick_slack_ms, so that much is added, as
+* 	systick_delay does: the deadline never passes early, and passes at most
+* 	a tick period plus a millisecond late.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The deadline expires once timeout_ms have gone by, not before
+*
+*	@param		deadline	the deadline to set
+*	@param		timeout_ms	milliseconds until expiry, at most SYSTICK_DEADLINE_MAX_MS
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_deadline_t timeout;
+*
+*	systick_deadline_start(&timeout, 25);
+*	while ((I2C1->SR1 & I2C_SR1_TXE) == 0)
+*	{
+*		if (systick_deadline_expired(&timeout))
+*		{
+*			return (I2C_TIMEOUT);
+*		}
+*	}
+*	@endcode
+*
+*	@see	systick_deadline_expired
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+static inline void systick_deadline_start(systick_deadline_t *deadline, uint32_t timeout_ms)
+{
+	if (timeout_ms > (SYSTICK_DEADLINE_MAX_MS - systick_slack_ms))
+	{
+		timeout_ms = SYSTICK_DEADLINE_MAX_MS - systick_slack_ms;
+	}
+	deadline->expires = systick_tick_ms + timeout_ms + systick_slack_ms;
+}
+
+/******************************************************************************
+* Function: systick_deadline_expired()
+*//**
+* \b Description:
+*
+* 	Reports whether a deadline has passed. Wrap-safe for any deadline set with
+* 	systick_deadline_start.
+*
+*	PRE-CONDITION: deadline has been set with systick_deadline_start
+*
+*	POST-CONDITION: None
+*
+*	@param		deadline	the deadline to check
+*
+*	@return 	uint32_t non-zero once the deadline has passed, 0 before
+*
+* \b Example:
+*
+*	@code
+*	while (!spi_done() && !systick_deadline_expired(&timeout));
+*	@endcode
+*
+*	@see	systick_deadline_start
+*	@see	systick_deadline_remaining
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+static inline uint32_t systick_deadline_expired(const systick_deadline_t *deadline)
+{
+	return ((int32_t)(systick_tick_ms - deadline->expires) >= 0);
+}
+
+/******************************************************************************
+* Function: systick_deadline_remaining()
+*//**
+* \b Description:
+*
+* 	Returns the time left until a deadline, 0 if it has passed. Useful to pass
+* 	what is left of an overall timeout on to a nested operation.
+*
+*	PRE-CONDITION: deadline has been set with systick_deadline_start
+*
+*	POST-CONDITION: None
+*
+*	@param		deadline	the deadline to check
+*
+*	@return 	uint32_t milliseconds until expiry
+*
+* \b Example:
+*
+*	@code
+*	status = uart_read(&uart2, buffer, length, systick_deadline_remaining(&timeout));
+*	@endcode
+*
+*	@see	systick_deadline_expired
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+static inline uint32_t systick_deadline_remaining(const systick_deadline_t *deadline)
+{
+	int32_t left = (int32_t)(deadline->expires - systick_tick_ms);
+
+	return ((left > 0) ? (uint32_t)left : 0UL);
+}
+
+/******************************************************************************
+* Function: systick_deadline_extend()
+*//**
+* \b Description:
+*
+* 	Moves a deadline later by extra_ms milliseconds, measured from its current
+* 	expiry rather than from now, so periodic deadlines do not drift
+*
+*	PRE-CONDITION: deadline has been set with systick_deadline_start
+*	PRE-CONDITION: the extended deadline is at most SYSTICK_DEADLINE_MAX_MS from now
+*
+*	POST-CONDITION: The deadline expires extra_ms later than before
+*
+*	@param		deadline	the deadline to move
+*	@param		extra_ms	milliseconds to add
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	if (systick_deadline_expired(&sample_period))
+*	{
+*		systick_deadline_extend(&sample_period, 10);
+*		adc_sample();
+*	}
+*	@endcode
+*
+*	@see	systick_deadline_start
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+static inline void systick_deadline_extend(systick_deadline_t *deadline, uint32_t extra_ms)
+{
+	deadline->expires += extra_ms;
+}
+
+systick_wait_status_t systick_wait_until(systick_predicate_t predicate, void *arg, uint32_t timeout_ms);
+
+#endif
@@ -0,0 +1,490 @@
+/*******************************************************************************
+* Title                 :   Systick Deferred Work
+* Filename              :   systick_defer.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_defer.c
+ *  @brief Deferred work queue and tick counter behind systick_defer.h. The
+ *  		queue is a bounded ring with a sequence number per slot, as in
+ *  		systick_trace.c: producers claim a position by compare-and-swap and
+ *  		publish the item through the slot's sequence, the bottom half is the
+ *  		only consumer. Ticks are handed over as a counter the ISR increments
+ *  		and the bottom half swaps to zero, so a late bottom half catches up.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdatomic.h>
+#include <stddef.h>
+#include "systick_defer.h"
+#include "systick_port.h"
+
+#if (SYSTICK_DEFER_QUEUE_SIZE & (SYSTICK_DEFER_QUEUE_SIZE - 1)) != 0
+#error "SYSTICK_DEFER_QUEUE_SIZE must be a power of two"
+#endif
+
+#define QUEUE_MASK		(SYSTICK_DEFER_QUEUE_SIZE - 1UL)	/**<Slot index mask */
+
+/**
+ * One queued work item
+ */
+typedef struct
+{
+	_Atomic uint32_t sequence;		/**<Position the slot is free for, plus one once written */
+	systick_defer_work_t work;		/**<Function to run */
+	void *arg;						/**<Passed to work */
+}work_slot_t;
+
+static work_slot_t queue[SYSTICK_DEFER_QUEUE_SIZE];		/**<Work item ring */
+static _Atomic uint32_t queue_head = 0;					/**<Next position to write */
+static uint32_t queue_tail = 0;							/**<Next position to run, bottom half only */
+static _Atomic uint32_t dropped = 0;					/**<Items lost to a full queue */
+static _Atomic uint32_t pending_ticks = 0;				/**<Ticks not yet seen by the bottom half */
+static systick_dispatch_table_t defer_table;			/**<Subscribers run in the bottom half */
+
+/******************************************************************************
+* Function: systick_defer_init()
+*//**
+* \b Description:
+*
+* 	Empties the work queue and the deferred subscriber table and gives the
+* 	bottom half the lowest interrupt priority. Called by systick_init when
+* 	SYSTICK_DEFER_ENABLED is set.
+*
+*	PRE-CONDITION: PendSV_Handler calls systick_defer_handler
+*
+*	POST-CONDITION: Nothing is queued or subscribed
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_defer_init();
+*	systick_defer_subscribe(&log_flush, 100, 0);
+*	@endcode
+*
+*	@see	systick_defer_subscribe
+*	@see	systick_defer_post
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_defer_init(void)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_DEFER_QUEUE_SIZE; i++)
+	{
+		atomic_store_explicit(&queue[i].sequence, i, memory_order_relaxed);
+	}
+	atomic_store_explicit(&queue_head, 0UL, memory_order_relaxed);
+	queue_tail = 0;
+	atomic_store_explicit(&dropped, 0UL, memory_order_relaxed);
+	atomic_store_explicit(&pending_ticks, 0UL, memory_order_relaxed);
+	systick_dispatch_table_init(&defer_table);
+	systick_port_irq_restore(state);
+	systick_port_defer_init();
+}
+
+/******************************************************************************
+* Function: systick_defer_post()
+*//**
+* \b Description:
+*
+* 	Queues one call of work(arg) for the bottom half and pends it. Lock-free
+* 	and callable from any interrupt or from thread mode; items run in the
+* 	order their positions were claimed.
+*
+*	PRE-CONDITION: systick_defer_init has been called
+*
+*	POST-CONDITION: work runs once in the bottom half, unless the queue was full
+*
+*	@param		work	function to run
+*	@param		arg		passed to work
+*
+*	@return 	systick_defer_status_t SYSTICK_DEFER_OK, or SYSTICK_DEFER_FULL
+*
+* \b Example:
+*
+*	@code
+*	void DMA1_Stream5_IRQHandler(void)
+*	{
+*		DMA1->HIFCR = DMA_HIFCR_CTCIF5;
+*		systick_defer_post(&packet_parse, &rx_buffer);
+*	}
+*	@endcode
+*
+*	@see	systick_defer_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_defer_status_t systick_defer_post(systick_defer_work_t work, void *arg)
+{
+	work_slot_t *slot;
+	uint32_t pos;
+	uint32_t sequence;
+
+	if (work == NULL)
+	{
+		return (SYSTICK_DEFER_INVALID);
+	}
+
+	for (;;)
+	{
+		pos = atomic_load_explicit(&queue_head, memory_order_relaxed);
+		slot = &queue[pos & QUEUE_MASK];
+		sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		if (sequence == pos)
+		{
+			if (atomic_compare_exchange_weak_explicit(&queue_head, &pos, pos + 1UL,
+													  memory_order_relaxed, memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if ((int32_t)(sequence - pos) < 0)
+		{
+			atomic_fetch_add_explicit(&dropped, 1UL, memory_order_relaxed);
+			return (SYSTICK_DEFER_FULL);
+		}
+		/* else another producer claimed pos first, retry with the new head */
+	}
+
+	slot->work = work;
+	slot->arg = arg;
+	atomic_store_explicit(&slot->sequence, pos + 1UL, memory_order_release);
+	systick_port_defer_pend();
+	return (SYSTICK_DEFER_OK);
+}
+
+/******************************************************************************
+* Function: systick_defer_subscribe()
+*//**
+* \b Description:
+*
+* 	Adds a function to be called from the bottom half every divider ticks,
+* 	with the ordering rules of systick_subscribe
+*
+*	PRE-CONDITION: callback is non-NULL and divider is at least 1
+*
+*	POST-CONDITION: callback runs in the bottom half on every divider-th tick
+*
+*	@param		callback	function to call
+*	@param		divider		call every divider ticks (1 = every tick)
+*	@param		priority	call order, 0 runs first
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK on success
+*
+* \b Example:
+*
+*	@code
+*	systick_defer_subscribe(&filter_update, 1, 0);
+*	@endcode
+*
+*	@see	systick_defer_unsubscribe
+*	@see	systick_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_defer_subscribe(systick_callback_t callback, uint32_t divider,
+												  uint8_t priority)
+{
+	return (systick_dispatch_table_subscribe(&defer_table, callback, divider, priority));
+}
+
+/******************************************************************************
+* Function: systick_defer_unsubscribe()
+*//**
+* \b Description:
+*
+* 	Removes a function from the deferred subscribers. May be called from a
+* 	deferred subscriber, including for itself.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: callback is no longer called from the bottom half
+*
+*	@param		callback	the subscribed function
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK, or
+*				SYSTICK_DISPATCH_NOT_FOUND if callback was not subscribed
+*
+* \b Example:
+*
+*	@code
+*	systick_defer_unsubscribe(&filter_update);
+*	@endcode
+*
+*	@see	systick_defer_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_defer_unsubscribe(systick_callback_t callback)
+{
+	return (systick_dispatch_table_unsubscribe(&defer_table, callback));
+}
+
+/******************************************************************************
+* Function: systick_defer_dropped()
+*//**
+* \b Description:
+*
+* 	Returns the number of work items lost to a full queue since
+* 	systick_defer_init. A non-zero value means SYSTICK_DEFER_QUEUE_SIZE is too
+* 	small for the bursts posted, or the bottom half is starved.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t items dropped
+*
+* \b Example:
+*
+*	@code
+*	assert(systick_defer_dropped() == 0);
+*	@endcode
+*
+*	@see	systick_defer_post
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_defer_dropped(void)
+{
+	return (atomic_load_explicit(&dropped, memory_order_relaxed));
+}
+
+/******************************************************************************
+* Function: systick_defer_tick()
+*//**
+* \b Description:
+*
+* 	Hands one tick to the bottom half: a counter increment and a pend, the
+* 	whole cost of the deferred subscribers inside the tick ISR. Called from
+* 	systick_irq_handler when SYSTICK_DEFER_ENABLED is set.
+*
+*	PRE-CONDITION: Called from the tick ISR, once per tick
+*
+*	POST-CONDITION: The bottom half runs the deferred subscribers for the tick
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	//called automatically upon SysTick interrupt
+* 	SysTick_IRQHandler(void)
+* 	{
+* 		systick_irq_handler();
+* 	}
+*	@endcode
+*
+*	@see	systick_defer_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_defer_tick(void)
+{
+	atomic_fetch_add_explicit(&pending_ticks, 1UL, memory_order_release);
+	systick_port_defer_pend();
+}
+
+/******************************************************************************
+* Function: systick_defer_next_due()
+*//**
+* \b Description:
+*
+* 	Returns how many ticks from now the next deferred subscriber is due,
+* 	counting the ticks the bottom half has not run yet. Used by
+* 	systick_tickless_idle to bound its sleep.
+*
+*	PRE-CONDITION: Interrupts are masked
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t ticks until the next deferred subscriber call (1 for
+*				the next tick, also when one is already overdue), or
+*				SYSTICK_DISPATCH_NEVER if none is subscribed
+*
+* \b Example:
+*
+*	@code
+*	uint32_t idle_ticks = systick_defer_next_due();
+*	@endcode
+*
+*	@see	systick_defer_skip
+*	@see	systick_dispatch_next_due
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_defer_next_due(void)
+{
+	uint32_t pending = atomic_load_explicit(&pending_ticks, memory_order_acquire);
+	uint32_t next = SYSTICK_DISPATCH_NEVER;
+	uint32_t i;
+
+	for (i = 0; i < defer_table.count; i++)
+	{
+		if (defer_table.rows[i].countdown < next)
+		{
+			next = defer_table.rows[i].countdown;
+		}
+	}
+	if (next == SYSTICK_DISPATCH_NEVER)
+	{
+		return (next);
+	}
+	return ((next > pending) ? (next - pending) : 1UL);
+}
+
+/******************************************************************************
+* Function: systick_defer_skip()
+*//**
+* \b Description:
+*
+* 	Hands several ticks which elapsed without a systick interrupt to the
+* 	bottom half, which runs the deferred subscribers for each of them as it
+* 	does for ticks it fell behind on. The bottom half is not pended; it
+* 	catches up on the next tick.
+*
+*	PRE-CONDITION: Interrupts are masked
+*
+*	POST-CONDITION: The bottom half owes the deferred subscribers ticks more ticks
+*
+*	@param		ticks	number of ticks to hand over
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_defer_skip(slept_ticks);
+*	@endcode
+*
+*	@see	systick_defer_next_due
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_defer_skip(uint32_t ticks)
+{
+	atomic_fetch_add_explicit(&pending_ticks, ticks, memory_order_release);
+}
+
+/******************************************************************************
+* Function: systick_defer_handler()
+*//**
+* \b Description:
+*
+* 	Runs the deferred subscribers once for every tick handed over since the
+* 	last run, then every queued work item. Items posted while it runs are run
+* 	in the same call.
+*
+*	PRE-CONDITION: Called from PendSV_Handler (target) or the backend's bottom
+*					half thread (host), never re-entered
+*
+*	POST-CONDITION: All handed over ticks and published items are processed
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	void PendSV_Handler(void)
+*	{
+*		systick_defer_handler();
+*	}
+*	@endcode
+*
+*	@see	systick_defer_post
+*	@see	systick_defer_tick
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_defer_handler(void)
+{
+	uint32_t ticks = atomic_exchange_explicit(&pending_ticks, 0UL, memory_order_acquire);
+	work_slot_t *slot;
+	systick_defer_work_t work;
+	void *arg;
+
+	while (ticks > 0)
+	{
+		systick_dispatch_table_run(&defer_table);
+		ticks--;
+	}
+
+	for (;;)
+	{
+		slot = &queue[queue_tail & QUEUE_MASK];
+		if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != (queue_tail + 1UL))
+		{
+			break;			/* empty, or the next item is still being written and will pend again */
+		}
+		work = slot->work;
+		arg = slot->arg;
+		atomic_store_explicit(&slot->sequence, queue_tail + SYSTICK_DEFER_QUEUE_SIZE, memory_order_release);
+		queue_tail++;
+		(*work)(arg);
+	}
+}
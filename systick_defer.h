@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Title                 :   Systick Deferred Work
+* Filename              :   systick_defer.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_defer.h
+ *  @brief Bottom half of the tick interrupt. Work is run from the lowest
+ *  		priority exception (PendSV on target, a thread on the Linux host),
+ *  		so every other interrupt preempts it, while the tick ISR itself only
+ *  		counts the tick and pends the bottom half.
+ *
+ *  Two kinds of work are deferred:
+ *  - tick subscribers added with systick_defer_subscribe, run once per tick
+ *    in the bottom half, with the divider and priority rules of
+ *    systick_subscribe. Ticks the bottom half falls behind on are caught up.
+ *  - single work items posted with systick_defer_post from any interrupt or
+ *    thread, through a lock-free multi producer queue of
+ *    SYSTICK_DEFER_QUEUE_SIZE entries.
+ *
+ *  With SYSTICK_DEFER_ENABLED set, the tick path uses the bottom half:
+ *  systick_callback_register subscribes here and software timer callbacks
+ *  are posted here, leaving systick_irq_handler with the tick accounting, the
+ *  timer wheel step and the subscribers still added with systick_subscribe.
+ *
+ *  @code
+ *  void PendSV_Handler(void)
+ *  {
+ *  	systick_defer_handler();
+ *  }
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_DEFER_H
+#define _SYSTICK_DEFER_H
+
+#include "systick_dispatch.h"
+
+/**
+ * Work item body, run in the bottom half
+ */
+typedef void (*systick_defer_work_t) (void *arg);
+
+/**
+ * Result of systick_defer_post
+ */
+typedef enum
+{
+	SYSTICK_DEFER_OK,
+	SYSTICK_DEFER_FULL,				/**<The queue was full, the item was dropped and counted */
+	SYSTICK_DEFER_INVALID			/**<NULL work */
+}systick_defer_status_t;
+
+void systick_defer_init(void);
+systick_defer_status_t systick_defer_post(systick_defer_work_t work, void *arg);
+systick_dispatch_status_t systick_defer_subscribe(systick_callback_t callback, uint32_t divider,
+												  uint8_t priority);
+systick_dispatch_status_t systick_defer_unsubscribe(systick_callback_t callback);
+uint32_t systick_defer_dropped(void);
+void systick_defer_tick(void);
+uint32_t systick_defer_next_due(void);
+void systick_defer_skip(uint32_t ticks);
+void systick_defer_handler(void);
+
+#endif
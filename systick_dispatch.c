@@ -0,0 +1,841 @@
+/*******************************************************************************
+* Title                 :   Systick Tick Dispatch
+* Filename              :   systick_dispatch.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_dispatch.c
+ *  @brief Subscriber tables behind systick_subscribe and the tick sources of
+ *  systick_instance.c. A table is kept sorted by priority when it is modified,
+ *  so the ISR only walks a dense array and does one decrement and one compare
+ *  per subscriber: its cost is linear in the number of subscribers and bounded
+ *  by SYSTICK_DISPATCH_MAX_SUBSCRIBERS.
+ *  A second, small table holds the functions told about tick period changes
+ *  made by systick_reconfigure.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_dispatch.h"
+#include "systick_port.h"
+
+static systick_dispatch_table_t core_table;		/**<Subscribers of the core SysTick */
+static systick_clock_change_callback_t clock_listeners[SYSTICK_CLOCK_CHANGE_MAX_LISTENERS];	/**<Unordered, NULL when free */
+
+/**
+ * Returns the row of table holding callback, or table->count if there is none
+ */
+static uint32_t subscriber_find(const systick_dispatch_table_t *table, systick_callback_t callback)
+{
+	uint32_t i;
+
+	for (i = 0; i < table->count; i++)
+	{
+		if (table->rows[i].callback == callback)
+		{
+			break;
+		}
+	}
+	return (i);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_init()
+*//**
+* \b Description:
+*
+* 	Empties the subscriber table
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: No subscriber is called on the next tick
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_dispatch_init();
+*	@endcode
+*
+*	@see	systick_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_dispatch_init(void)
+{
+	systick_dispatch_table_init(&core_table);
+}
+
+/******************************************************************************
+* Function: systick_subscribe()
+*//**
+* \b Description:
+*
+* 	Adds a function to be called from the systick interrupt every divider ticks.
+* 	Subscribers with a lower priority value run first; equal priorities run in
+* 	the order they subscribed. Subscribing an already subscribed callback
+* 	updates its divider and priority.
+*
+*	PRE-CONDITION: callback is non-NULL and divider is at least 1
+*
+*	POST-CONDITION: callback is called on every divider-th tick from now on
+*
+*	@param		callback	function to call from the systick ISR
+*	@param		divider		call every divider ticks (1 = every tick)
+*	@param		priority	call order, 0 runs first
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK on success
+*
+* \b Example:
+*
+*	@code
+*	systick_subscribe(&led_blink, 500, 10);		//every 500 ticks
+*	systick_subscribe(&watchdog_kick, 1, 0);	//every tick, before led_blink
+*	@endcode
+*
+*	@see	systick_unsubscribe
+*	@see	systick_dispatch_run
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_subscribe(systick_callback_t callback, uint32_t divider,
+											uint8_t priority)
+{
+	return (systick_dispatch_table_subscribe(&core_table, callback, divider, priority));
+}
+
+/******************************************************************************
+* Function: systick_unsubscribe()
+*//**
+* \b Description:
+*
+* 	Removes a function from the subscriber table. May be called from a
+* 	subscriber, including for itself.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: callback is no longer called from the systick ISR
+*
+*	@param		callback	the subscribed function
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK, or
+*				SYSTICK_DISPATCH_NOT_FOUND if callback was not subscribed
+*
+* \b Example:
+*
+*	@code
+*	systick_unsubscribe(&led_blink);
+*	@endcode
+*
+*	@see	systick_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_unsubscribe(systick_callback_t callback)
+{
+	return (systick_dispatch_table_unsubscribe(&core_table, callback));
+}
+
+/******************************************************************************
+* Function: systick_subscriber_count()
+*//**
+* \b Description:
+*
+* 	Returns the number of rows in use in the subscriber table
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t number of subscribers
+*
+* \b Example:
+*
+*	@code
+*	if (systick_subscriber_count() < SYSTICK_DISPATCH_MAX_SUBSCRIBERS)
+*	{
+*		systick_subscribe(&led_blink, 500, 10);
+*	}
+*	@endcode
+*
+*	@see	systick_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_subscriber_count(void)
+{
+	return (core_table.count);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_run()
+*//**
+* \b Description:
+*
+* 	Walks the subscriber table once, calling every subscriber whose divider
+* 	has elapsed. Called from systick_irq_handler after the tick accounting.
+*
+*	PRE-CONDITION: Called from the systick ISR, once per tick
+*
+*	POST-CONDITION: Every due subscriber has been called, in priority order
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	//called automatically upon SysTick interrupt
+* 	SysTick_IRQHandler(void)
+* 	{
+* 		systick_irq_handler();
+* 	}
+*	@endcode
+*
+*	@see	systick_irq_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_dispatch_run(void)
+{
+	systick_dispatch_table_run(&core_table);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_next_due()
+*//**
+* \b Description:
+*
+* 	Returns how many systick interrupts from now the first subscriber is due.
+* 	Used by the tickless idle code to size its sleep.
+*
+*	PRE-CONDITION: Interrupts are masked
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t interrupts until the next subscriber call (1 = the next
+*				one), SYSTICK_DISPATCH_NEVER if the table is empty
+*
+* \b Example:
+*
+*	@code
+*	uint32_t idle_ticks = systick_dispatch_next_due();
+*	@endcode
+*
+*	@see	systick_dispatch_skip
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_dispatch_next_due(void)
+{
+	uint32_t next = SYSTICK_DISPATCH_NEVER;
+	uint32_t i;
+
+	for (i = 0; i < core_table.count; i++)
+	{
+		if (core_table.rows[i].countdown < next)
+		{
+			next = core_table.rows[i].countdown;
+		}
+	}
+	return (next);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_skip()
+*//**
+* \b Description:
+*
+* 	Counts several ticks which elapsed without a systick interrupt against
+* 	every subscriber's divider. No subscriber is called: one that became due
+* 	on the way is left due on the next interrupt instead.
+*
+*	PRE-CONDITION: Interrupts are masked
+*
+*	POST-CONDITION: Subscribers' countdowns have advanced by up to ticks
+*
+*	@param		ticks	number of ticks to count
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_dispatch_skip(slept_ticks);
+*	@endcode
+*
+*	@see	systick_dispatch_next_due
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_dispatch_skip(uint32_t ticks)
+{
+	uint32_t i;
+
+	for (i = 0; i < core_table.count; i++)
+	{
+		if (core_table.rows[i].countdown > ticks)
+		{
+			core_table.rows[i].countdown -= ticks;
+		}
+		else
+		{
+			core_table.rows[i].countdown = 1;
+		}
+	}
+}
+
+/******************************************************************************
+* Function: systick_subscriber_due_get()
+*//**
+* \b Description:
+*
+* 	Returns how many ticks from now a subscriber is next called
+*
+*	PRE-CONDITION: Interrupts are masked, or called from the systick ISR
+*
+*	POST-CONDITION: None
+*
+*	@param		callback	the subscribed function
+*
+*	@return 	uint32_t ticks until its next call (1 = the next tick), 0 if
+*				callback is not subscribed
+*
+* \b Example:
+*
+*	@code
+*	elapsed = armed_for - systick_subscriber_due_get(&control_step);
+*	@endcode
+*
+*	@see	systick_subscriber_due_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_subscriber_due_get(systick_callback_t callback)
+{
+	uint32_t i = subscriber_find(&core_table, callback);
+
+	return ((i < core_table.count) ? core_table.rows[i].countdown : 0UL);
+}
+
+/******************************************************************************
+* Function: systick_subscriber_due_set()
+*//**
+* \b Description:
+*
+* 	Sets how many ticks from now a subscriber is next called, once; its
+* 	divider applies again after that call. A subscriber which knows when it
+* 	next has work, e.g. the scheduler of systick_sched.h, subscribes with
+* 	divider 1 and pushes its next call out to that tick from within its own
+* 	call. It then costs no calls in between, and systick_dispatch_next_due
+* 	lets tickless idle sleep up to it.
+*
+*	PRE-CONDITION: Interrupts are masked, or called from the systick ISR
+*
+*	POST-CONDITION: callback is next called on the ticks-th tick from now
+*
+*	@param		callback	the subscribed function
+*	@param		ticks		ticks until its next call (1 = the next tick)
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK on success,
+*				SYSTICK_DISPATCH_INVALID if ticks is 0, SYSTICK_DISPATCH_NOT_FOUND
+*				if callback is not subscribed
+*
+* \b Example:
+*
+*	@code
+*	static void control_step(void)
+*	{
+*		...
+*		(void)systick_subscriber_due_set(&control_step, next_step_ticks);
+*	}
+*	@endcode
+*
+*	@see	systick_subscriber_due_get
+*	@see	systick_dispatch_next_due
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_subscriber_due_set(systick_callback_t callback, uint32_t ticks)
+{
+	uint32_t i = subscriber_find(&core_table, callback);
+
+	if (ticks == 0)
+	{
+		return (SYSTICK_DISPATCH_INVALID);
+	}
+	if (i >= core_table.count)
+	{
+		return (SYSTICK_DISPATCH_NOT_FOUND);
+	}
+	core_table.rows[i].countdown = ticks;
+	return (SYSTICK_DISPATCH_OK);
+}
+
+/******************************************************************************
+* Function: systick_clock_change_subscribe()
+*//**
+* \b Description:
+*
+* 	Adds a function to be called after systick_reconfigure has switched the
+* 	tick to a new counter clock or rate, e.g. to rescale the divider of a tick
+* 	subscriber which must keep its period in milliseconds. Subscribing an
+* 	already subscribed function has no effect.
+*
+*	PRE-CONDITION: callback is non-NULL
+*
+*	POST-CONDITION: callback is called on every following systick_reconfigure
+*
+*	@param		callback	function to call, from the caller of systick_reconfigure
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK on success,
+*				SYSTICK_DISPATCH_FULL if SYSTICK_CLOCK_CHANGE_MAX_LISTENERS
+*				functions are already subscribed
+*
+* \b Example:
+*
+*	@code
+*	systick_clock_change_subscribe(&uart_timeouts_rescale);
+*	@endcode
+*
+*	@see	systick_clock_change_unsubscribe
+*	@see	systick_reconfigure
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_clock_change_subscribe(systick_clock_change_callback_t callback)
+{
+	systick_dispatch_status_t status = SYSTICK_DISPATCH_FULL;
+	uint32_t state;
+	uint32_t free_slot = SYSTICK_CLOCK_CHANGE_MAX_LISTENERS;
+	uint32_t i;
+
+	if (callback == NULL)
+	{
+		return (SYSTICK_DISPATCH_INVALID);
+	}
+
+	state = systick_port_irq_save();
+	for (i = 0; i < SYSTICK_CLOCK_CHANGE_MAX_LISTENERS; i++)
+	{
+		if (clock_listeners[i] == callback)
+		{
+			free_slot = i;
+			break;
+		}
+		if ((clock_listeners[i] == NULL) && (free_slot == SYSTICK_CLOCK_CHANGE_MAX_LISTENERS))
+		{
+			free_slot = i;
+		}
+	}
+	if (free_slot < SYSTICK_CLOCK_CHANGE_MAX_LISTENERS)
+	{
+		clock_listeners[free_slot] = callback;
+		status = SYSTICK_DISPATCH_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_clock_change_unsubscribe()
+*//**
+* \b Description:
+*
+* 	Removes a function from the clock change table
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: callback is no longer called by systick_reconfigure
+*
+*	@param		callback	the subscribed function
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK, or
+*				SYSTICK_DISPATCH_NOT_FOUND if callback was not subscribed
+*
+* \b Example:
+*
+*	@code
+*	systick_clock_change_unsubscribe(&uart_timeouts_rescale);
+*	@endcode
+*
+*	@see	systick_clock_change_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_clock_change_unsubscribe(systick_clock_change_callback_t callback)
+{
+	systick_dispatch_status_t status = SYSTICK_DISPATCH_NOT_FOUND;
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_CLOCK_CHANGE_MAX_LISTENERS; i++)
+	{
+		if ((callback != NULL) && (clock_listeners[i] == callback))
+		{
+			clock_listeners[i] = NULL;
+			status = SYSTICK_DISPATCH_OK;
+		}
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_clock_change()
+*//**
+* \b Description:
+*
+* 	Calls every function of the clock change table with the old and new tick
+* 	period. Called by systick_reconfigure with interrupts enabled.
+*
+*	PRE-CONDITION: The new tick period is running
+*
+*	POST-CONDITION: Every clock change subscriber has been called once
+*
+*	@param		change	the tick period before and after the change
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_dispatch_clock_change(&change);
+*	@endcode
+*
+*	@see	systick_reconfigure
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_dispatch_clock_change(const systick_clock_change_t *change)
+{
+	systick_clock_change_callback_t callback;
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_CLOCK_CHANGE_MAX_LISTENERS; i++)
+	{
+		callback = clock_listeners[i];
+		if (callback != NULL)
+		{
+			(*callback)(change);
+		}
+	}
+}
+
+/******************************************************************************
+* Function: systick_dispatch_table_init()
+*//**
+* \b Description:
+*
+* 	Empties a subscriber table. systick_dispatch_init does this for the core
+* 	SysTick's table; other tick sources call it on their own table.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: No subscriber of table is called on its next tick
+*
+*	@param		table	the table to empty
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	static systick_dispatch_table_t control_table;
+*	
+*	systick_dispatch_table_init(&control_table);
+*	@endcode
+*
+*	@see	systick_dispatch_table_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_dispatch_table_init(systick_dispatch_table_t *table)
+{
+	uint32_t state = systick_port_irq_save();
+
+	table->count = 0;
+	table->generation++;
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_table_subscribe()
+*//**
+* \b Description:
+*
+* 	Adds a function to a subscriber table, with the ordering and update rules
+* 	of systick_subscribe. systick_subscribe is this function on the core
+* 	SysTick's table.
+*
+*	PRE-CONDITION: callback is non-NULL and divider is at least 1
+*
+*	POST-CONDITION: callback is called on every divider-th run of table from now on
+*
+*	@param		table	the table to add to
+*	@param		callback	function to call when the table runs
+*	@param		divider	call every divider runs (1 = every run)
+*	@param		priority	call order, 0 runs first
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK on success
+*
+* \b Example:
+*
+*	@code
+*	systick_dispatch_table_subscribe(&control_table, &pid_update, 1, 0);
+*	@endcode
+*
+*	@see	systick_dispatch_table_unsubscribe
+*	@see	systick_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_dispatch_table_subscribe(systick_dispatch_table_t *table,
+														   systick_callback_t callback, uint32_t divider,
+														   uint8_t priority)
+{
+	systick_dispatch_status_t status = SYSTICK_DISPATCH_OK;
+	uint32_t state;
+	uint32_t position;
+	uint32_t i;
+
+	if ((callback == NULL) || (divider == 0))
+	{
+		return (SYSTICK_DISPATCH_INVALID);
+	}
+
+	(void)systick_dispatch_table_unsubscribe(table, callback);
+	state = systick_port_irq_save();
+	if (table->count >= SYSTICK_DISPATCH_MAX_SUBSCRIBERS)
+	{
+		status = SYSTICK_DISPATCH_FULL;
+	}
+	else
+	{
+		position = table->count;
+		while ((position > 0) && (table->rows[position - 1U].priority > priority))
+		{
+			position--;
+		}
+		for (i = table->count; i > position; i--)
+		{
+			table->rows[i] = table->rows[i - 1U];
+		}
+		table->rows[position].callback = callback;
+		table->rows[position].divider = divider;
+		table->rows[position].countdown = divider;
+		table->rows[position].priority = priority;
+		table->count++;
+		table->generation++;
+		table->rows[position].generation = table->generation;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_table_unsubscribe()
+*//**
+* \b Description:
+*
+* 	Removes a function from a subscriber table. May be called from a
+* 	subscriber of that table, including for itself.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: callback is no longer called when table runs
+*
+*	@param		table	the table to remove from
+*	@param		callback	the subscribed function
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK, or
+*				SYSTICK_DISPATCH_NOT_FOUND if callback was not subscribed
+*
+* \b Example:
+*
+*	@code
+*	systick_dispatch_table_unsubscribe(&control_table, &pid_update);
+*	@endcode
+*
+*	@see	systick_dispatch_table_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_dispatch_table_unsubscribe(systick_dispatch_table_t *table,
+															 systick_callback_t callback)
+{
+	systick_dispatch_status_t status = SYSTICK_DISPATCH_NOT_FOUND;
+	uint32_t state = systick_port_irq_save();
+	uint32_t i = subscriber_find(table, callback);
+
+	if (i < table->count)
+	{
+		for (; (i + 1U) < table->count; i++)
+		{
+			table->rows[i] = table->rows[i + 1U];
+		}
+		table->count--;
+		table->generation++;
+		status = SYSTICK_DISPATCH_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_dispatch_table_run()
+*//**
+* \b Description:
+*
+* 	Walks a subscriber table once, calling every subscriber whose divider has
+* 	elapsed. Called once per tick from the interrupt of the tick source that
+* 	owns the table. Rows added while the walk runs, e.g. by a subscriber, are
+* 	left alone until the next tick, so they are first called divider ticks
+* 	after they were added like any other.
+*
+*	PRE-CONDITION: Called from the ISR of the table's tick source, once per tick
+*
+*	POST-CONDITION: Every due subscriber has been called, in priority order
+*
+*	@param		table	the table to run
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	void TIM5_IRQHandler(void)
+*	{
+*		systick_dispatch_table_run(&control_table);
+*	}
+*	@endcode
+*
+*	@see	systick_dispatch_run
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_dispatch_table_run(systick_dispatch_table_t *table)
+{
+	uint32_t walk_generation = table->generation;
+	uint32_t i = 0;
+	uint32_t row;
+	uint32_t generation;
+	systick_callback_t callback;
+
+	while (i < table->count)
+	{
+		if ((int32_t)(table->rows[i].generation - walk_generation) > 0)
+		{
+			i++;			/* added during this walk, counted from the next tick */
+			continue;
+		}
+		if (--table->rows[i].countdown == 0)
+		{
+			table->rows[i].countdown = table->rows[i].divider;
+			callback = table->rows[i].callback;
+			generation = table->generation;
+			(*callback)();
+			if (generation != table->generation)
+			{
+				/* the subscriber changed the table: resume after its new row, or in
+				 * its place if it unsubscribed itself */
+				row = subscriber_find(table, callback);
+				if (row < table->count)
+				{
+					i = row + 1U;
+				}
+				continue;
+			}
+		}
+		i++;
+	}
+}
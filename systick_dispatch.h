@@ -0,0 +1,120 @@
+/*******************************************************************************
+* Title                 :   Systick Tick Dispatch
+* Filename              :   systick_dispatch.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_dispatch.h
+ *  @brief Table of tick subscribers called from systick_irq_handler. Each
+ *  		subscriber runs every divider ticks; subscribers run in priority
+ *  		order, lowest value first. Tick accounting is not a subscriber and
+ *  		always runs before the table.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_DISPATCH_H
+#define _SYSTICK_DISPATCH_H
+
+#include "systick_interface.h"
+
+/**
+ * Returned by systick_dispatch_next_due when no subscriber is registered
+ */
+#define SYSTICK_DISPATCH_NEVER		(0xFFFFFFFFUL)
+
+/**
+ * Result of a change to the subscriber table
+ */
+typedef enum
+{
+	SYSTICK_DISPATCH_OK,
+	SYSTICK_DISPATCH_FULL,			/**<All SYSTICK_DISPATCH_MAX_SUBSCRIBERS slots are in use */
+	SYSTICK_DISPATCH_INVALID,		/**<NULL callback or zero divider */
+	SYSTICK_DISPATCH_NOT_FOUND		/**<The callback is not subscribed */
+}systick_dispatch_status_t;
+
+/**
+ * One row of a subscriber table
+ */
+typedef struct
+{
+	systick_callback_t callback;	/**<Function to call */
+	uint32_t countdown;				/**<Ticks left until the next call */
+	uint32_t divider;				/**<Ticks between calls */
+	uint32_t generation;			/**<Table generation the row was added in */
+	uint8_t priority;				/**<Position key, lower runs first */
+}systick_subscriber_t;
+
+/**
+ * Subscriber table of one tick source. systick_subscribe and friends work on
+ * the core SysTick's table; every other tick source (systick_instance.h) owns
+ * one of its own.
+ */
+typedef struct
+{
+	systick_subscriber_t rows[SYSTICK_DISPATCH_MAX_SUBSCRIBERS];	/**<Sorted by priority */
+	volatile uint32_t count;										/**<Rows in use */
+	volatile uint32_t generation;									/**<Bumped on every table change */
+}systick_dispatch_table_t;
+
+/**
+ * Tick period before and after a call to systick_reconfigure
+ */
+typedef struct
+{
+	uint32_t old_counter_hz;		/**<Counter clock before the change */
+	uint32_t old_reload;			/**<Counter clocks per tick minus one before the change */
+	uint32_t new_counter_hz;		/**<Counter clock after the change */
+	uint32_t new_reload;			/**<Counter clocks per tick minus one after the change */
+}systick_clock_change_t;
+
+/**
+ * Function called by systick_reconfigure once the new tick period is running
+ */
+typedef void (*systick_clock_change_callback_t) (const systick_clock_change_t *change);
+
+void systick_dispatch_init(void);
+systick_dispatch_status_t systick_subscribe(systick_callback_t callback, uint32_t divider,
+											uint8_t priority);
+systick_dispatch_status_t systick_unsubscribe(systick_callback_t callback);
+uint32_t systick_subscriber_count(void);
+void systick_dispatch_run(void);
+uint32_t systick_dispatch_next_due(void);
+void systick_dispatch_skip(uint32_t ticks);
+uint32_t systick_subscriber_due_get(systick_callback_t callback);
+systick_dispatch_status_t systick_subscriber_due_set(systick_callback_t callback, uint32_t ticks);
+systick_dispatch_status_t systick_clock_change_subscribe(systick_clock_change_callback_t callback);
+systick_dispatch_status_t systick_clock_change_unsubscribe(systick_clock_change_callback_t callback);
+void systick_dispatch_clock_change(const systick_clock_change_t *change);
+void systick_dispatch_table_init(systick_dispatch_table_t *table);
+systick_dispatch_status_t systick_dispatch_table_subscribe(systick_dispatch_table_t *table,
+														   systick_callback_t callback, uint32_t divider,
+														   uint8_t priority);
+systick_dispatch_status_t systick_dispatch_table_unsubscribe(systick_dispatch_table_t *table,
+															 systick_callback_t callback);
+void systick_dispatch_table_run(systick_dispatch_table_t *table);
+
+#endif
@@ -0,0 +1,481 @@
+/*******************************************************************************
+* Title                 :   Systick Instances
+* Filename              :   systick_instance.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_instance.c
+ *  @brief Tick sources behind the handles of systick_instance.h. A source
+ *  other than SYSTICK_1 runs its own subscriber table and accounts time in
+ *  its ISR with the same helpers as systick.c (systick_ms.h), from the
+ *  period the timer actually runs at after the rounding of its reload. A
+ *  source need not tick at a whole number of milliseconds, and its
+ *  milliseconds do not drift from its clock.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include "systick_instance.h"
+#include "systick_port.h"
+#include "systick_ms.h"
+
+#ifndef NULL
+#define NULL (void *) 0
+#endif
+
+static systick_instance_t instances[NUM_SYSTICKS];	/**<Indexed by systick_t */
+
+/******************************************************************************
+* Function: systick_instance_init()
+*//**
+* \b Description:
+*
+* 	Starts a tick source at the rate of its configuration and returns the
+* 	handle to it. For SYSTICK_1 this is systick_init; the other sources are
+* 	started through the backend, always with their interrupt enabled since
+* 	it is what advances their tick. Their clock_source field is ignored.
+* 	Their tick starts at 0; SYSTICK_1's carries on from where it was, as it
+* 	does across any systick_init, since the core tick is shared with the
+* 	rest of the driver.
+*
+*	PRE-CONDITION: The clock system (RCC) has been initialised.
+*	PRE-CONDITION: The backend's ISR for source calls systick_instance_irq_handler
+*					(SYSTICK_1: systick_irq_handler)
+*
+*	POST-CONDITION: The source ticks at config->tick_freq_hz
+*	POST-CONDITION: Its tick is 0, unless source is SYSTICK_1
+*
+*	@param 		source	the tick source to start
+*	@param 		config	its configuration, typically &systick_config_get()[source]
+*
+*	@return 	systick_handle_t the source's handle, or NULL if source does not
+*				exist, config disables it, or the backend cannot run it at that rate
+*
+* \b Example:
+*
+*	@code
+*	systick_handle_t control = systick_instance_init(SYSTICK_2, &systick_config_get()[SYSTICK_2]);
+*
+*	if (control == NULL)
+*	{
+*		error_handler();
+*	}
+*	@endcode
+*
+*	@see	systick_instance_deinit
+*	@see	systick_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_handle_t systick_instance_init(systick_t source, const systick_config_t *config)
+{
+	systick_instance_t *instance;
+	systick_config_t core_config;
+	uint64_t period_ns;
+
+	if ((source >= NUM_SYSTICKS) || (config == NULL) || (config->enable_systick != SYSTICK_ENABLED)
+		|| (config->tick_freq_hz == 0))
+	{
+		return (NULL);
+	}
+
+	instance = &instances[source];
+	if (instance->running != 0)
+	{
+		systick_instance_deinit(instance);
+	}
+	instance->source = source;
+	instance->tick_freq_hz = config->tick_freq_hz;
+	instance->tick_ns_err = 0;
+	instance->tick_sub_ns = 0;
+	instance->ms = 0;
+	instance->ms_hi = 0;
+	systick_dispatch_table_init(&instance->subscribers);
+
+	if (source == SYSTICK_1)
+	{
+		core_config = *config;
+		systick_init(&core_config);
+	}
+	else if (systick_port_source_start(source, config->tick_freq_hz) == 0)
+	{
+		return (NULL);
+	}
+	else
+	{
+		period_ns = (uint64_t)systick_port_source_period_get(source, &instance->counter_hz) * 1000000000ULL;
+		instance->tick_ns = (uint32_t)(period_ns / instance->counter_hz);
+		instance->tick_ns_frac = (uint32_t)(period_ns % instance->counter_hz);
+	}
+	instance->running = 1;
+	return (instance);
+}
+
+/******************************************************************************
+* Function: systick_instance_deinit()
+*//**
+* \b Description:
+*
+* 	Stops a tick source and drops its subscribers. Its handle is invalid
+* 	afterwards. For SYSTICK_1 the counter is paused with its interrupt masked;
+* 	subscribers of the core table are left to their owners.
+*
+*	PRE-CONDITION: handle was returned by systick_instance_init
+*
+*	POST-CONDITION: The source no longer ticks
+*
+*	@param 		handle	the source to stop
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_instance_deinit(control);
+*	enter_stop_mode();
+*	@endcode
+*
+*	@see	systick_instance_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_instance_deinit(systick_handle_t handle)
+{
+	if ((handle == NULL) || (handle->running == 0))
+	{
+		return;
+	}
+	if (handle->source == SYSTICK_1)
+	{
+		systick_pause();							/* the interrupt can only be masked while paused */
+		systick_interrupt_control(SYSTICK_INT_DISABLED);
+	}
+	else
+	{
+		systick_port_source_stop(handle->source);
+	}
+	handle->running = 0;
+	systick_dispatch_table_init(&handle->subscribers);
+}
+
+/******************************************************************************
+* Function: systick_instance_get()
+*//**
+* \b Description:
+*
+* 	Returns the handle of a running tick source, for modules which did not
+* 	start it themselves
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@param 		source	the tick source
+*
+*	@return 	systick_handle_t its handle, or NULL if it is not running
+*
+* \b Example:
+*
+*	@code
+*	systick_handle_t control = systick_instance_get(SYSTICK_2);
+*	@endcode
+*
+*	@see	systick_instance_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_handle_t systick_instance_get(systick_t source)
+{
+	if ((source >= NUM_SYSTICKS) || (instances[source].running == 0))
+	{
+		return (NULL);
+	}
+	return (&instances[source]);
+}
+
+/******************************************************************************
+* Function: systick_instance_freq_get()
+*//**
+* \b Description:
+*
+* 	Returns the tick rate a source was started at
+*
+*	PRE-CONDITION: handle was returned by systick_instance_init
+*
+*	POST-CONDITION: None
+*
+*	@param 		handle	the tick source
+*
+*	@return 	uint32_t tick interrupts per second
+*
+* \b Example:
+*
+*	@code
+*	float dt = 1.0f / (float)systick_instance_freq_get(control);
+*	@endcode
+*
+*	@see	systick_instance_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_instance_freq_get(systick_handle_t handle)
+{
+	return (handle->tick_freq_hz);
+}
+
+/******************************************************************************
+* Function: systick_instance_get_tick()
+*//**
+* \b Description:
+*
+* 	Returns the milliseconds a source has been ticking, modulo 2^32, in whole
+* 	ticks of that source: a 10 Hz source reads 0, 100, 200, ...
+*
+*	PRE-CONDITION: handle was returned by systick_instance_init
+*
+*	POST-CONDITION: None
+*
+*	@param 		handle	the tick source
+*
+*	@return 	uint32_t milliseconds since the source started
+*
+* \b Example:
+*
+*	@code
+*	uint32_t start = systick_instance_get_tick(housekeeping);
+*	@endcode
+*
+*	@see	systick_instance_get_tick64
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_instance_get_tick(systick_handle_t handle)
+{
+	return ((uint32_t)systick_instance_get_tick64(handle));
+}
+
+/******************************************************************************
+* Function: systick_instance_get_tick64()
+*//**
+* \b Description:
+*
+* 	Returns the milliseconds a source has been ticking as a 64 bit value which
+* 	does not wrap. Same as systick_get_tick64 for SYSTICK_1, whose count runs
+* 	from the first systick_init rather than from systick_instance_init.
+*
+*	PRE-CONDITION: handle was returned by systick_instance_init
+*
+*	POST-CONDITION: None
+*
+*	@param 		handle	the tick source
+*
+*	@return 	uint64_t milliseconds since the source started
+*
+* \b Example:
+*
+*	@code
+*	uint64_t uptime_ms = systick_instance_get_tick64(housekeeping);
+*	@endcode
+*
+*	@see	systick_instance_get_tick
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint64_t systick_instance_get_tick64(systick_handle_t handle)
+{
+	if (handle->source == SYSTICK_1)
+	{
+		return (systick_get_tick64());
+	}
+	return (systick_ms_read64(&handle->ms, &handle->ms_hi));
+}
+
+/******************************************************************************
+* Function: systick_instance_subscribe()
+*//**
+* \b Description:
+*
+* 	Adds a function to be called from a source's interrupt every divider ticks
+* 	of that source, with the ordering rules of systick_subscribe. For SYSTICK_1
+* 	this is systick_subscribe.
+*
+*	PRE-CONDITION: handle was returned by systick_instance_init
+*	PRE-CONDITION: callback is non-NULL and divider is at least 1
+*
+*	POST-CONDITION: callback is called on every divider-th tick of the source
+*
+*	@param		handle		the tick source
+*	@param		callback	function to call from the source's ISR
+*	@param		divider		call every divider ticks (1 = every tick)
+*	@param		priority	call order, 0 runs first
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK on success
+*
+* \b Example:
+*
+*	@code
+*	systick_instance_subscribe(control, &current_loop, 1, 0);
+*	systick_instance_subscribe(control, &speed_loop, 10, 1);
+*	@endcode
+*
+*	@see	systick_instance_unsubscribe
+*	@see	systick_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_instance_subscribe(systick_handle_t handle, systick_callback_t callback,
+													 uint32_t divider, uint8_t priority)
+{
+	if (handle->source == SYSTICK_1)
+	{
+		return (systick_subscribe(callback, divider, priority));
+	}
+	return (systick_dispatch_table_subscribe(&handle->subscribers, callback, divider, priority));
+}
+
+/******************************************************************************
+* Function: systick_instance_unsubscribe()
+*//**
+* \b Description:
+*
+* 	Removes a function from a source's subscribers. May be called from a
+* 	subscriber, including for itself.
+*
+*	PRE-CONDITION: handle was returned by systick_instance_init
+*
+*	POST-CONDITION: callback is no longer called on the source's ticks
+*
+*	@param		handle		the tick source
+*	@param		callback	the subscribed function
+*
+*	@return 	systick_dispatch_status_t SYSTICK_DISPATCH_OK, or
+*				SYSTICK_DISPATCH_NOT_FOUND if callback was not subscribed
+*
+* \b Example:
+*
+*	@code
+*	systick_instance_unsubscribe(control, &speed_loop);
+*	@endcode
+*
+*	@see	systick_instance_subscribe
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_instance_unsubscribe(systick_handle_t handle, systick_callback_t callback)
+{
+	if (handle->source == SYSTICK_1)
+	{
+		return (systick_unsubscribe(callback));
+	}
+	return (systick_dispatch_table_unsubscribe(&handle->subscribers, callback));
+}
+
+/******************************************************************************
+* Function: systick_instance_irq_handler()
+*//**
+* \b Description:
+*
+* 	Tick interrupt of a source other than SYSTICK_1: acknowledges the timer,
+* 	counts the tick and runs the source's subscribers. A tick arriving while
+* 	the source is stopped is acknowledged and otherwise ignored.
+*
+*	PRE-CONDITION: Called from the interrupt of source's timer
+*
+*	POST-CONDITION: the tick has been counted and the due subscribers called
+*
+*	@param		source	the tick source whose interrupt fired
+*
+*	@return		void
+*
+* \b Example:
+*
+*	@code
+*	void TIM5_IRQHandler(void)
+*	{
+*		systick_instance_irq_handler(SYSTICK_2);
+*	}
+*	@endcode
+*
+*	@see	systick_irq_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_instance_irq_handler(systick_t source)
+{
+	systick_instance_t *instance;
+	uint32_t carry;
+
+	if ((source == SYSTICK_1) || (source >= NUM_SYSTICKS))
+	{
+		return;
+	}
+	systick_port_source_ack(source);
+	instance = &instances[source];
+	if (instance->running == 0)
+	{
+		return;
+	}
+
+	carry = systick_ms_step(&instance->tick_sub_ns, &instance->tick_ns_err, instance->tick_ns,
+							instance->tick_ns_frac, instance->counter_hz);
+	systick_ms_add(&instance->ms, &instance->ms_hi, carry);
+	systick_dispatch_table_run(&instance->subscribers);
+}
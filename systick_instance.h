@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Title                 :   Systick Instances
+* Filename              :   systick_instance.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_instance.h
+ *  @brief Handle based access to every tick source listed in systick_t, each
+ *  		with its own rate, tick and subscribers. SYSTICK_1 is the core
+ *  		SysTick run by systick.c, so its handle forwards to the plain
+ *  		systick_ API; the other sources are timers driven through the
+ *  		systick_port_source_ functions of the backend.
+ *
+ *  @code
+ *  systick_config_t slow = {SYSTICK_ENABLED, 10, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+ *  systick_handle_t housekeeping = systick_instance_init(SYSTICK_2, &slow);
+ *
+ *  systick_instance_subscribe(housekeeping, &battery_check, 50, 0);	//every 5 s
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_INSTANCE_H
+#define _SYSTICK_INSTANCE_H
+
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+
+/**
+ * State of one tick source
+ */
+typedef struct
+{
+	systick_t source;						/**<Tick source this state belongs to */
+	uint32_t tick_freq_hz;					/**<Tick interrupts per second */
+	uint32_t counter_hz;					/**<Clock the timer counts its period in, the denominator of tick_ns_frac */
+	uint32_t tick_ns;						/**<Whole nanoseconds per tick */
+	uint32_t tick_ns_frac;					/**<Remaining nanoseconds per tick, in 1/counter_hz ns */
+	uint32_t tick_ns_err;					/**<Accumulated tick_ns_frac, below counter_hz */
+	uint32_t tick_sub_ns;					/**<Nanoseconds past ms, below one ms */
+	volatile uint32_t ms;					/**<Milliseconds since the source started, low word */
+	volatile uint32_t ms_hi;				/**<Milliseconds since the source started, high word */
+	uint32_t running;						/**<Non-zero between init and deinit */
+	systick_dispatch_table_t subscribers;	/**<Called on its ticks, unused for SYSTICK_1 */
+}systick_instance_t;
+
+/**
+ * Handle to a running tick source, as returned by systick_instance_init
+ */
+typedef systick_instance_t *systick_handle_t;
+
+systick_handle_t systick_instance_init(systick_t source, const systick_config_t *config);
+void systick_instance_deinit(systick_handle_t handle);
+systick_handle_t systick_instance_get(systick_t source);
+uint32_t systick_instance_freq_get(systick_handle_t handle);
+uint32_t systick_instance_get_tick(systick_handle_t handle);
+uint64_t systick_instance_get_tick64(systick_handle_t handle);
+systick_dispatch_status_t systick_instance_subscribe(systick_handle_t handle, systick_callback_t callback,
+													 uint32_t divider, uint8_t priority);
+systick_dispatch_status_t systick_instance_unsubscribe(systick_handle_t handle, systick_callback_t callback);
+void systick_instance_irq_handler(systick_t source);
+
+#endif
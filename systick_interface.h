@@ -44,16 +44,44 @@
  */
 typedef void (*systick_callback_t) (void);
 
+/**
+ * Millisecond tick maintained by the systick ISR. Read it through
+ * systick_get_tick, or directly from inline code where a call is too costly;
+ * never write it.
+ */
+extern volatile uint32_t systick_tick_ms;
+
+/**
+ * Milliseconds systick_tick_ms may lag true time at the current tick rate.
+ * Added to timeouts measured in ticks, so that they never end early; never
+ * write it.
+ */
+extern uint32_t systick_slack_ms;
+
 void systick_init(systick_config_t *config);
+void systick_init_reload(uint32_t reload, uint32_t clock_hz, systick_clock_source_t clock_source,
+						 systick_interrupt_t interrupt_control);
 void systick_tick_freq_set(systick_config_t *config);
+void systick_reconfigure(systick_config_t *config);
 void systick_interrupt_control(systick_interrupt_t interrupt_control);
 void systick_pause(void);
 void systick_resume(void);
 
 uint32_t systick_get_tick(void);
+uint64_t systick_get_tick64(void);
+uint32_t systick_get_cycles(void);
+uint32_t systick_get_time_us(void);
 void systick_delay(uint32_t delay_ms);
+uint32_t systick_delay_cycles(uint32_t cycles);
+uint32_t systick_delay_us(uint32_t delay_us);
+uint32_t systick_delay_sleep(uint32_t delay_ms);
 
 void systick_increment(void);
+void systick_tick_advance(uint32_t num_ticks);
+uint32_t systick_tick_reload_get(void);
+uint32_t systick_counter_hz_get(void);
+void systick_trim_set(int32_t error_ppb);
+int32_t systick_trim_get(void);
 void systick_callback_register(systick_callback_t callback_func);
 void systick_irq_handler(void);
 
@@ -0,0 +1,221 @@
+/*******************************************************************************
+* Title                 :   Systick ISR Statistics
+* Filename              :   systick_isr_stats.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_isr_stats.c
+ *  @brief Accumulators behind systick_isr_stats_get. The ISR side only does
+ *  compares, two additions and one histogram increment per tick; means are
+ *  divided out when the statistics are read.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include "systick_isr_stats.h"
+#include "systick_port.h"
+
+#if SYSTICK_ISR_STATS_ENABLED
+
+static uint32_t samples = 0;				/**<Ticks recorded */
+static uint32_t latency_min = 0xFFFFFFFFUL;	/**<Smallest latency seen */
+static uint32_t latency_max = 0;			/**<Largest latency seen */
+static uint64_t latency_sum = 0;			/**<Sum of the latencies, for the mean */
+static uint32_t exec_min = 0xFFFFFFFFUL;	/**<Smallest execution time seen */
+static uint32_t exec_max = 0;				/**<Largest execution time seen */
+static uint64_t exec_sum = 0;				/**<Sum of the execution times, for the mean */
+static uint32_t histogram[SYSTICK_ISR_STATS_BUCKETS];	/**<Latency histogram */
+
+/******************************************************************************
+* Function: systick_isr_stats_record()
+*//**
+* \b Description:
+*
+* 	Adds one tick to the statistics. Called at the end of systick_irq_handler.
+*
+*	PRE-CONDITION: Called from the systick ISR
+*
+*	POST-CONDITION: The sample is included in the minimum, maximum, mean and
+*					histogram
+*
+*	@param		latency		counter clocks from the reload to handler entry
+*	@param		exec		counter clocks spent in the handler
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_isr_stats_record(latency, exec);
+*	@endcode
+*
+*	@see	systick_isr_stats_get
+*	@see	systick_irq_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_isr_stats_record(uint32_t latency, uint32_t exec)
+{
+	uint32_t bucket = latency / SYSTICK_ISR_STATS_BUCKET_CLOCKS;
+
+	if (bucket >= SYSTICK_ISR_STATS_BUCKETS)
+	{
+		bucket = SYSTICK_ISR_STATS_BUCKETS - 1U;
+	}
+	histogram[bucket]++;
+	if (latency < latency_min)
+	{
+		latency_min = latency;
+	}
+	if (latency > latency_max)
+	{
+		latency_max = latency;
+	}
+	if (exec < exec_min)
+	{
+		exec_min = exec;
+	}
+	if (exec > exec_max)
+	{
+		exec_max = exec;
+	}
+	latency_sum += latency;
+	exec_sum += exec;
+	samples++;
+}
+
+/******************************************************************************
+* Function: systick_isr_stats_get()
+*//**
+* \b Description:
+*
+* 	Copies out a consistent set of statistics. Minimum and mean read 0 while
+* 	no tick has been recorded.
+*
+*	PRE-CONDITION: stats is non-NULL
+*
+*	POST-CONDITION: stats holds the statistics since the last reset
+*
+*	@param		stats	where to copy the statistics
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_isr_stats_t stats;
+*	systick_isr_stats_get(&stats);
+*	printf("tick latency %lu..%lu clocks\n", stats.latency_min, stats.latency_max);
+*	@endcode
+*
+*	@see	systick_isr_stats_reset
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_isr_stats_get(systick_isr_stats_t *stats)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	stats->samples = samples;
+	stats->latency_max = latency_max;
+	stats->exec_max = exec_max;
+	if (samples != 0)
+	{
+		stats->latency_min = latency_min;
+		stats->latency_mean = (uint32_t)(latency_sum / samples);
+		stats->exec_min = exec_min;
+		stats->exec_mean = (uint32_t)(exec_sum / samples);
+	}
+	else
+	{
+		stats->latency_min = 0;
+		stats->latency_mean = 0;
+		stats->exec_min = 0;
+		stats->exec_mean = 0;
+	}
+	for (i = 0; i < SYSTICK_ISR_STATS_BUCKETS; i++)
+	{
+		stats->latency_histogram[i] = histogram[i];
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_isr_stats_reset()
+*//**
+* \b Description:
+*
+* 	Clears the statistics, e.g. after start-up so that its long critical
+* 	sections do not dominate the maxima
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: No tick is recorded
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_isr_stats_reset();
+*	@endcode
+*
+*	@see	systick_isr_stats_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_isr_stats_reset(void)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	samples = 0;
+	latency_min = 0xFFFFFFFFUL;
+	latency_max = 0;
+	latency_sum = 0;
+	exec_min = 0xFFFFFFFFUL;
+	exec_max = 0;
+	exec_sum = 0;
+	for (i = 0; i < SYSTICK_ISR_STATS_BUCKETS; i++)
+	{
+		histogram[i] = 0;
+	}
+	systick_port_irq_restore(state);
+}
+
+#endif
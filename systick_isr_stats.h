@@ -0,0 +1,74 @@
+/*******************************************************************************
+* Title                 :   Systick ISR Statistics
+* Filename              :   systick_isr_stats.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_isr_stats.h
+ *  @brief Latency and execution time statistics of systick_irq_handler,
+ *  		collected when SYSTICK_ISR_STATS_ENABLED is set. The latency of a
+ *  		tick is the number of counter clocks between the counter reload and
+ *  		the first instruction of the handler, read back from the counter at
+ *  		entry; the execution time is the handler's own run time, including
+ *  		every timer and subscriber callback it calls.
+ *
+ *  A tick taken right after systick_tickless_idle or systick_reconfigure has
+ *  restarted the counter is measured against the shortened period and reads
+ *  long; reset the statistics after such phases when only steady state
+ *  latency matters.
+ *
+ *  With SYSTICK_ISR_STATS_ENABLED at 0 neither the sampling in the ISR nor the
+ *  statistics table is compiled.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_ISR_STATS_H
+#define _SYSTICK_ISR_STATS_H
+
+#include "systick_stm32f411_config.h"
+
+/**
+ * Copy of the statistics, all in counter clocks
+ */
+typedef struct
+{
+	uint32_t samples;			/**<Number of ticks sampled */
+	uint32_t latency_min;		/**<Shortest reload to handler entry delay */
+	uint32_t latency_max;		/**<Longest reload to handler entry delay */
+	uint32_t latency_mean;		/**<Mean reload to handler entry delay */
+	uint32_t exec_min;			/**<Shortest handler run time */
+	uint32_t exec_max;			/**<Longest handler run time */
+	uint32_t exec_mean;			/**<Mean handler run time */
+	uint32_t latency_histogram[SYSTICK_ISR_STATS_BUCKETS];	/**<Ticks per latency bucket of
+								SYSTICK_ISR_STATS_BUCKET_CLOCKS clocks, the last bucket
+								also counting every longer latency */
+}systick_isr_stats_t;
+
+void systick_isr_stats_record(uint32_t latency, uint32_t exec);
+void systick_isr_stats_get(systick_isr_stats_t *stats);
+void systick_isr_stats_reset(void);
+
+#endif
@@ -0,0 +1,1532 @@
+/*******************************************************************************
+* Title                 :   Systick Linux Host Implementation
+* Filename              :   systick_linux.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Linux (POSIX threads)
+* Notes                 :   Link with -pthread
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_linux.c
+ *  @brief Host backend of systick control. Implements systick_port.h with a
+ *  POSIX thread which sleeps on absolute CLOCK_MONOTONIC deadlines and calls
+ *  systick_irq_handler() once per tick period, standing in for the SysTick
+ *  interrupt.
+ *
+ *  The tick period is derived exactly as on target, from the reload value and
+ *  SystemCoreClock, so the timing logic above the port runs unmodified. As on
+ *  hardware, ticks that are missed because the host was too busy are dropped
+ *  rather than replayed.
+ *
+ *  The emulated counter keeps the SysTick register semantics the tickless idle
+ *  code relies on: a write to LOAD alone takes effect at the next reload, an
+ *  underflow raises a pending flag before the handler runs, and a handler
+ *  held off by systick_port_irq_save can be withdrawn by clearing that flag.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "systick_interface.h"
+#include "systick_port.h"
+#include "systick_instance.h"
+#if SYSTICK_DEFER_ENABLED
+#include "systick_defer.h"
+#endif
+
+/**
+ * Number of nanoseconds in a second
+ */
+#define NSEC_PER_SEC	(1000000000ULL)
+
+/**
+ * Virtual core clock of the host backend. Only used to turn reload values into
+ * tick periods, so any value keeping the reload inside 24 bits will do.
+ */
+uint32_t SystemCoreClock = 100000000UL;
+
+static pthread_t tick_thread;								/**<Thread acting as the tick interrupt */
+static pthread_once_t port_once = PTHREAD_ONCE_INIT;		/**<Guards port_setup */
+static pthread_mutex_t port_lock = PTHREAD_MUTEX_INITIALIZER;	/**<Guards the emulated registers */
+static pthread_cond_t port_cond;							/**<Signalled on register changes and ticks */
+static uint32_t thread_started = 0;						/**<Non-zero once tick_thread exists */
+
+static uint32_t reload_value = 0;							/**<Emulated LOAD register */
+static uint32_t period_reload = 0;							/**<LOAD value the current period started from */
+static uint32_t counter_running = 0;						/**<Emulated CTRL.ENABLE */
+static uint32_t interrupt_enabled = 0;					/**<Emulated CTRL.TICKINT */
+static uint32_t tick_raised = 0;							/**<Emulated ICSR.PENDSTSET */
+static uint32_t tick_sequence = 0;							/**<Bumped on every underflow */
+static uint32_t config_generation = 0;					/**<Bumped on every register change */
+static uint64_t period_start = 0;							/**<CLOCK_MONOTONIC ns at which the count was period_reload */
+static uint32_t frozen_val = 0;							/**<Counter value while stopped */
+
+#if SYSTICK_DEFER_ENABLED
+static pthread_t defer_thread;								/**<Thread acting as PendSV */
+static uint32_t defer_started = 0;							/**<Non-zero once defer_thread exists */
+#endif
+static uint32_t defer_raised = 0;							/**<Emulated ICSR.PENDSVSET */
+
+static uint64_t source_period_ns[NUM_SYSTICKS];			/**<Tick period of each extra tick source */
+static uint32_t source_generation[NUM_SYSTICKS];			/**<Bumped on every start and stop of a source */
+
+/**
+ * Held by the tick thread while it runs the handler and by callers of
+ * systick_port_irq_save, standing in for PRIMASK. Recursive so masked
+ * sections nest and the handler may mask too.
+ */
+static pthread_mutex_t isr_lock;
+
+#if SYSTICK_DEFER_ENABLED
+/**
+ * Held by the defer thread while it runs systick_defer_handler and by
+ * thread-mode callers of systick_port_irq_save, standing in for PendSV being
+ * held off by a masked section. The threads standing in for interrupts do
+ * not take it, as on target they preempt PendSV. Recursive like isr_lock,
+ * and always taken before it.
+ */
+static pthread_mutex_t defer_lock;
+
+/**
+ * Non-zero on the threads standing in for interrupts above PendSV
+ */
+static _Thread_local uint32_t in_interrupt = 0;
+#endif
+
+/**
+ * One-time creation of the objects which need attributes: the condition
+ * variable waits on CLOCK_MONOTONIC deadlines and the interrupt locks are
+ * recursive
+ */
+static void port_setup(void)
+{
+	pthread_condattr_t cond_attr;
+	pthread_mutexattr_t mutex_attr;
+
+	pthread_condattr_init(&cond_attr);
+	pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&port_cond, &cond_attr);
+	pthread_condattr_destroy(&cond_attr);
+	pthread_mutexattr_init(&mutex_attr);
+	pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&isr_lock, &mutex_attr);
+#if SYSTICK_DEFER_ENABLED
+	pthread_mutex_init(&defer_lock, &mutex_attr);
+#endif
+	pthread_mutexattr_destroy(&mutex_attr);
+}
+
+/**
+ * Takes port_lock, setting the port up on first use
+ */
+static void port_lock_take(void)
+{
+	pthread_once(&port_once, port_setup);
+	pthread_mutex_lock(&port_lock);
+}
+
+/**
+ * Current CLOCK_MONOTONIC time in nanoseconds
+ */
+static uint64_t monotonic_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (((uint64_t)now.tv_sec * NSEC_PER_SEC) + (uint64_t)now.tv_nsec);
+}
+
+/**
+ * Duration of a number of counter clocks in nanoseconds
+ */
+static uint64_t cycles_to_ns(uint64_t cycles)
+{
+	return ((cycles * NSEC_PER_SEC) / SystemCoreClock);
+}
+
+/**
+ * Emulated counter value at the current instant. port_lock must be held.
+ * Holds at 1, the last count before the tick edge, while the tick thread is
+ * late: 0 would read as a tick already accounted and step time back a period.
+ */
+static uint32_t counter_now(void)
+{
+	uint64_t now = monotonic_ns();
+	uint64_t elapsed_cycles;
+
+	if (counter_running == 0)
+	{
+		return (frozen_val);
+	}
+	if (now < period_start)
+	{
+		return (period_reload);
+	}
+	elapsed_cycles = ((now - period_start) * SystemCoreClock) / NSEC_PER_SEC;
+	return ((elapsed_cycles >= period_reload) ? 1UL : (uint32_t)(period_reload - elapsed_cycles));
+}
+
+/**
+ * Body of the tick thread. Waits while the counter is stopped, otherwise waits
+ * for the next underflow, starts the next period from LOAD, raises the pending
+ * flag and runs the handler once the "interrupt" is no longer masked.
+ */
+static void *tick_thread_main(void *arg)
+{
+	struct timespec wait_until;
+	uint64_t deadline;
+	uint64_t now;
+	uint32_t generation;
+	uint32_t run_handler;
+	int rc;
+
+	(void)arg;
+#if SYSTICK_DEFER_ENABLED
+	in_interrupt = 1;
+#endif
+	pthread_mutex_lock(&port_lock);
+	for (;;)
+	{
+		while (counter_running == 0)
+		{
+			pthread_cond_wait(&port_cond, &port_lock);
+		}
+		generation = config_generation;
+		deadline = period_start + cycles_to_ns((uint64_t)period_reload + 1ULL);
+
+		while ((counter_running != 0) && (generation == config_generation))
+		{
+			wait_until.tv_sec = (time_t)(deadline / NSEC_PER_SEC);
+			wait_until.tv_nsec = (long)(deadline % NSEC_PER_SEC);
+			rc = pthread_cond_timedwait(&port_cond, &port_lock, &wait_until);
+			if ((rc != ETIMEDOUT) || (counter_running == 0) || (generation != config_generation))
+			{
+				continue;
+			}
+
+			period_start = deadline;
+			period_reload = reload_value;
+			deadline += cycles_to_ns((uint64_t)period_reload + 1ULL);
+			now = monotonic_ns();
+			if (deadline < now)
+			{
+				/* overran by more than a period: drop the missed ticks like the hardware would */
+				period_start = now;
+				deadline = now + cycles_to_ns((uint64_t)period_reload + 1ULL);
+			}
+			tick_sequence++;
+			pthread_cond_broadcast(&port_cond);
+			if (interrupt_enabled != 0)
+			{
+				tick_raised = 1;
+				pthread_mutex_unlock(&port_lock);
+				pthread_mutex_lock(&isr_lock);
+				pthread_mutex_lock(&port_lock);
+				run_handler = tick_raised;		/* may have been withdrawn while masked */
+				tick_raised = 0;
+				pthread_mutex_unlock(&port_lock);
+				if (run_handler != 0)
+				{
+					systick_irq_handler();
+				}
+				pthread_mutex_unlock(&isr_lock);
+				pthread_mutex_lock(&port_lock);
+			}
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Body of the thread standing in for the timer of a tick source other than
+ * SYSTICK_1. The argument packs the source with the generation it was started
+ * in; the thread ends once the source is stopped or restarted.
+ */
+static void *source_thread_main(void *arg)
+{
+	struct timespec wait_until;
+	uint32_t source = (uint32_t)((uintptr_t)arg & 0xFFUL);
+	uint32_t generation = (uint32_t)((uintptr_t)arg >> 8);
+	uint64_t deadline;
+	uint64_t now;
+	int rc;
+
+#if SYSTICK_DEFER_ENABLED
+	in_interrupt = 1;
+#endif
+	pthread_mutex_lock(&port_lock);
+	deadline = monotonic_ns() + source_period_ns[source];
+	while (generation == source_generation[source])
+	{
+		wait_until.tv_sec = (time_t)(deadline / NSEC_PER_SEC);
+		wait_until.tv_nsec = (long)(deadline % NSEC_PER_SEC);
+		rc = pthread_cond_timedwait(&port_cond, &port_lock, &wait_until);
+		if ((rc != ETIMEDOUT) || (generation != source_generation[source]))
+		{
+			continue;
+		}
+
+		deadline += source_period_ns[source];
+		now = monotonic_ns();
+		if (deadline < now)
+		{
+			deadline = now + source_period_ns[source];		/* drop missed ticks */
+		}
+		pthread_mutex_unlock(&port_lock);
+		pthread_mutex_lock(&isr_lock);
+		systick_instance_irq_handler((systick_t)source);
+		pthread_mutex_unlock(&isr_lock);
+		pthread_mutex_lock(&port_lock);
+	}
+	pthread_mutex_unlock(&port_lock);
+	return NULL;
+}
+
+#if SYSTICK_DEFER_ENABLED
+/**
+ * Body of the thread standing in for PendSV. Runs systick_defer_handler
+ * whenever the bottom half has been pended, holding defer_lock only: thread
+ * mode masked sections hold it off, while the tick thread keeps running as
+ * the tick interrupt preempts PendSV on target. The queue and the pending
+ * tick count it reads are lock free.
+ */
+static void *defer_thread_main(void *arg)
+{
+	(void)arg;
+	pthread_mutex_lock(&port_lock);
+	for (;;)
+	{
+		while (defer_raised == 0)
+		{
+			pthread_cond_wait(&port_cond, &port_lock);
+		}
+		defer_raised = 0;
+		pthread_mutex_unlock(&port_lock);
+		pthread_mutex_lock(&defer_lock);
+		systick_defer_handler();
+		pthread_mutex_unlock(&defer_lock);
+		pthread_mutex_lock(&port_lock);
+	}
+	return NULL;
+}
+#endif
+
+/**
+ * Records a register change and wakes the tick thread. port_lock must be held.
+ */
+static void port_state_changed(void)
+{
+	config_generation++;
+	pthread_cond_broadcast(&port_cond);
+}
+
+/******************************************************************************
+* Function: systick_port_init()
+*//**
+* \b Description:
+*
+* 	Starts the thread standing in for the SysTick interrupt and, where the
+* 	process is allowed to, raises it to the highest real-time priority to mirror
+* 	the maximum NVIC priority used on target. The counter is left stopped with
+* 	its interrupt masked.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The tick thread exists and is waiting for the counter to start
+*
+*	@param 		clock_source	ignored; the host counter always runs from SystemCoreClock
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_init(SYSTICK_INTERNAL_CLOCK);
+*	@endcode
+*
+*	@see	systick_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_init(systick_clock_source_t clock_source)
+{
+	struct sched_param param;
+
+	(void)clock_source;
+	port_lock_take();
+	counter_running = 0;
+	interrupt_enabled = 0;
+	tick_raised = 0;
+	port_state_changed();
+	if (thread_started == 0)
+	{
+		if (pthread_create(&tick_thread, NULL, tick_thread_main, NULL) == 0)
+		{
+			thread_started = 1;
+			param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+			(void)pthread_setschedparam(tick_thread, SCHED_FIFO, &param);	/* best effort, needs CAP_SYS_NICE */
+		}
+	}
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_counter_hz()
+*//**
+* \b Description:
+*
+* 	Returns the frequency of the emulated counter, which always runs from
+* 	SystemCoreClock.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@param 		clock_source	ignored; the host counter always runs from SystemCoreClock
+*
+*	@return 	uint32_t counter clock in Hz
+*
+* \b Example:
+*
+*	@code
+*	uint32_t reload = (systick_port_counter_hz(SYSTICK_INTERNAL_CLOCK) / 1000UL) - 1UL;
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_counter_hz(systick_clock_source_t clock_source)
+{
+	(void)clock_source;
+	return (SystemCoreClock);
+}
+
+/******************************************************************************
+* Function: systick_port_calib_tenms()
+*//**
+* \b Description:
+*
+* 	The host has no calibration register: always reports no reference
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t 0
+*
+* \b Example:
+*
+*	@code
+*	uint32_t calib_hz = systick_port_calib_tenms() * 100UL;
+*	@endcode
+*
+*	@see	systick_calib_tenms
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_calib_tenms(void)
+{
+	return (0);
+}
+
+/******************************************************************************
+* Function: systick_port_reload_set()
+*//**
+* \b Description:
+*
+* 	Sets the emulated reload value, which together with SystemCoreClock defines
+* 	the period of the tick thread.
+*
+*	PRE-CONDITION: reload fits the SYSTICK_PORT_RELOAD_MAX mask
+*
+*	POST-CONDITION: The next tick period uses the new reload
+*
+*	@param 		reload	number of counter clocks per tick minus one
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_reload_set((SystemCoreClock / 1000UL) - 1UL);
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_reload_set(uint32_t reload)
+{
+	port_lock_take();
+	reload_value = reload & SYSTICK_PORT_RELOAD_MAX;
+	period_reload = reload_value;
+	frozen_val = reload_value;
+	period_start = monotonic_ns();
+	port_state_changed();
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_load_set()
+*//**
+* \b Description:
+*
+* 	Sets the emulated reload value without restarting the period in progress.
+* 	The new value is picked up by the tick thread at the next underflow.
+*
+*	PRE-CONDITION: reload fits the SYSTICK_PORT_RELOAD_MAX mask
+*
+*	POST-CONDITION: The period after the current one uses the new reload
+*
+*	@param		reload	counter clocks per period minus one
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_reload_set(remainder - 1UL);	//short first period
+*	systick_port_resume();
+*	systick_port_load_set(period - 1UL);		//normal periods after it
+*	@endcode
+*
+*	@see	systick_port_reload_set
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_load_set(uint32_t reload)
+{
+	port_lock_take();
+	reload_value = reload & SYSTICK_PORT_RELOAD_MAX;
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_interrupt_set()
+*//**
+* \b Description:
+*
+* 	Enables or disables the calls to systick_irq_handler from the tick thread
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The emulated interrupt is enabled or disabled, as per the input
+*
+*	@param		interrupt_control Control parameter defining if the interrupt will be
+*				activated or deactivated
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_interrupt_set(SYSTICK_INT_ENABLED);
+*	@endcode
+*
+*	@see	systick_interrupt_control
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_interrupt_set(systick_interrupt_t interrupt_control)
+{
+	port_lock_take();
+	interrupt_enabled = (interrupt_control == SYSTICK_INT_ENABLED);
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_pause()
+*//**
+* \b Description:
+*
+* 	Stops the emulated counter. The tick thread finishes any handler call in
+* 	progress and then waits for the counter to be resumed.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: No further ticks are raised until systick_port_resume
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_pause();
+*	@endcode
+*
+*	@see	systick_pause
+*	@see	systick_port_resume
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_pause(void)
+{
+	port_lock_take();
+	if (counter_running != 0)
+	{
+		frozen_val = counter_now();
+		counter_running = 0;
+		port_state_changed();
+	}
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_resume()
+*//**
+* \b Description:
+*
+* 	Starts the emulated counter, which counts down from the value it was
+* 	stopped at. After systick_port_reload_set the first tick is raised one full
+* 	period later, as on hardware after the current value has been cleared.
+*
+*	PRE-CONDITION: systick_port_init has been called
+*
+*	POST-CONDITION: The tick thread raises a tick every period
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_resume();
+*	@endcode
+*
+*	@see	systick_resume
+*	@see	systick_port_pause
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_resume(void)
+{
+	port_lock_take();
+	if (counter_running == 0)
+	{
+		/* continue counting down from where the counter was stopped */
+		period_start = monotonic_ns() - cycles_to_ns((uint64_t)period_reload - frozen_val);
+		counter_running = 1;
+		port_state_changed();
+	}
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_is_running()
+*//**
+* \b Description:
+*
+* 	Reports whether the emulated counter is currently enabled.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t non-zero if the counter is running, 0 otherwise
+*
+* \b Example:
+*
+*	@code
+*	if (systick_port_is_running() == 0)
+*	{
+*		systick_port_reload_set(reload);
+*	}
+*	@endcode
+*
+*	@see	systick_tick_freq_set
+*	@see	systick_interrupt_control
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_is_running(void)
+{
+	uint32_t running;
+
+	port_lock_take();
+	running = counter_running;
+	pthread_mutex_unlock(&port_lock);
+	return (running);
+}
+
+/******************************************************************************
+* Function: systick_port_spin()
+*//**
+* \b Description:
+*
+* 	Called on every iteration of the driver's busy-wait loops. Yields the CPU so
+* 	a spinning caller cannot starve the tick thread on a loaded host.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	while (systick_get_tick() - start < wait_ms)
+*	{
+*		systick_port_spin();
+*	}
+*	@endcode
+*
+*	@see	systick_delay
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_spin(void)
+{
+	sched_yield();
+}
+
+/******************************************************************************
+* Function: systick_port_sleep()
+*//**
+* \b Description:
+*
+* 	Blocks until the next underflow of the emulated counter, the host
+* 	equivalent of WFI with the tick as the only wake-up source. Returns at once
+* 	if a tick is already pending or the counter cannot raise one.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: A tick is pending, or has been serviced if unmasked
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_save();
+*	systick_port_sleep();
+*	//... account the time slept ...
+*	systick_port_irq_restore(state);
+*	@endcode
+*
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_sleep(void)
+{
+	uint32_t sequence;
+
+	port_lock_take();
+	sequence = tick_sequence;
+	while ((tick_raised == 0) && (sequence == tick_sequence)
+		   && (counter_running != 0) && (interrupt_enabled != 0))
+	{
+		pthread_cond_wait(&port_cond, &port_lock);
+	}
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_wait_event()
+*//**
+* \b Description:
+*
+* 	The host has no event register, so this waits for the next tick like
+* 	systick_port_sleep: the wait for an event from another thread is bounded
+* 	by one tick period rather than cut short.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: A tick has occurred
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	while (flag == 0)
+*	{
+*		systick_port_wait_event();
+*	}
+*	@endcode
+*
+*	@see	systick_wait_until
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_wait_event(void)
+{
+	systick_port_sleep();
+}
+
+/******************************************************************************
+* Function: systick_port_counter_get()
+*//**
+* \b Description:
+*
+* 	Returns the value an equivalent SysTick down-counter would hold, computed
+* 	from the time since the tick thread started the current period. The value
+* 	holds at 1 if the tick thread runs late, so it never appears to wrap
+* 	before the tick has been accounted.
+*
+*	PRE-CONDITION: systick_port_init has been called
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t the emulated counter value, between 0 and the reload value
+*
+* \b Example:
+*
+*	@code
+*	uint32_t elapsed = systick_port_clocks_since_edge(reload, systick_port_counter_get());
+*	@endcode
+*
+*	@see	systick_get_cycles
+*	@see	systick_port_tick_pending
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_counter_get(void)
+{
+	uint32_t val;
+
+	port_lock_take();
+	val = counter_now();
+	pthread_mutex_unlock(&port_lock);
+	return (val);
+}
+
+/******************************************************************************
+* Function: systick_port_cycle_counter_init()
+*//**
+* \b Description:
+*
+* 	The host always has a cycle counter: the monotonic clock scaled to
+* 	SystemCoreClock
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t always 1
+*
+* \b Example:
+*
+*	@code
+*	if (systick_port_cycle_counter_init() != 0)
+*	{
+*		start = systick_port_cycle_counter_get();
+*	}
+*	@endcode
+*
+*	@see	systick_port_cycle_counter_get
+*	@see	systick_profile_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_cycle_counter_init(void)
+{
+	return (1);
+}
+
+/******************************************************************************
+* Function: systick_port_cycle_counter_get()
+*//**
+* \b Description:
+*
+* 	Returns the monotonic clock in emulated core clocks
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t core clocks counted, modulo 2^32
+*
+* \b Example:
+*
+*	@code
+*	uint32_t spent = systick_port_cycle_counter_get() - start;
+*	@endcode
+*
+*	@see	systick_port_cycle_counter_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_cycle_counter_get(void)
+{
+	uint64_t now = monotonic_ns();
+
+	return ((uint32_t)(((now / NSEC_PER_SEC) * SystemCoreClock)
+					 + (((now % NSEC_PER_SEC) * SystemCoreClock) / NSEC_PER_SEC)));
+}
+
+/******************************************************************************
+* Function: systick_port_tick_pending()
+*//**
+* \b Description:
+*
+* 	Reports whether a tick is pending: the emulated counter has underflowed
+* 	and the tick thread has not yet run the handler, typically because the
+* 	caller holds systick_port_irq_save.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t non-zero if a tick is pending, 0 otherwise
+*
+* \b Example:
+*
+*	@code
+*	if (systick_port_tick_pending() != 0)
+*	{
+*		//the counter has wrapped past the last accounted tick
+*	}
+*	@endcode
+*
+*	@see	systick_get_cycles
+*	@see	systick_port_counter_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_tick_pending(void)
+{
+	uint32_t pending;
+
+	port_lock_take();
+	pending = tick_raised;
+	pthread_mutex_unlock(&port_lock);
+	return (pending);
+}
+
+/******************************************************************************
+* Function: systick_port_tick_pending_clear()
+*//**
+* \b Description:
+*
+* 	Withdraws a pending tick, so the tick thread skips the handler call it is
+* 	holding back. For callers which have accounted the tick themselves.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: No tick is pending
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	if (systick_port_tick_pending() != 0)
+*	{
+*		systick_port_tick_pending_clear();
+*	}
+*	@endcode
+*
+*	@see	systick_port_tick_pending
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_tick_pending_clear(void)
+{
+	port_lock_take();
+	tick_raised = 0;
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_irq_save()
+*//**
+* \b Description:
+*
+* 	Keeps the tick thread from running systick_irq_handler until the matching
+* 	systick_port_irq_restore, the host equivalent of masking the interrupt.
+* 	Nests correctly and may be called from the handler itself. From thread
+* 	mode it also holds off the defer thread, as a masked section holds off
+* 	PendSV on target.
+*
+*	PRE-CONDITION: systick_port_init has been called
+*
+*	POST-CONDITION: The emulated tick interrupt is held off
+*
+*	@return 	uint32_t unused token, pass it to systick_port_irq_restore
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_save();
+*	//... touch data shared with the systick ISR ...
+*	systick_port_irq_restore(state);
+*	@endcode
+*
+*	@see	systick_port_irq_restore
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_irq_save(void)
+{
+	pthread_once(&port_once, port_setup);
+#if SYSTICK_DEFER_ENABLED
+	if (in_interrupt == 0)
+	{
+		pthread_mutex_lock(&defer_lock);
+	}
+#endif
+	pthread_mutex_lock(&isr_lock);
+	return (0);
+}
+
+/******************************************************************************
+* Function: systick_port_irq_restore()
+*//**
+* \b Description:
+*
+* 	Lets the tick thread run the handler again after systick_port_irq_save
+*
+*	PRE-CONDITION: Called by the thread which made the matching save
+*
+*	POST-CONDITION: The emulated tick interrupt is released if this was the
+*					outermost save
+*
+*	@param		state	the value returned by systick_port_irq_save
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_save();
+*	//... touch data shared with the systick ISR ...
+*	systick_port_irq_restore(state);
+*	@endcode
+*
+*	@see	systick_port_irq_save
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_irq_restore(uint32_t state)
+{
+	(void)state;
+	pthread_mutex_unlock(&isr_lock);
+#if SYSTICK_DEFER_ENABLED
+	if (in_interrupt == 0)
+	{
+		pthread_mutex_unlock(&defer_lock);
+	}
+#endif
+}
+
+/******************************************************************************
+* Function: systick_port_irq_raise()
+*//**
+* \b Description:
+*
+* 	Host stand-in for masking by priority (BASEPRI). The emulated interrupts
+* 	have no priorities, so every priority holds off the tick thread, as
+* 	systick_port_irq_save does.
+*
+*	PRE-CONDITION: systick_port_init has been called
+*
+*	POST-CONDITION: The emulated tick interrupt is held off
+*
+*	@param		priority	ignored
+*
+*	@return 	uint32_t unused token, pass it to systick_port_irq_lower
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_raise(SYSTICK_INSTANCE_IRQ_PRIORITY);
+*	//... touch data shared with the tick sources ...
+*	systick_port_irq_lower(state);
+*	@endcode
+*
+*	@see	systick_port_irq_lower
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_irq_raise(uint32_t priority)
+{
+	(void)priority;
+	return (systick_port_irq_save());
+}
+
+/******************************************************************************
+* Function: systick_port_irq_lower()
+*//**
+* \b Description:
+*
+* 	Releases the tick thread held off by systick_port_irq_raise
+*
+*	PRE-CONDITION: Called by the thread which made the matching raise
+*
+*	POST-CONDITION: The emulated tick interrupt is released if this was the
+*					outermost mask
+*
+*	@param		state	the value returned by systick_port_irq_raise
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_raise(SYSTICK_INSTANCE_IRQ_PRIORITY);
+*	//... touch data shared with the tick sources ...
+*	systick_port_irq_lower(state);
+*	@endcode
+*
+*	@see	systick_port_irq_raise
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_irq_lower(uint32_t state)
+{
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_port_read_begin()
+*//**
+* \b Description:
+*
+* 	Opens a read of the tick accounting. The tick thread runs concurrently
+* 	with its readers, possibly on another core, so a read holds it off
+* 	through isr_lock as a masked section does: the tick values, the pending
+* 	flag and the counter are then seen as a single core reader preempted by
+* 	the handler would see them. Unlike on target, the readers block. The
+* 	defer thread is not held off, so a long bottom half does not delay them;
+* 	no masked section may be opened inside a read.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The tick thread is held off until systick_port_read_end
+*
+*	@return 	uint32_t unused token, pass it to systick_port_read_end
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_read_begin();
+*	//... read the tick accounting ...
+*	systick_port_read_end(state);
+*	@endcode
+*
+*	@see	systick_port_read_end
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_read_begin(void)
+{
+	pthread_once(&port_once, port_setup);
+	pthread_mutex_lock(&isr_lock);
+	return (0);
+}
+
+/******************************************************************************
+* Function: systick_port_read_end()
+*//**
+* \b Description:
+*
+* 	Closes a read opened by systick_port_read_begin
+*
+*	PRE-CONDITION: Called by the thread which made the matching begin
+*
+*	POST-CONDITION: The tick thread is released if no masked section is open
+*
+*	@param		state	the value returned by systick_port_read_begin
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_read_begin();
+*	//... read the tick accounting ...
+*	systick_port_read_end(state);
+*	@endcode
+*
+*	@see	systick_port_read_begin
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_read_end(uint32_t state)
+{
+	(void)state;
+	pthread_mutex_unlock(&isr_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_source_start()
+*//**
+* \b Description:
+*
+* 	Starts a thread standing in for the timer of a tick source other than
+* 	SYSTICK_1, calling systick_instance_irq_handler every tick period with the
+* 	emulated interrupts masked. Ticks missed by more than a period are dropped.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The source ticks at tick_freq_hz, first one period from now
+*
+*	@param 		source			the tick source to start
+*	@param 		tick_freq_hz	the desired tick rate
+*
+*	@return 	uint32_t non-zero if started, 0 if source is SYSTICK_1 or out of range,
+*				the rate is 0, or the thread could not be created
+*
+* \b Example:
+*
+*	@code
+*	systick_port_source_start(SYSTICK_2, 20000UL);
+*	@endcode
+*
+*	@see	systick_instance_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_source_start(systick_t source, uint32_t tick_freq_hz)
+{
+	pthread_attr_t attr;
+	pthread_t thread;
+	uintptr_t arg;
+	uint32_t started = 0;
+
+	if ((source == SYSTICK_1) || (source >= NUM_SYSTICKS) || (tick_freq_hz == 0))
+	{
+		return (0);
+	}
+
+	port_lock_take();
+	source_generation[source]++;
+	source_period_ns[source] = (NSEC_PER_SEC + (tick_freq_hz / 2UL)) / tick_freq_hz;
+	arg = ((uintptr_t)source_generation[source] << 8) | (uintptr_t)source;
+	pthread_cond_broadcast(&port_cond);
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&thread, &attr, source_thread_main, (void *)arg) == 0)
+	{
+		started = 1;
+	}
+	pthread_attr_destroy(&attr);
+	pthread_mutex_unlock(&port_lock);
+	return (started);
+}
+
+/******************************************************************************
+* Function: systick_port_source_stop()
+*//**
+* \b Description:
+*
+* 	Stops the thread of a tick source other than SYSTICK_1. A handler already
+* 	running finishes; no further one is started.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The source raises no further ticks
+*
+*	@param 		source	the tick source to stop
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_source_stop(SYSTICK_2);
+*	@endcode
+*
+*	@see	systick_instance_deinit
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_source_stop(systick_t source)
+{
+	if ((source == SYSTICK_1) || (source >= NUM_SYSTICKS))
+	{
+		return;
+	}
+	port_lock_take();
+	source_generation[source]++;
+	pthread_cond_broadcast(&port_cond);
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_source_period_get()
+*//**
+* \b Description:
+*
+* 	Returns the tick period a source actually runs at, which differs from
+* 	1 / tick_freq_hz by its rounding to whole nanoseconds
+*
+*	PRE-CONDITION: systick_port_source_start has started source
+*
+*	POST-CONDITION: None
+*
+*	@param 		source		the tick source
+*	@param 		clock_hz	set to the clock the period is counted in
+*
+*	@return 	uint32_t clocks per tick, 0 if source is not a started source
+*
+* \b Example:
+*
+*	@code
+*	uint32_t clock_hz;
+*	uint32_t clocks = systick_port_source_period_get(SYSTICK_2, &clock_hz);
+*	@endcode
+*
+*	@see	systick_port_source_start
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_source_period_get(systick_t source, uint32_t *clock_hz)
+{
+	uint32_t period;
+
+	if ((source == SYSTICK_1) || (source >= NUM_SYSTICKS))
+	{
+		return (0);
+	}
+	port_lock_take();
+	period = (uint32_t)source_period_ns[source];
+	pthread_mutex_unlock(&port_lock);
+	*clock_hz = (uint32_t)NSEC_PER_SEC;
+	return (period);
+}
+
+/******************************************************************************
+* Function: systick_port_source_ack()
+*//**
+* \b Description:
+*
+* 	Nothing to acknowledge on the host, the source threads raise no flags
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@param 		source	the tick source whose tick is being handled
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_source_ack(SYSTICK_2);
+*	@endcode
+*
+*	@see	systick_instance_irq_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_source_ack(systick_t source)
+{
+	(void)source;
+}
+
+/******************************************************************************
+* Function: systick_port_defer_init()
+*//**
+* \b Description:
+*
+* 	Starts the thread standing in for PendSV, at normal priority below the tick
+* 	thread, when SYSTICK_DEFER_ENABLED is set. It runs the bottom half with the emulated interrupts masked, so
+* 	the tick thread waits for a running handler: on the host the bottom half
+* 	keeps its mutual exclusion with masked sections but not its timing.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The bottom half thread exists
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_defer_init();
+*	@endcode
+*
+*	@see	systick_defer_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_defer_init(void)
+{
+	port_lock_take();
+	defer_raised = 0;
+#if SYSTICK_DEFER_ENABLED
+	if (defer_started == 0)
+	{
+		if (pthread_create(&defer_thread, NULL, defer_thread_main, NULL) == 0)
+		{
+			defer_started = 1;
+		}
+	}
+#endif
+	pthread_mutex_unlock(&port_lock);
+}
+
+/******************************************************************************
+* Function: systick_port_defer_pend()
+*//**
+* \b Description:
+*
+* 	Wakes the bottom half thread
+*
+*	PRE-CONDITION: systick_port_defer_init has been called
+*
+*	POST-CONDITION: systick_defer_handler runs soon
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_defer_pend();
+*	@endcode
+*
+*	@see	systick_defer_post
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_defer_pend(void)
+{
+	port_lock_take();
+	defer_raised = 1;
+	pthread_cond_broadcast(&port_cond);
+	pthread_mutex_unlock(&port_lock);
+}
@@ -0,0 +1,368 @@
+/*******************************************************************************
+* Title                 :   Systick CPU Load Meter
+* Filename              :   systick_load.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_load.c
+ *  @brief CPU load meter behind systick_load.h. The tick interrupt publishes
+ *  		its window snapshot under a sequence count, and the reader works
+ *  		through the windows since the last read in one step: a stretch of k
+ *  		windows is taken at its average load, and the moving averages decay
+ *  		by their per-window factor to the power k. Reading seldom is
+ *  		therefore as cheap as reading every window.
+ *
+ *  Loads and the averages are held as fractions in 1/65536.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdatomic.h>
+#include "systick_load.h"
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_port.h"
+
+#define LOAD_ONE			(65536UL)		/**<Load of a fully busy window */
+
+/**
+ * Factor a moving average with time constant tau_ms keeps of its value per
+ * window, 1 - window / tau in 1/65536
+ */
+#define LOAD_DECAY(tau_ms)	(LOAD_ONE - (((LOAD_ONE * SYSTICK_LOAD_WINDOW_MS) + ((tau_ms) / 2UL)) / (tau_ms)))
+
+static volatile uint32_t idle_active = 0;		/**<Non-zero between idle enter and exit */
+static volatile uint32_t idle_start;			/**<Counter clock the current idle period began at */
+static volatile uint64_t idle_total = 0;		/**<Counter clocks spent idle, finished periods */
+
+static volatile uint32_t snap_sequence = 0;		/**<Odd while the snapshot is being written */
+static volatile uint32_t snap_ms;				/**<Tick of the last snapshot */
+static volatile uint32_t snap_cycles;			/**<Counter clock of the last snapshot */
+static volatile uint64_t snap_idle;				/**<Idle clocks up to the last snapshot */
+
+static uint32_t last_ms;						/**<Snapshot the averages are up to */
+static uint32_t last_cycles;
+static uint64_t last_idle;
+static uint32_t primed = 0;						/**<Non-zero once the averages hold a window */
+static uint32_t load_window;					/**<Load of the last window */
+static uint32_t load_short;						/**<Short moving average */
+static uint32_t load_long;						/**<Long moving average */
+
+/**
+ * Tick subscriber run every window: records the time and the idle clocks,
+ * counting an idle period still in progress up to now
+ */
+static void load_snapshot(void)
+{
+	uint32_t now = systick_get_cycles();
+	uint64_t idle = idle_total;
+
+	if (idle_active != 0)
+	{
+		idle += (uint32_t)(now - idle_start);
+	}
+	snap_sequence++;
+	atomic_thread_fence(memory_order_release);
+	snap_ms = systick_tick_ms;
+	snap_cycles = now;
+	snap_idle = idle;
+	atomic_thread_fence(memory_order_release);
+	snap_sequence++;
+}
+
+/**
+ * Raises a decay factor in 1/65536 to the power k
+ */
+static uint32_t load_decay_pow(uint32_t decay, uint32_t k)
+{
+	uint64_t result = LOAD_ONE;
+	uint64_t base = decay;
+
+	while (k != 0)
+	{
+		if ((k & 1UL) != 0)
+		{
+			result = (result * base) >> 16;
+		}
+		base = (base * base) >> 16;
+		k >>= 1;
+	}
+	return ((uint32_t)result);
+}
+
+/**
+ * Moves a moving average k windows on, over which the load was sample
+ */
+static uint32_t load_average(uint32_t average, uint32_t sample, uint32_t decay, uint32_t k)
+{
+	int64_t gap = (int64_t)average - (int64_t)sample;
+
+	return ((uint32_t)((int64_t)sample + ((gap * load_decay_pow(decay, k)) / (int64_t)LOAD_ONE)));
+}
+
+/**
+ * Folds the windows completed since the last call into the load figures
+ */
+static void load_update(void)
+{
+	uint32_t sequence;
+	uint32_t ms;
+	uint32_t cycles;
+	uint64_t idle;
+	uint32_t elapsed_ms;
+	uint64_t elapsed;
+	uint64_t idle_delta;
+	uint32_t windows;
+	uint32_t sample;
+
+	do
+	{
+		sequence = snap_sequence;
+		atomic_thread_fence(memory_order_acquire);
+		ms = snap_ms;
+		cycles = snap_cycles;
+		idle = snap_idle;
+		atomic_thread_fence(memory_order_acquire);
+	} while (((sequence & 1UL) != 0) || (sequence != snap_sequence));
+
+	elapsed_ms = ms - last_ms;
+	windows = (elapsed_ms + (SYSTICK_LOAD_WINDOW_MS / 2UL)) / SYSTICK_LOAD_WINDOW_MS;
+	if ((sequence == 0) || (windows == 0))
+	{
+		return;
+	}
+	elapsed = ((uint64_t)elapsed_ms * systick_counter_hz_get()) / 1000ULL;
+	if (elapsed < 0x80000000ULL)
+	{
+		elapsed = (uint32_t)(cycles - last_cycles);		/* exact while the clock cannot have wrapped */
+	}
+	idle_delta = idle - last_idle;
+	sample = (idle_delta >= elapsed) ? 0UL : (uint32_t)(LOAD_ONE - ((idle_delta * LOAD_ONE) / elapsed));
+
+	if (primed == 0)
+	{
+		load_short = sample;
+		load_long = sample;
+		primed = 1;
+	}
+	load_window = sample;
+	load_short = load_average(load_short, sample, LOAD_DECAY(SYSTICK_LOAD_SHORT_MS), windows);
+	load_long = load_average(load_long, sample, LOAD_DECAY(SYSTICK_LOAD_LONG_MS), windows);
+	last_ms = ms;
+	last_cycles = cycles;
+	last_idle = idle;
+}
+
+/**
+ * Converts a load in 1/65536 to hundredths of a percent
+ */
+static uint32_t load_to_centipercent(uint32_t load)
+{
+	return ((uint32_t)((((uint64_t)load * 10000ULL) + (LOAD_ONE / 2UL)) / LOAD_ONE));
+}
+
+/******************************************************************************
+* Function: systick_load_init()
+*//**
+* \b Description:
+*
+* 	Clears the load figures and subscribes the window snapshot to the tick,
+* 	at position SYSTICK_LOAD_DISPATCH_PRIORITY of the dispatch table. The
+* 	window is rounded to whole ticks.
+*
+*	PRE-CONDITION: The systick has been initialised with its interrupt enabled
+*
+*	POST-CONDITION: Load is measured from the first window on, unless the
+*					subscription failed
+*
+*	@return 	systick_dispatch_status_t the result of subscribing to the tick:
+*				SYSTICK_DISPATCH_FULL if the dispatch table has no free row,
+*				in which case the load figures stay at 0
+*
+* \b Example:
+*
+*	@code
+*	systick_init(tick_config);
+*	if (systick_load_init() != SYSTICK_DISPATCH_OK)
+*	{
+*		error_handler();
+*	}
+*	@endcode
+*
+*	@see	systick_load_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_load_init(void)
+{
+	uint64_t period = (uint64_t)systick_tick_reload_get() + 1ULL;
+	uint32_t divider = (uint32_t)((((uint64_t)SYSTICK_LOAD_WINDOW_MS * systick_counter_hz_get()) + (500ULL * period))
+								  / (1000ULL * period));
+	uint32_t state = systick_port_irq_save();
+
+	idle_active = 0;
+	idle_total = 0;
+	snap_sequence = 0;
+	last_ms = systick_tick_ms;
+	last_cycles = systick_get_cycles();
+	last_idle = 0;
+	primed = 0;
+	load_window = 0;
+	load_short = 0;
+	load_long = 0;
+	systick_port_irq_restore(state);
+	return (systick_subscribe(load_snapshot, (divider != 0) ? divider : 1UL, SYSTICK_LOAD_DISPATCH_PRIORITY));
+}
+
+/******************************************************************************
+* Function: systick_load_idle_enter()
+*//**
+* \b Description:
+*
+* 	Marks the start of idle time, right before the CPU sleeps or starts
+* 	polling for work. Called by systick_sched_idle, systick_delay_sleep and
+* 	systick_tickless_idle when SYSTICK_LOAD_ENABLED is set; a custom idle
+* 	loop calls it itself.
+*
+*	PRE-CONDITION: Not already idle
+*
+*	POST-CONDITION: Time counts as idle until systick_load_idle_exit
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	state = systick_port_irq_save();
+*	systick_load_idle_enter();
+*	__WFI();
+*	systick_load_idle_exit();
+*	systick_port_irq_restore(state);		//the waking ISR counts as busy
+*	@endcode
+*
+*	@see	systick_load_idle_exit
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_load_idle_enter(void)
+{
+	idle_start = systick_get_cycles();
+	atomic_thread_fence(memory_order_release);
+	idle_active = 1;
+}
+
+/******************************************************************************
+* Function: systick_load_idle_exit()
+*//**
+* \b Description:
+*
+* 	Marks the end of idle time. Sleeping with interrupts masked and calling
+* 	this before unmasking keeps the waking interrupt out of the idle time;
+* 	otherwise the interrupt counts as idle.
+*
+*	PRE-CONDITION: systick_load_idle_enter has been called, less than 2^32
+*					counter clocks ago
+*
+*	POST-CONDITION: The idle period is added to the idle total
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_load_idle_enter();
+*	while (work_pending() == 0);
+*	systick_load_idle_exit();
+*	@endcode
+*
+*	@see	systick_load_idle_enter
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_load_idle_exit(void)
+{
+	uint32_t state = systick_port_irq_save();
+
+	if (idle_active != 0)
+	{
+		idle_total += (uint32_t)(systick_get_cycles() - idle_start);
+		idle_active = 0;
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_load_get()
+*//**
+* \b Description:
+*
+* 	Brings the load figures up to the last completed window and returns them
+*
+*	PRE-CONDITION: systick_load_init has been called
+*	PRE-CONDITION: Called from thread mode, not concurrently with itself
+*
+*	POST-CONDITION: None
+*
+*	@param		load	filled with the load of the last window and the averages
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_load_get(&load);
+*	if (load.long_avg > 8000)
+*	{
+*		feature_disable(FEATURE_SPECTRUM_VIEW);		//keep 20 % headroom
+*	}
+*	@endcode
+*
+*	@see	systick_load_idle_enter
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_load_get(systick_load_t *load)
+{
+	load_update();
+	load->window = load_to_centipercent(load_window);
+	load->short_avg = load_to_centipercent(load_short);
+	load->long_avg = load_to_centipercent(load_long);
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+* Title                 :   Systick CPU Load Meter
+* Filename              :   systick_load.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_load.h
+ *  @brief CPU load meter. Idle time is measured in counter clocks between
+ *  		systick_load_idle_enter and systick_load_idle_exit, which the
+ *  		driver's own idle and sleep paths call when SYSTICK_LOAD_ENABLED is
+ *  		set. Every SYSTICK_LOAD_WINDOW_MS the tick interrupt takes a
+ *  		snapshot of the time and the idle total, nothing more. The load of
+ *  		each window and its moving averages over SYSTICK_LOAD_SHORT_MS and
+ *  		SYSTICK_LOAD_LONG_MS, like a load average, are worked out in thread
+ *  		mode when the load is read.
+ *
+ *  @code
+ *  systick_load_t load;
+ *
+ *  systick_load_init();
+ *  ...
+ *  systick_load_get(&load);
+ *  printf("cpu %lu.%02lu %% (1 s), %lu.%02lu %% (10 s)\n",
+ *  	   load.short_avg / 100, load.short_avg % 100, load.long_avg / 100, load.long_avg % 100);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_LOAD_H
+#define _SYSTICK_LOAD_H
+
+#include "systick_stm32f411_config.h"
+#include "systick_dispatch.h"
+
+/**
+ * CPU load, each figure in hundredths of a percent (0 to 10000)
+ */
+typedef struct
+{
+	uint32_t window;		/**<Load over the last SYSTICK_LOAD_WINDOW_MS */
+	uint32_t short_avg;		/**<Moving average with time constant SYSTICK_LOAD_SHORT_MS */
+	uint32_t long_avg;		/**<Moving average with time constant SYSTICK_LOAD_LONG_MS */
+}systick_load_t;
+
+systick_dispatch_status_t systick_load_init(void);
+void systick_load_idle_enter(void);
+void systick_load_idle_exit(void);
+void systick_load_get(systick_load_t *load);
+
+#endif
@@ -0,0 +1,280 @@
+/*******************************************************************************
+* Title                 :   Systick Compact Event Log
+* Filename              :   systick_log.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_log.c
+ *  @brief Encoder behind systick_log.h. A record is encoded whole into a
+ *  		scratch buffer and then copied into the block, so it never
+ *  		straddles two blocks. A record that does not fit closes the block
+ *  		and is encoded again behind the next block's sync record.
+ *
+ *  The encoder is not reentrant. Log from one context, e.g. the thread
+ *  draining a systick_trace ring, or mask interrupts around the calls.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "systick_log.h"
+#include "systick_interface.h"
+
+#if SYSTICK_LOG_BLOCK_SIZE < (SYSTICK_LOG_SYNC_MAX + SYSTICK_LOG_EVENT_MAX)
+#error "SYSTICK_LOG_BLOCK_SIZE must hold a sync record and an event record"
+#endif
+
+/**
+ * Writes value as a LEB128 varint, returning its length in bytes
+ */
+static uint32_t log_varint(uint8_t *out, uint64_t value)
+{
+	uint32_t length = 0;
+
+	while (value >= 0x80U)
+	{
+		out[length++] = (uint8_t)(value | 0x80U);
+		value >>= 7;
+	}
+	out[length++] = (uint8_t)value;
+	return (length);
+}
+
+/**
+ * Encodes a record, behind a sync record if the block is new or the time
+ * went backwards, returning its length in bytes
+ */
+static uint32_t log_encode(systick_log_t *log, uint8_t *out, uint64_t time, uint32_t event, uint32_t arg)
+{
+	uint32_t length = 0;
+	uint64_t delta = time - log->last_time;
+
+	if ((log->fill == 0) || (time < log->last_time))
+	{
+		out[length++] = SYSTICK_LOG_SYNC;
+		length += log_varint(&out[length], log->sequence);
+		length += log_varint(&out[length], time);
+		delta = 0;
+	}
+	length += log_varint(&out[length], delta << 1);
+	length += log_varint(&out[length], event);
+	length += log_varint(&out[length], arg);
+	return (length);
+}
+
+/**
+ * Pads the current block, hands it to the flush callback and starts the next
+ */
+static void log_block_end(systick_log_t *log)
+{
+	memset(&log->block[log->fill], SYSTICK_LOG_PAD, SYSTICK_LOG_BLOCK_SIZE - log->fill);
+	log->flush(log->block, SYSTICK_LOG_BLOCK_SIZE);
+	log->sequence++;
+	log->fill = 0;
+}
+
+/******************************************************************************
+* Function: systick_log_init()
+*//**
+* \b Description:
+*
+* 	Sets up an empty log. Blocks are numbered from sequence on; after a
+* 	restart, continue from the sequence after the last stored block so the
+* 	decoder orders old and new blocks correctly.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The first record opens block number sequence
+*
+*	@param		log			the log to set up
+*	@param		flush		called with each completed block
+*	@param		sequence	number of the first block
+*
+*	@return 	systick_log_status_t SYSTICK_LOG_OK or SYSTICK_LOG_INVALID
+*
+* \b Example:
+*
+*	@code
+*	static systick_log_t event_log;
+*
+*	systick_log_init(&event_log, flash_page_write, flash_log_last_sequence() + 1);
+*	@endcode
+*
+*	@see	systick_log_write
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_log_status_t systick_log_init(systick_log_t *log, systick_log_flush_t flush, uint32_t sequence)
+{
+	if ((log == NULL) || (flush == NULL))
+	{
+		return (SYSTICK_LOG_INVALID);
+	}
+	log->fill = 0;
+	log->sequence = sequence;
+	log->last_time = 0;
+	log->records = 0;
+	log->flush = flush;
+	return (SYSTICK_LOG_OK);
+}
+
+/******************************************************************************
+* Function: systick_log_write()
+*//**
+* \b Description:
+*
+* 	Appends an event with a time of the caller's choosing, e.g. a
+* 	systick_trace record's timestamp widened to 64 bits. Times should not
+* 	decrease; a time earlier than the previous record's costs a sync record.
+* 	Hands the block to the flush callback when the record does not fit.
+*
+*	PRE-CONDITION: log has been set up with systick_log_init
+*	PRE-CONDITION: time < 2^63
+*
+*	POST-CONDITION: The event is in the log
+*
+*	@param		log		the log
+*	@param		time	time of the event
+*	@param		event	event identifier
+*	@param		arg		event argument
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	count = systick_trace_peek(&ring, &span);
+*	for (i = 0; i < count; i++)
+*	{
+*		cycles += (uint32_t)(span[i].timestamp - (uint32_t)cycles);
+*		systick_log_write(&event_log, cycles, span[i].event, span[i].arg);
+*	}
+*	systick_trace_release(&ring, count);
+*	@endcode
+*
+*	@see	systick_log_event
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_log_write(systick_log_t *log, uint64_t time, uint32_t event, uint32_t arg)
+{
+	uint8_t record[SYSTICK_LOG_SYNC_MAX + SYSTICK_LOG_EVENT_MAX];
+	uint32_t length = log_encode(log, record, time, event, arg);
+
+	if ((log->fill + length) > SYSTICK_LOG_BLOCK_SIZE)
+	{
+		log_block_end(log);
+		length = log_encode(log, record, time, event, arg);
+	}
+	memcpy(&log->block[log->fill], record, length);
+	log->fill += length;
+	log->last_time = time;
+	log->records++;
+}
+
+/******************************************************************************
+* Function: systick_log_event()
+*//**
+* \b Description:
+*
+* 	Appends an event stamped with the current tick from systick_get_tick64
+*
+*	PRE-CONDITION: log has been set up with systick_log_init
+*	PRE-CONDITION: The systick has been initialised
+*
+*	POST-CONDITION: The event is in the log
+*
+*	@param		log		the log
+*	@param		event	event identifier
+*	@param		arg		event argument
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_log_event(&event_log, EVENT_MOTOR_START, rpm);
+*	@endcode
+*
+*	@see	systick_log_write
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_log_event(systick_log_t *log, uint32_t event, uint32_t arg)
+{
+	systick_log_write(log, systick_get_tick64(), event, arg);
+}
+
+/******************************************************************************
+* Function: systick_log_flush()
+*//**
+* \b Description:
+*
+* 	Hands the partly filled block to the flush callback, padded, e.g. before
+* 	a reset or when the log is read out. The next record opens a new block.
+*
+*	PRE-CONDITION: log has been set up with systick_log_init
+*
+*	POST-CONDITION: Every record written so far has been flushed
+*
+*	@param		log		the log
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_log_event(&event_log, EVENT_SHUTDOWN, reason);
+*	systick_log_flush(&event_log);
+*	@endcode
+*
+*	@see	systick_log_write
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_log_flush(systick_log_t *log)
+{
+	if (log->fill != 0)
+	{
+		log_block_end(log);
+	}
+}
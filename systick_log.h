@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Title                 :   Systick Compact Event Log
+* Filename              :   systick_log.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_log.h
+ *  @brief Compact event log. Each record stores its time as the difference
+ *  		from the previous record, so a burst of events costs about 3 bytes
+ *  		per event instead of 12 for a raw time, event and argument.
+ *
+ *  The log is written in blocks of SYSTICK_LOG_BLOCK_SIZE bytes. Each full
+ *  block is handed to a flush callback. Every block starts with a sync
+ *  record holding the block's sequence number and the absolute time, so each
+ *  block decodes on its own. Blocks kept in a circular flash area are put
+ *  back in order by their sequence numbers. tools/systick_log_decode.c
+ *  decodes a stream on the host.
+ *
+ *  Stream format. Every number is an unsigned LEB128 varint: 7 bits per
+ *  byte, least significant group first, bit 7 set on every byte but the
+ *  last.
+ *
+ *  - Event record: varint(delta << 1), varint(event), varint(arg). delta is
+ *    the time since the previous record.
+ *  - Sync record: the byte 0x01, varint(block sequence), varint(time). This
+ *    sets the absolute time. It opens every block and is repeated inside a
+ *    block when the time goes backwards.
+ *  - Padding: a 0xFF byte where a record would start ends the block's data.
+ *    The rest of the block is 0xFF, the erased state of flash, so a block
+ *    that was only partly programmed still decodes.
+ *
+ *  The unit of time is the caller's choice. systick_log_event uses ticks,
+ *  from systick_get_tick64.
+ *
+ *  @code
+ *  static systick_log_t event_log;
+ *
+ *  systick_log_init(&event_log, flash_page_write, 0);
+ *  ...
+ *  systick_log_event(&event_log, EVENT_MOTOR_START, rpm);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_LOG_H
+#define _SYSTICK_LOG_H
+
+#include "systick_stm32f411_config.h"
+
+#define SYSTICK_LOG_SYNC		(0x01U)		/**<First byte of a sync record */
+#define SYSTICK_LOG_PAD			(0xFFU)		/**<Fill after the last record of a block */
+#define SYSTICK_LOG_SYNC_MAX	(16U)		/**<Longest sync record, in bytes */
+#define SYSTICK_LOG_EVENT_MAX	(20U)		/**<Longest event record, in bytes */
+
+/**
+ * Result of a log operation
+ */
+typedef enum
+{
+	SYSTICK_LOG_OK,
+	SYSTICK_LOG_INVALID				/**<NULL log or flush callback */
+}systick_log_status_t;
+
+/**
+ * Called with each completed block, always SYSTICK_LOG_BLOCK_SIZE bytes
+ */
+typedef void (*systick_log_flush_t) (const uint8_t *block, uint32_t size);
+
+/**
+ * Log encoder state, see systick_log_init
+ */
+typedef struct
+{
+	uint8_t block[SYSTICK_LOG_BLOCK_SIZE];	/**<Block being filled */
+	uint32_t fill;						/**<Bytes used in block, 0 before its sync record */
+	uint32_t sequence;					/**<Sequence number of the block being filled */
+	uint64_t last_time;					/**<Time of the last record */
+	uint32_t records;					/**<Event records written */
+	systick_log_flush_t flush;			/**<Storage for completed blocks */
+}systick_log_t;
+
+systick_log_status_t systick_log_init(systick_log_t *log, systick_log_flush_t flush, uint32_t sequence);
+void systick_log_write(systick_log_t *log, uint64_t time, uint32_t event, uint32_t arg);
+void systick_log_event(systick_log_t *log, uint32_t event, uint32_t arg);
+void systick_log_flush(systick_log_t *log);
+
+#endif
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Title                 :   Systick Millisecond Accounting
+* Filename              :   systick_ms.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_ms.h
+ *  @brief Millisecond accounting shared by the tick sources of systick.c and
+ *  		systick_instance.c. Internal to the driver, not part of its API.
+ *
+ *  A source's period is kept as whole nanoseconds plus a fraction in
+ *  1/counter_hz ns, carried from tick to tick in an error term, so the
+ *  milliseconds do not drift from the counter's clock. The 64 bit
+ *  millisecond count is two words written low word first by the ISR and
+ *  read without a lock.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_MS_H
+#define _SYSTICK_MS_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+/**
+ * Advances sub-millisecond accounting by one tick period of tick_ns plus
+ * tick_ns_frac / counter_hz nanoseconds and returns the whole milliseconds
+ * it carried. 32 bit arithmetic only, as it runs per tick: sub_ns + tick_ns
+ * fits as the tick period is at most a second.
+ */
+static inline uint32_t systick_ms_step(uint32_t *sub_ns, uint32_t *err, uint32_t tick_ns,
+									   uint32_t tick_ns_frac, uint32_t counter_hz)
+{
+	uint32_t ns = *sub_ns + tick_ns;
+	uint32_t frac = *err + tick_ns_frac;
+	uint32_t ms;
+
+	if (frac >= counter_hz)
+	{
+		frac -= counter_hz;
+		ns++;
+	}
+	ms = ns / 1000000UL;
+	*sub_ns = ns - (ms * 1000000UL);
+	*err = frac;
+	return (ms);
+}
+
+/**
+ * Adds the milliseconds a tick carried to a 64 bit count, from the ISR which
+ * owns it. The low word is made visible before the high word moves.
+ */
+static inline void systick_ms_add(volatile uint32_t *lo, volatile uint32_t *hi, uint32_t carry)
+{
+	uint32_t ms = *lo + carry;
+
+	*lo = ms;
+	if (ms < carry)
+	{
+		atomic_thread_fence(memory_order_release);	/* low word must be visible first */
+		(*hi)++;
+	}
+}
+
+/**
+ * Reads a 64 bit count kept by systick_ms_add, re-reading until the high
+ * word did not move across the read of the low one
+ */
+static inline uint64_t systick_ms_read64(const volatile uint32_t *lo, const volatile uint32_t *hi)
+{
+	uint32_t hi_word;
+	uint32_t lo_word;
+
+	do
+	{
+		hi_word = *hi;
+		atomic_thread_fence(memory_order_acquire);
+		lo_word = *lo;
+		atomic_thread_fence(memory_order_acquire);
+	} while (hi_word != *hi);
+
+	return ((((uint64_t)hi_word) << 32) | lo_word);
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*******************************************************************************
+* Title                 :   Systick Port Interface
+* Filename              :   systick_port.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_port.h
+ *  @brief Backend interface used by systick.c to reach the timer hardware.
+ *  		Every backend (STM32F411 SysTick, Linux host, ...) implements the
+ *  		functions below and is linked alongside systick.c.
+ *
+ *  The model is that of the Cortex-M SysTick: a 24 bit down-counter which
+ *  is reloaded from a reload value on underflow and raises the tick interrupt
+ *  at that point. The backend is expected to call systick_irq_handler() from
+ *  whatever its "interrupt" context is.
+ *
+ *  Readers of the tick accounting bracket their reads with
+ *  systick_port_read_begin and systick_port_read_end. On a single core the
+ *  tick interrupt completes before a reader resumes and the pair does
+ *  nothing; a backend whose "interrupt" runs on another core holds it off.
+ *
+ *  The systick_port_source_ functions run the tick sources other than
+ *  SYSTICK_1, whose interrupts call systick_instance_irq_handler().
+ *  The systick_port_defer_ functions run systick_defer_handler() at the
+ *  lowest interrupt priority.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_PORT_H
+#define _SYSTICK_PORT_H
+
+#include "systick_stm32f411_config.h"
+
+/**
+ * Largest reload value the counter supports (24 bit SysTick LOAD register)
+ */
+#define SYSTICK_PORT_RELOAD_MAX		(0x00FFFFFFUL)
+
+/**
+ * Counter clocks since the last tick edge, the 1 -> 0 transition, of a
+ * counter running with the given reload value, from a value read off it.
+ * The counter reads 0 on the edge itself and reload one clock after it.
+ */
+static inline uint32_t systick_port_clocks_since_edge(uint32_t reload, uint32_t val)
+{
+	return ((val != 0) ? (reload - val + 1UL) : 0UL);
+}
+
+void systick_port_init(systick_clock_source_t clock_source);
+uint32_t systick_port_counter_hz(systick_clock_source_t clock_source);
+uint32_t systick_port_calib_tenms(void);
+void systick_port_reload_set(uint32_t reload);
+void systick_port_load_set(uint32_t reload);
+void systick_port_interrupt_set(systick_interrupt_t interrupt_control);
+void systick_port_pause(void);
+void systick_port_resume(void);
+uint32_t systick_port_is_running(void);
+uint32_t systick_port_counter_get(void);
+uint32_t systick_port_cycle_counter_init(void);
+uint32_t systick_port_cycle_counter_get(void);
+uint32_t systick_port_tick_pending(void);
+void systick_port_tick_pending_clear(void);
+void systick_port_spin(void);
+void systick_port_sleep(void);
+void systick_port_wait_event(void);
+uint32_t systick_port_irq_save(void);
+void systick_port_irq_restore(uint32_t state);
+uint32_t systick_port_irq_raise(uint32_t priority);
+void systick_port_irq_lower(uint32_t state);
+uint32_t systick_port_read_begin(void);
+void systick_port_read_end(uint32_t state);
+uint32_t systick_port_source_start(systick_t source, uint32_t tick_freq_hz);
+void systick_port_source_stop(systick_t source);
+uint32_t systick_port_source_period_get(systick_t source, uint32_t *clock_hz);
+void systick_port_source_ack(systick_t source);
+void systick_port_defer_init(void);
+void systick_port_defer_pend(void);
+
+#endif
@@ -0,0 +1,481 @@
+/*******************************************************************************
+* Title                 :   Systick Profiler
+* Filename              :   systick_profile.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_profile.c
+ *  @brief Zone table behind systick_profile.h. The zone update is done with
+ *  		interrupts masked so zones may be used from ISRs as well; the extra
+ *  		slot at the end of the table is used only to measure the markers'
+ *  		own cost at initialisation.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_profile.h"
+#include "systick_interface.h"
+#include "systick_port.h"
+
+/**
+ * Empty zones measured to find the marker overhead, the cheapest one counts
+ */
+#define PROFILE_CALIBRATION_RUNS	(16U)
+
+/**
+ * Table slot used for the overhead calibration
+ */
+#define PROFILE_CALIBRATION_ZONE	(SYSTICK_PROFILE_MAX_ZONES)
+
+/**
+ * One row of the zone table
+ */
+typedef struct
+{
+	const char *name;			/**<Zone name, may be NULL */
+	uint32_t count;				/**<Completed measurements */
+	uint64_t total;				/**<Sum of the measured times */
+	uint32_t min;				/**<Shortest measured time */
+	uint32_t max;				/**<Longest measured time */
+}profile_zone_t;
+
+static profile_zone_t zones[SYSTICK_PROFILE_MAX_ZONES + 1U];	/**<Zone table plus calibration slot */
+static uint32_t use_cycle_counter = 0;		/**<Time from the DWT cycle counter rather than the systick */
+static uint32_t overhead = 0;				/**<Marker cost taken off every measurement */
+
+/**
+ * Current time in profiler clocks
+ */
+static uint32_t profile_timestamp(void)
+{
+	return ((use_cycle_counter != 0) ? systick_port_cycle_counter_get() : systick_get_cycles());
+}
+
+/**
+ * Clears the measurements of one zone, keeping its name
+ */
+static void profile_zone_clear(profile_zone_t *zone)
+{
+	zone->count = 0;
+	zone->total = 0;
+	zone->min = 0xFFFFFFFFUL;
+	zone->max = 0;
+}
+
+/**
+ * Adds a measurement, already less the marker overhead, to a row
+ */
+static void profile_zone_add(profile_zone_t *row, uint32_t spent)
+{
+	uint32_t state = systick_port_irq_save();
+
+	row->count++;
+	row->total += spent;
+	if (spent < row->min)
+	{
+		row->min = spent;
+	}
+	if (spent > row->max)
+	{
+		row->max = spent;
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_profile_init()
+*//**
+* \b Description:
+*
+* 	Selects the time source (the DWT cycle counter if the core has one, the
+* 	systick counter otherwise), measures the cost of an empty begin/end pair
+* 	and clears every zone. The measured cost is taken off every later
+* 	measurement and can be read with systick_profile_overhead.
+*
+*	PRE-CONDITION: The systick is running (systick_init)
+*
+*	POST-CONDITION: Every zone is empty and the markers may be used
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_init(tick_config);
+*	systick_profile_init();
+*	@endcode
+*
+*	@see	systick_profile_overhead
+*	@see	systick_profile_begin
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_profile_init(void)
+{
+	uint32_t start;
+	uint32_t i;
+
+	use_cycle_counter = systick_port_cycle_counter_init();
+	overhead = 0;
+	profile_zone_clear(&zones[PROFILE_CALIBRATION_ZONE]);
+	for (i = 0; i < PROFILE_CALIBRATION_RUNS; i++)
+	{
+		start = systick_profile_begin();
+		profile_zone_add(&zones[PROFILE_CALIBRATION_ZONE], profile_timestamp() - start);
+	}
+	overhead = zones[PROFILE_CALIBRATION_ZONE].min;
+	systick_profile_reset();
+}
+
+/******************************************************************************
+* Function: systick_profile_clock_hz()
+*//**
+* \b Description:
+*
+* 	Returns the rate of the clock the measurements are counted in: the core
+* 	clock with the DWT cycle counter, the systick counter clock otherwise
+*
+*	PRE-CONDITION: systick_profile_init has been called
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t profiler clocks per second
+*
+* \b Example:
+*
+*	@code
+*	uint32_t mean_us = (uint32_t)((stats.total * 1000000ULL) / stats.count
+*								  / systick_profile_clock_hz());
+*	@endcode
+*
+*	@see	systick_profile_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_profile_clock_hz(void)
+{
+	return ((use_cycle_counter != 0) ? SystemCoreClock : systick_counter_hz_get());
+}
+
+/******************************************************************************
+* Function: systick_profile_overhead()
+*//**
+* \b Description:
+*
+* 	Returns the cost of an empty begin/end pair as measured by
+* 	systick_profile_init. It is already taken off every measurement; it is the
+* 	price each profiled zone adds to the code around it.
+*
+*	PRE-CONDITION: systick_profile_init has been called
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t marker overhead in profiler clocks
+*
+* \b Example:
+*
+*	@code
+*	uint32_t marker_cost = systick_profile_overhead();
+*	@endcode
+*
+*	@see	systick_profile_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_profile_overhead(void)
+{
+	return (overhead);
+}
+
+/******************************************************************************
+* Function: systick_profile_name_set()
+*//**
+* \b Description:
+*
+* 	Names a zone for systick_profile_dump. The string is not copied.
+*
+*	PRE-CONDITION: zone is below SYSTICK_PROFILE_MAX_ZONES
+*	PRE-CONDITION: name stays valid (e.g. a string literal)
+*
+*	POST-CONDITION: The zone statistics carry name
+*
+*	@param		zone	zone number
+*	@param		name	zone name
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_profile_name_set(PROFILE_ZONE_FFT, "fft");
+*	@endcode
+*
+*	@see	systick_profile_dump
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_profile_name_set(uint32_t zone, const char *name)
+{
+	if (zone < SYSTICK_PROFILE_MAX_ZONES)
+	{
+		zones[zone].name = name;
+	}
+}
+
+/******************************************************************************
+* Function: systick_profile_begin()
+*//**
+* \b Description:
+*
+* 	Opens a measurement by returning the current time. Zones may nest and
+* 	may be measured from several contexts at once, as each measurement keeps
+* 	its own start time.
+*
+*	PRE-CONDITION: systick_profile_init has been called
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t start time, to be passed to systick_profile_end
+*
+* \b Example:
+*
+*	@code
+*	uint32_t start = systick_profile_begin();
+*	@endcode
+*
+*	@see	systick_profile_end
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_profile_begin(void)
+{
+	return (profile_timestamp());
+}
+
+/******************************************************************************
+* Function: systick_profile_end()
+*//**
+* \b Description:
+*
+* 	Closes a measurement and adds it to the zone's statistics, less the
+* 	marker overhead. Measurements longer than 2^32 profiler clocks wrap.
+*
+*	PRE-CONDITION: start was returned by systick_profile_begin
+*	PRE-CONDITION: zone is below SYSTICK_PROFILE_MAX_ZONES
+*
+*	POST-CONDITION: The zone statistics include the measurement
+*
+*	@param		zone	zone number
+*	@param		start	value returned by systick_profile_begin
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t start = systick_profile_begin();
+*	fft_run(samples);
+*	systick_profile_end(PROFILE_ZONE_FFT, start);
+*	@endcode
+*
+*	@see	systick_profile_begin
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_profile_end(uint32_t zone, uint32_t start)
+{
+	uint32_t spent = profile_timestamp() - start;
+
+	if (zone >= PROFILE_CALIBRATION_ZONE)
+	{
+		return;					/* out of range, or the calibration slot */
+	}
+	spent = (spent > overhead) ? (spent - overhead) : 0UL;
+	profile_zone_add(&zones[zone], spent);
+}
+
+/******************************************************************************
+* Function: systick_profile_get()
+*//**
+* \b Description:
+*
+* 	Copies out the statistics of one zone
+*
+*	PRE-CONDITION: zone is below SYSTICK_PROFILE_MAX_ZONES
+*	PRE-CONDITION: stats is non-NULL
+*
+*	POST-CONDITION: stats holds the zone statistics
+*
+*	@param		zone	zone number
+*	@param		stats	where to copy the statistics
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_profile_stats_t fft;
+*	systick_profile_get(PROFILE_ZONE_FFT, &fft);
+*	@endcode
+*
+*	@see	systick_profile_dump
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_profile_get(uint32_t zone, systick_profile_stats_t *stats)
+{
+	uint32_t state;
+
+	if (zone >= SYSTICK_PROFILE_MAX_ZONES)
+	{
+		return;
+	}
+	state = systick_port_irq_save();
+	stats->name = zones[zone].name;
+	stats->count = zones[zone].count;
+	stats->total = zones[zone].total;
+	stats->min = (zones[zone].count != 0) ? zones[zone].min : 0UL;
+	stats->max = zones[zone].max;
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_profile_reset()
+*//**
+* \b Description:
+*
+* 	Clears the measurements of every zone. Names and the measured overhead
+* 	are kept.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: Every zone is empty
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_profile_reset();
+*	@endcode
+*
+*	@see	systick_profile_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_profile_reset(void)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_PROFILE_MAX_ZONES; i++)
+	{
+		profile_zone_clear(&zones[i]);
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_profile_dump()
+*//**
+* \b Description:
+*
+* 	Calls print with the statistics of every zone measured at least once, in
+* 	zone order. Formatting and output are left to print.
+*
+*	PRE-CONDITION: print is non-NULL
+*
+*	POST-CONDITION: None
+*
+*	@param		print	function called once per measured zone
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	static void zone_print(uint32_t zone, const systick_profile_stats_t *stats)
+*	{
+*		printf("%s: %lu calls, max %lu\n", stats->name, stats->count, stats->max);
+*	}
+*
+*	systick_profile_dump(&zone_print);
+*	@endcode
+*
+*	@see	systick_profile_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_profile_dump(systick_profile_print_t print)
+{
+	systick_profile_stats_t stats;
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_PROFILE_MAX_ZONES; i++)
+	{
+		systick_profile_get(i, &stats);
+		if (stats.count != 0)
+		{
+			(*print)(i, &stats);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+/*******************************************************************************
+* Title                 :   Systick Profiler
+* Filename              :   systick_profile.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_profile.h
+ *  @brief Code section profiler. A zone is measured between
+ *  		systick_profile_begin and systick_profile_end; every zone keeps its
+ *  		call count and total, shortest and longest time in a static table of
+ *  		SYSTICK_PROFILE_MAX_ZONES entries. Times come from the DWT cycle
+ *  		counter where the core has one, otherwise from systick_get_cycles,
+ *  		and have the measured cost of the markers themselves taken off.
+ *
+ *  @code
+ *  uint32_t start = systick_profile_begin();
+ *  fft_run(samples);
+ *  systick_profile_end(PROFILE_ZONE_FFT, start);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_PROFILE_H
+#define _SYSTICK_PROFILE_H
+
+#include "systick_stm32f411_config.h"
+
+/**
+ * Statistics of one zone, in profiler clocks (see systick_profile_clock_hz)
+ */
+typedef struct
+{
+	const char *name;			/**<Name given by systick_profile_name_set, or NULL */
+	uint32_t count;				/**<Number of completed measurements */
+	uint64_t total;				/**<Sum of the measured times */
+	uint32_t min;				/**<Shortest measured time, 0 if count is 0 */
+	uint32_t max;				/**<Longest measured time */
+}systick_profile_stats_t;
+
+/**
+ * Called by systick_profile_dump for each zone measured at least once
+ */
+typedef void (*systick_profile_print_t) (uint32_t zone, const systick_profile_stats_t *stats);
+
+void systick_profile_init(void);
+uint32_t systick_profile_clock_hz(void);
+uint32_t systick_profile_overhead(void);
+void systick_profile_name_set(uint32_t zone, const char *name);
+uint32_t systick_profile_begin(void);
+void systick_profile_end(uint32_t zone, uint32_t start);
+void systick_profile_get(uint32_t zone, systick_profile_stats_t *stats);
+void systick_profile_reset(void);
+void systick_profile_dump(systick_profile_print_t print);
+
+#endif
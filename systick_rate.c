@@ -0,0 +1,534 @@
+/*******************************************************************************
+* Title                 :   Systick Rate Limiters
+* Filename              :   systick_rate.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_rate.c
+ *  @brief Token bucket, leaky bucket and sliding window limiters behind
+ *  		systick_rate.h. Every update reads the 64 bit tick, moves the state
+ *  		on to it and decides, all with interrupts masked so a preempting
+ *  		caller sees either the state before or after.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_rate.h"
+#include "systick_port.h"
+
+#define BUCKET_MAX_TOLERANCE	(0x7FFFFFFFUL)	/**<Largest lead, leaving room for one more claim */
+
+/**
+ * Greatest common divisor, used to keep the bucket time units as coarse as
+ * the rate allows
+ */
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+	uint32_t remainder;
+
+	while (b != 0)
+	{
+		remainder = a % b;
+		a = b;
+		b = remainder;
+	}
+	return (a);
+}
+
+/**
+ * Moves a bucket on to the current tick, draining its lead by the whole
+ * milliseconds since the last update. Returns the lead left, in units.
+ */
+static uint32_t bucket_update(systick_bucket_t *bucket)
+{
+	uint64_t now = systick_get_tick64();
+	uint64_t elapsed = now - bucket->updated_ms;
+
+	bucket->updated_ms = now;
+	if (elapsed > (bucket->lead / bucket->units_per_ms))
+	{
+		bucket->lead = 0;				/* drained, however long ago */
+	}
+	else
+	{
+		bucket->lead -= (uint32_t)elapsed * bucket->units_per_ms;
+	}
+	return (bucket->lead);
+}
+
+/**
+ * Sets up a bucket of depth tokens refilled tokens per period_ms, empty of
+ * backlog
+ */
+static systick_rate_status_t bucket_setup(systick_bucket_t *bucket, uint32_t tokens,
+										  uint32_t period_ms, uint32_t depth)
+{
+	uint32_t divisor;
+
+	if ((bucket == NULL) || (tokens == 0) || (period_ms == 0) || (depth == 0))
+	{
+		return (SYSTICK_RATE_INVALID);
+	}
+	divisor = gcd(tokens, period_ms);
+	if (((uint64_t)depth * (period_ms / divisor)) > BUCKET_MAX_TOLERANCE)
+	{
+		return (SYSTICK_RATE_INVALID);
+	}
+	bucket->units_per_ms = tokens / divisor;
+	bucket->units_per_token = period_ms / divisor;
+	bucket->tolerance = depth * bucket->units_per_token;
+	bucket->updated_ms = systick_get_tick64();
+	bucket->lead = 0;
+	return (SYSTICK_RATE_OK);
+}
+
+/**
+ * Claims cost units of the bucket, storing in wait the units until the claim
+ * starts draining
+ */
+static systick_rate_status_t bucket_claim(systick_bucket_t *bucket, uint32_t cost, uint32_t *wait)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t lead = bucket_update(bucket);
+	systick_rate_status_t status = SYSTICK_RATE_LIMITED;
+
+	if (((uint64_t)lead + cost) <= bucket->tolerance)
+	{
+		bucket->lead = lead + cost;
+		*wait = lead;
+		status = SYSTICK_RATE_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/**
+ * Moves a window limiter on to the window of the current tick, returning the
+ * offset into that window. A window one behind becomes the previous one,
+ * older ones are empty.
+ */
+static uint32_t window_update(systick_window_t *window)
+{
+	uint64_t tick = systick_get_tick64();
+	uint64_t index = tick / window->window_ms;
+
+	if (index == (window->index + 1ULL))
+	{
+		window->prev = window->cur;
+		window->cur = 0;
+	}
+	else if (index != window->index)
+	{
+		window->prev = 0;
+		window->cur = 0;
+	}
+	window->index = index;
+	return ((uint32_t)(tick % window->window_ms));
+}
+
+/**
+ * Events in the last window_ms, times window_ms: the current window's count
+ * plus the share of the previous window the sliding window still covers
+ */
+static uint64_t window_weight(const systick_window_t *window, uint32_t prev, uint32_t cur,
+							  uint32_t elapsed)
+{
+	return (((uint64_t)prev * (window->window_ms - elapsed)) + ((uint64_t)cur * window->window_ms));
+}
+
+/******************************************************************************
+* Function: systick_token_bucket_init()
+*//**
+* \b Description:
+*
+* 	Sets up a token bucket refilled with tokens every period_ms and holding at
+* 	most burst tokens. The rate need not be a whole number per millisecond:
+* 	3 tokens per 1000 ms is exact. The bucket starts full.
+*
+*	PRE-CONDITION: burst times period_ms, divided by the common divisor of
+*					tokens and period_ms, is below 2^31
+*
+*	POST-CONDITION: burst tokens are available
+*
+*	@param		bucket		the bucket to set up
+*	@param		tokens		tokens added per period
+*	@param		period_ms	refill period
+*	@param		burst		bucket size, the most tokens taken at once
+*
+*	@return 	systick_rate_status_t SYSTICK_RATE_OK, or SYSTICK_RATE_INVALID
+*				for a zero argument or a bucket too deep for the rate
+*
+* \b Example:
+*
+*	@code
+*	static systick_bucket_t log_limit;
+*
+*	systick_token_bucket_init(&log_limit, 20, 1000, 10);	//20 lines per second, 10 at once
+*	@endcode
+*
+*	@see	systick_token_bucket_take
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_rate_status_t systick_token_bucket_init(systick_bucket_t *bucket, uint32_t tokens,
+												uint32_t period_ms, uint32_t burst)
+{
+	return (bucket_setup(bucket, tokens, period_ms, burst));
+}
+
+/******************************************************************************
+* Function: systick_token_bucket_take()
+*//**
+* \b Description:
+*
+* 	Takes tokens from the bucket if it holds that many, after adding what has
+* 	refilled since the last call. Either all of them are taken or none.
+*
+*	PRE-CONDITION: bucket has been set up with systick_token_bucket_init
+*
+*	POST-CONDITION: On SYSTICK_RATE_OK the tokens are gone from the bucket
+*
+*	@param		bucket		the bucket
+*	@param		tokens		tokens to take, at most the burst size
+*
+*	@return 	systick_rate_status_t SYSTICK_RATE_OK, SYSTICK_RATE_LIMITED if
+*				too few tokens are left, or SYSTICK_RATE_INVALID if tokens
+*				exceeds the burst size
+*
+* \b Example:
+*
+*	@code
+*	if (systick_token_bucket_take(&log_limit, 1) == SYSTICK_RATE_OK)
+*	{
+*		uart_write(&uart2, line, length);
+*	}
+*	@endcode
+*
+*	@see	systick_token_bucket_available
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_rate_status_t systick_token_bucket_take(systick_bucket_t *bucket, uint32_t tokens)
+{
+	uint32_t wait;
+
+	if (((uint64_t)tokens * bucket->units_per_token) > bucket->tolerance)
+	{
+		return (SYSTICK_RATE_INVALID);
+	}
+	return (bucket_claim(bucket, tokens * bucket->units_per_token, &wait));
+}
+
+/******************************************************************************
+* Function: systick_token_bucket_available()
+*//**
+* \b Description:
+*
+* 	Returns the whole tokens the bucket holds now. Another caller may take
+* 	them before this one does, so use it for reporting, not as a check ahead
+* 	of systick_token_bucket_take.
+*
+*	PRE-CONDITION: bucket has been set up with systick_token_bucket_init
+*
+*	POST-CONDITION: None
+*
+*	@param		bucket		the bucket
+*
+*	@return 	uint32_t tokens available, at most the burst size
+*
+* \b Example:
+*
+*	@code
+*	printf("retries left %lu\n", systick_token_bucket_available(&retry_limit));
+*	@endcode
+*
+*	@see	systick_token_bucket_take
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_token_bucket_available(systick_bucket_t *bucket)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t lead = bucket_update(bucket);
+
+	systick_port_irq_restore(state);
+	return ((bucket->tolerance - lead) / bucket->units_per_token);
+}
+
+/******************************************************************************
+* Function: systick_leaky_bucket_init()
+*//**
+* \b Description:
+*
+* 	Sets up a leaky bucket letting events out evenly at events per period_ms,
+* 	with room for depth events waiting their turn. The bucket starts empty.
+*
+*	PRE-CONDITION: depth times period_ms, divided by the common divisor of
+*					events and period_ms, is below 2^31
+*
+*	POST-CONDITION: The next event may go at once
+*
+*	@param		bucket		the bucket to set up
+*	@param		events		events let out per period
+*	@param		period_ms	period the rate is given over
+*	@param		depth		events that may wait at once
+*
+*	@return 	systick_rate_status_t SYSTICK_RATE_OK, or SYSTICK_RATE_INVALID
+*				for a zero argument or a bucket too deep for the rate
+*
+* \b Example:
+*
+*	@code
+*	static systick_bucket_t can_pacing;
+*
+*	systick_leaky_bucket_init(&can_pacing, 1, 5, 8);	//one frame every 5 ms, 8 queued
+*	@endcode
+*
+*	@see	systick_leaky_bucket_reserve
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_rate_status_t systick_leaky_bucket_init(systick_bucket_t *bucket, uint32_t events,
+												uint32_t period_ms, uint32_t depth)
+{
+	return (bucket_setup(bucket, events, period_ms, depth));
+}
+
+/******************************************************************************
+* Function: systick_leaky_bucket_reserve()
+*//**
+* \b Description:
+*
+* 	Reserves the next free slot for one event and returns how long the caller
+* 	should wait before sending it. Unlike the token bucket, events admitted
+* 	together are spread out at the rate instead of going at once.
+*
+*	PRE-CONDITION: bucket has been set up with systick_leaky_bucket_init
+*
+*	POST-CONDITION: On SYSTICK_RATE_OK the slot is taken
+*
+*	@param		bucket		the bucket
+*	@param		wait_ms		set to the milliseconds until the event may go,
+*							rounded up, on SYSTICK_RATE_OK
+*
+*	@return 	systick_rate_status_t SYSTICK_RATE_OK, or SYSTICK_RATE_LIMITED
+*				if depth events are already waiting
+*
+* \b Example:
+*
+*	@code
+*	uint32_t wait_ms;
+*
+*	if (systick_leaky_bucket_reserve(&can_pacing, &wait_ms) == SYSTICK_RATE_OK)
+*	{
+*		systick_delay(wait_ms);
+*		can_send(&can1, &frame);
+*	}
+*	@endcode
+*
+*	@see	systick_leaky_bucket_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_rate_status_t systick_leaky_bucket_reserve(systick_bucket_t *bucket, uint32_t *wait_ms)
+{
+	systick_rate_status_t status;
+	uint32_t wait;
+
+	status = bucket_claim(bucket, bucket->units_per_token, &wait);
+	if (status == SYSTICK_RATE_OK)
+	{
+		*wait_ms = (wait / bucket->units_per_ms) + (((wait % bucket->units_per_ms) != 0) ? 1UL : 0UL);
+	}
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_window_init()
+*//**
+* \b Description:
+*
+* 	Sets up a sliding window limiter admitting limit events per window_ms.
+* 	Time is cut into fixed windows and the count of the one before the
+* 	current window is weighted by how much of it the sliding window still
+* 	covers, as if its events were spread evenly. No single fixed window ever
+* 	gets more than limit events, and steady traffic is held to the limit in
+* 	any window_ms span; a burst late in one window followed by one early in
+* 	the next can let up to twice the limit through in such a span.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: limit events are available
+*
+*	@param		window		the limiter to set up
+*	@param		limit		events per window, at least 1
+*	@param		window_ms	window length
+*
+*	@return 	systick_rate_status_t SYSTICK_RATE_OK, or SYSTICK_RATE_INVALID
+*
+* \b Example:
+*
+*	@code
+*	static systick_window_t reconnects;
+*
+*	systick_window_init(&reconnects, 5, 60000);		//5 reconnects a minute
+*	@endcode
+*
+*	@see	systick_window_take
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_rate_status_t systick_window_init(systick_window_t *window, uint32_t limit, uint32_t window_ms)
+{
+	if ((window == NULL) || (limit == 0) || (window_ms == 0))
+	{
+		return (SYSTICK_RATE_INVALID);
+	}
+	window->window_ms = window_ms;
+	window->limit = limit;
+	window->index = systick_get_tick64() / window_ms;
+	window->prev = 0;
+	window->cur = 0;
+	return (SYSTICK_RATE_OK);
+}
+
+/******************************************************************************
+* Function: systick_window_take()
+*//**
+* \b Description:
+*
+* 	Counts one event if fewer than limit events fell in the last window_ms
+*
+*	PRE-CONDITION: window has been set up with systick_window_init
+*
+*	POST-CONDITION: On SYSTICK_RATE_OK the event is counted
+*
+*	@param		window		the limiter
+*
+*	@return 	systick_rate_status_t SYSTICK_RATE_OK, or SYSTICK_RATE_LIMITED
+*
+* \b Example:
+*
+*	@code
+*	if (systick_window_take(&reconnects) != SYSTICK_RATE_OK)
+*	{
+*		return (LINK_BACKOFF);
+*	}
+*	@endcode
+*
+*	@see	systick_window_available
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_rate_status_t systick_window_take(systick_window_t *window)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t elapsed = window_update(window);
+	systick_rate_status_t status = SYSTICK_RATE_LIMITED;
+
+	if (window_weight(window, window->prev, window->cur + 1UL, elapsed)
+		<= ((uint64_t)window->limit * window->window_ms))
+	{
+		window->cur++;
+		status = SYSTICK_RATE_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_window_available()
+*//**
+* \b Description:
+*
+* 	Returns how many events systick_window_take would admit now
+*
+*	PRE-CONDITION: window has been set up with systick_window_init
+*
+*	POST-CONDITION: None
+*
+*	@param		window		the limiter
+*
+*	@return 	uint32_t events available, at most the limit
+*
+* \b Example:
+*
+*	@code
+*	if (systick_window_available(&reconnects) == 0)
+*	{
+*		led_on(LED_BACKOFF);
+*	}
+*	@endcode
+*
+*	@see	systick_window_take
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_window_available(systick_window_t *window)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t elapsed = window_update(window);
+	uint64_t used = window_weight(window, window->prev, window->cur, elapsed);
+
+	systick_port_irq_restore(state);
+	if (used >= ((uint64_t)window->limit * window->window_ms))
+	{
+		return (0);
+	}
+	return ((uint32_t)((((uint64_t)window->limit * window->window_ms) - used) / window->window_ms));
+}
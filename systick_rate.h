@@ -0,0 +1,114 @@
+/*******************************************************************************
+* Title                 :   Systick Rate Limiters
+* Filename              :   systick_rate.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_rate.h
+ *  @brief Rate limiters on the systick clock, for throttling bus retries, log
+ *  		output and the like:
+ *  - token bucket: admits up to burst events at once, refilled at the rate
+ *  - leaky bucket: queues up to depth events and tells each one how long to
+ *    wait so they leave evenly spaced at the rate
+ *  - sliding window: admits limit events per window_ms, estimated from the
+ *    counts of the current and the previous fixed window
+ *
+ *  Nothing runs per tick. Each limiter catches up from systick_get_tick64
+ *  when it is used, in a few instructions with interrupts masked, so the
+ *  calls may be made from any interrupt and from thread mode on the same
+ *  limiter. Being anchored on the 64 bit tick, no idle time however long
+ *  makes a limiter alias back to an old state.
+ *
+ *  The buckets store how far ahead of the last update their queue drains
+ *  (the virtual scheduling form of the generic cell rate algorithm) in units
+ *  of 1/tokens ms after tokens and period_ms are reduced by their common
+ *  divisor, and move that lead on by whole milliseconds, so the long run rate
+ *  is exact.
+ *
+ *  @code
+ *  static systick_bucket_t retry_limit;
+ *
+ *  systick_token_bucket_init(&retry_limit, 5, 1000, 3);	//5 per second, bursts of 3
+ *  ...
+ *  if (systick_token_bucket_take(&retry_limit, 1) == SYSTICK_RATE_OK)
+ *  {
+ *  	i2c_retry(&i2c1);
+ *  }
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_RATE_H
+#define _SYSTICK_RATE_H
+
+#include "systick_interface.h"
+
+/**
+ * Result of the rate limiter calls
+ */
+typedef enum
+{
+	SYSTICK_RATE_OK,				/**<The event is admitted */
+	SYSTICK_RATE_LIMITED,			/**<The event would exceed the rate and was not counted */
+	SYSTICK_RATE_INVALID			/**<Bad configuration, or more at once than the limiter can ever admit */
+}systick_rate_status_t;
+
+/**
+ * Token or leaky bucket
+ */
+typedef struct
+{
+	uint64_t updated_ms;			/**<systick_get_tick64 at the last update */
+	uint32_t lead;					/**<Time from updated_ms until the bucket is empty again, in units */
+	uint32_t units_per_ms;			/**<Time units per millisecond */
+	uint32_t units_per_token;		/**<Time units one token takes to refill */
+	uint32_t tolerance;				/**<Furthest drained may be ahead of now, in units */
+}systick_bucket_t;
+
+/**
+ * Sliding window limiter
+ */
+typedef struct
+{
+	uint64_t index;					/**<Number of the current window since tick 0 */
+	uint32_t prev;					/**<Events admitted in the previous window */
+	uint32_t cur;					/**<Events admitted in the current window */
+	uint32_t window_ms;				/**<Window length */
+	uint32_t limit;					/**<Events admitted per window */
+}systick_window_t;
+
+systick_rate_status_t systick_token_bucket_init(systick_bucket_t *bucket, uint32_t tokens,
+												uint32_t period_ms, uint32_t burst);
+systick_rate_status_t systick_token_bucket_take(systick_bucket_t *bucket, uint32_t tokens);
+uint32_t systick_token_bucket_available(systick_bucket_t *bucket);
+systick_rate_status_t systick_leaky_bucket_init(systick_bucket_t *bucket, uint32_t events,
+												uint32_t period_ms, uint32_t depth);
+systick_rate_status_t systick_leaky_bucket_reserve(systick_bucket_t *bucket, uint32_t *wait_ms);
+systick_rate_status_t systick_window_init(systick_window_t *window, uint32_t limit, uint32_t window_ms);
+systick_rate_status_t systick_window_take(systick_window_t *window);
+uint32_t systick_window_available(systick_window_t *window);
+
+#endif
@@ -0,0 +1,643 @@
+/*******************************************************************************
+* Title                 :   Systick Task Scheduler
+* Filename              :   systick_sched.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_sched.c
+ *  @brief Ready bitmap scheduler behind systick_sched.h. Priority p owns bit
+ *  31 - p of each map, so the highest priority ready task is the count of
+ *  leading zeros of the ready map: one CLZ instruction on the Cortex-M4,
+ *  whatever the number of tasks. The tick subscriber walks only the tasks
+ *  which are counting down, the same way. It is not called every tick: it
+ *  arms its dispatch row (systick_subscriber_due_set) for the earliest
+ *  release and then counts the ticks that went by in one step, so tickless
+ *  idle sleeps up to that release.
+ *
+ *  A release which finds the task still ready, or running, is an overrun:
+ *  the task did not complete within its period. The releases merge, so the
+ *  task runs once for both, and the overrun is counted in its statistics.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdatomic.h>
+#include <stddef.h>
+#include "systick_sched.h"
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_port.h"
+#if SYSTICK_LOAD_ENABLED
+#include "systick_load.h"
+#endif
+
+/**
+ * Bit of a priority in the task maps
+ */
+#define PRIORITY_BIT(priority)	(0x80000000UL >> (priority))
+
+/**
+ * Value of running_priority while no task runs
+ */
+#define NO_TASK					(SYSTICK_SCHED_PRIORITIES)
+
+/**
+ * One task, at the index of its priority
+ */
+typedef struct
+{
+	systick_task_t task;			/**<Body, NULL while the priority is free */
+	void *arg;						/**<Passed to the body */
+	uint32_t period;				/**<Ticks between releases, 0 for one-shot tasks */
+	uint32_t countdown;				/**<Ticks until the next release */
+	uint32_t released_at;			/**<systick_get_cycles at the pending release */
+	systick_task_stats_t stats;		/**<Run time statistics */
+}task_slot_t;
+
+static task_slot_t slots[SYSTICK_SCHED_PRIORITIES];		/**<Indexed by priority */
+static _Atomic uint32_t ready_map = 0;					/**<Tasks released and not yet started */
+static uint32_t armed_map = 0;							/**<Tasks counting down to a release */
+static volatile uint32_t running_priority = NO_TASK;	/**<Task systick_sched_run is in */
+static uint32_t armed_ticks = 1;						/**<Ticks sched_tick was last armed for */
+
+/**
+ * Highest priority in a non-empty task map
+ */
+static inline uint32_t map_first(uint32_t map)
+{
+	return ((uint32_t)__builtin_clz(map));
+}
+
+/**
+ * Zeroes the statistics of a task
+ */
+static void task_stats_clear(systick_task_stats_t *stats)
+{
+	stats->runs = 0;
+	stats->overruns = 0;
+	stats->latency_max = 0;
+	stats->exec_max = 0;
+	stats->exec_total = 0;
+}
+
+/**
+ * Marks a task ready, counting an overrun if its previous release has not
+ * completed. Runs in the tick ISR or with interrupts masked.
+ */
+static void sched_release(uint32_t priority, uint32_t now)
+{
+	task_slot_t *slot = &slots[priority];
+	uint32_t bit = PRIORITY_BIT(priority);
+
+	if ((atomic_load_explicit(&ready_map, memory_order_relaxed) & bit) != 0)
+	{
+		slot->stats.overruns++;
+		return;
+	}
+	if (running_priority == priority)
+	{
+		slot->stats.overruns++;
+	}
+	slot->released_at = now;
+	atomic_fetch_or_explicit(&ready_map, bit, memory_order_release);
+}
+
+static void sched_tick(void);
+
+/**
+ * Counts elapsed ticks against the armed tasks, releases those whose
+ * countdown has run out, and arms sched_tick for the next release. Runs in
+ * the tick ISR or with interrupts masked.
+ */
+static void sched_advance(uint32_t elapsed)
+{
+	uint32_t pending = armed_map;
+	uint32_t next = SYSTICK_DISPATCH_NEVER;
+	uint32_t now = 0;
+	uint32_t now_valid = 0;
+	uint32_t priority;
+	task_slot_t *slot;
+
+	while (pending != 0)
+	{
+		priority = map_first(pending);
+		pending &= ~PRIORITY_BIT(priority);
+		slot = &slots[priority];
+		if (slot->countdown > elapsed)
+		{
+			slot->countdown -= elapsed;
+		}
+		else
+		{
+			if (now_valid == 0)
+			{
+				now = systick_get_cycles();
+				now_valid = 1;
+			}
+			sched_release(priority, now);
+			if (slot->period == 0)
+			{
+				armed_map &= ~PRIORITY_BIT(priority);
+				continue;
+			}
+			slot->countdown = slot->period;
+		}
+		if (slot->countdown < next)
+		{
+			next = slot->countdown;
+		}
+	}
+	armed_ticks = next;
+	(void)systick_subscriber_due_set(sched_tick, next);
+}
+
+/**
+ * Tick subscriber, called when the earliest armed task is due
+ */
+static void sched_tick(void)
+{
+	sched_advance(armed_ticks);
+}
+
+/******************************************************************************
+* Function: systick_sched_init()
+*//**
+* \b Description:
+*
+* 	Removes every task and subscribes the scheduler to the tick, at position
+* 	SYSTICK_SCHED_DISPATCH_PRIORITY of the dispatch table. The subscriber is
+* 	only called on the ticks which release a task, so systick_tickless_idle
+* 	sleeps until the next release.
+*
+*	PRE-CONDITION: The systick has been initialised with its interrupt enabled
+*
+*	POST-CONDITION: No task is registered; tasks added from now on are released
+*					by the tick, unless the subscription failed
+*
+*	@return 	systick_dispatch_status_t the result of subscribing to the tick:
+*				SYSTICK_DISPATCH_FULL if the dispatch table has no free row,
+*				in which case no task will ever be released
+*
+* \b Example:
+*
+*	@code
+*	systick_init(tick_config);
+*	if (systick_sched_init() != SYSTICK_DISPATCH_OK)
+*	{
+*		error_handler();
+*	}
+*	@endcode
+*
+*	@see	systick_sched_add
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_dispatch_status_t systick_sched_init(void)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_SCHED_PRIORITIES; i++)
+	{
+		slots[i].task = NULL;
+	}
+	armed_map = 0;
+	armed_ticks = 1;
+	atomic_store_explicit(&ready_map, 0UL, memory_order_relaxed);
+	systick_sched_stats_reset();
+	systick_port_irq_restore(state);
+	return (systick_subscribe(sched_tick, 1, SYSTICK_SCHED_DISPATCH_PRIORITY));
+}
+
+/******************************************************************************
+* Function: systick_sched_add()
+*//**
+* \b Description:
+*
+* 	Registers a task at a free priority. A periodic task is first released one
+* 	period from now and every period after; a one-shot task is released once,
+* 	period ticks from now, or at once for a period of 0, and stays registered
+* 	so systick_sched_trigger can release it again.
+*
+*	PRE-CONDITION: systick_sched_init has been called
+*
+*	POST-CONDITION: The task is released as its mode and period say
+*
+*	@param 		priority	0 (highest) to SYSTICK_SCHED_PRIORITIES - 1, unique per task
+*	@param 		task		the task body
+*	@param 		arg			passed to the body on every run
+*	@param 		mode		SYSTICK_TASK_PERIODIC or SYSTICK_TASK_ONE_SHOT
+*	@param 		period		ticks between releases, or until the one release
+*
+*	@return 	systick_sched_status_t SYSTICK_SCHED_OK, SYSTICK_SCHED_BUSY if the
+*				priority is taken, SYSTICK_SCHED_INVALID for bad arguments
+*
+* \b Example:
+*
+*	@code
+*	systick_sched_add(2, &sensor_poll, &imu, SYSTICK_TASK_PERIODIC, 10);	//every 10 ticks
+*	systick_sched_add(9, &self_test, NULL, SYSTICK_TASK_ONE_SHOT, 500);		//once, in 500 ticks
+*	@endcode
+*
+*	@see	systick_sched_remove
+*	@see	systick_sched_trigger
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_sched_status_t systick_sched_add(uint32_t priority, systick_task_t task, void *arg,
+										 systick_task_mode_t mode, uint32_t period)
+{
+	systick_sched_status_t status = SYSTICK_SCHED_OK;
+	task_slot_t *slot;
+	uint32_t state;
+
+	if ((priority >= SYSTICK_SCHED_PRIORITIES) || (task == NULL)
+		|| ((mode == SYSTICK_TASK_PERIODIC) && (period == 0)))
+	{
+		return (SYSTICK_SCHED_INVALID);
+	}
+
+	slot = &slots[priority];
+	state = systick_port_irq_save();
+	if (slot->task != NULL)
+	{
+		status = SYSTICK_SCHED_BUSY;
+	}
+	else
+	{
+		slot->task = task;
+		slot->arg = arg;
+		slot->period = (mode == SYSTICK_TASK_PERIODIC) ? period : 0UL;
+		task_stats_clear(&slot->stats);
+		if (period != 0)
+		{
+			/* bring the other tasks up to now, then re-arm for the earliest */
+			sched_advance(armed_ticks - systick_subscriber_due_get(sched_tick));
+			slot->countdown = period;
+			armed_map |= PRIORITY_BIT(priority);
+			if (period < armed_ticks)
+			{
+				armed_ticks = period;
+				(void)systick_subscriber_due_set(sched_tick, period);
+			}
+		}
+		else
+		{
+			sched_release(priority, systick_get_cycles());
+		}
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_sched_remove()
+*//**
+* \b Description:
+*
+* 	Unregisters a task, dropping any pending release. A task may remove itself;
+* 	its current run completes.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The priority is free and the task is no longer run
+*
+*	@param 		priority	the task's priority
+*
+*	@return 	systick_sched_status_t SYSTICK_SCHED_OK, or SYSTICK_SCHED_NOT_FOUND
+*
+* \b Example:
+*
+*	@code
+*	systick_sched_remove(2);
+*	@endcode
+*
+*	@see	systick_sched_add
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_sched_status_t systick_sched_remove(uint32_t priority)
+{
+	systick_sched_status_t status = SYSTICK_SCHED_NOT_FOUND;
+	uint32_t state;
+
+	if (priority >= SYSTICK_SCHED_PRIORITIES)
+	{
+		return (SYSTICK_SCHED_INVALID);
+	}
+	state = systick_port_irq_save();
+	if (slots[priority].task != NULL)
+	{
+		slots[priority].task = NULL;
+		armed_map &= ~PRIORITY_BIT(priority);
+		atomic_fetch_and_explicit(&ready_map, ~PRIORITY_BIT(priority), memory_order_relaxed);
+		status = SYSTICK_SCHED_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_sched_trigger()
+*//**
+* \b Description:
+*
+* 	Releases a task now, on top of its periodic releases. Callable from
+* 	interrupts, e.g. to run a task when data arrives.
+*
+*	PRE-CONDITION: A task is registered at priority
+*
+*	POST-CONDITION: The task is ready, an overrun is counted if it already was
+*
+*	@param 		priority	the task's priority
+*
+*	@return 	systick_sched_status_t SYSTICK_SCHED_OK, or SYSTICK_SCHED_NOT_FOUND
+*
+* \b Example:
+*
+*	@code
+*	void USART2_IRQHandler(void)
+*	{
+*		rx_buffer_push(USART2->DR);
+*		systick_sched_trigger(PRIORITY_RX_PARSER);
+*	}
+*	@endcode
+*
+*	@see	systick_sched_add
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_sched_status_t systick_sched_trigger(uint32_t priority)
+{
+	systick_sched_status_t status = SYSTICK_SCHED_NOT_FOUND;
+	uint32_t state;
+
+	if (priority >= SYSTICK_SCHED_PRIORITIES)
+	{
+		return (SYSTICK_SCHED_INVALID);
+	}
+	state = systick_port_irq_save();
+	if (slots[priority].task != NULL)
+	{
+		sched_release(priority, systick_get_cycles());
+		status = SYSTICK_SCHED_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_sched_run()
+*//**
+* \b Description:
+*
+* 	Runs the highest priority ready task to completion and updates its
+* 	statistics. Called from the main loop, never from a task or an interrupt.
+*
+*	PRE-CONDITION: systick_sched_init has been called
+*
+*	POST-CONDITION: One task has run, if any was ready
+*
+*	@return 	uint32_t 1 if a task ran, 0 if none was ready
+*
+* \b Example:
+*
+*	@code
+*	for (;;)
+*	{
+*		if (systick_sched_run() == 0)
+*		{
+*			systick_sched_idle();
+*		}
+*	}
+*	@endcode
+*
+*	@see	systick_sched_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_sched_run(void)
+{
+	uint32_t map = atomic_load_explicit(&ready_map, memory_order_acquire);
+	uint32_t priority;
+	uint32_t released_at;
+	uint32_t start;
+	uint32_t exec;
+	task_slot_t *slot;
+	systick_task_t task;
+
+	if (map == 0)
+	{
+		return (0);
+	}
+
+	priority = map_first(map);
+	slot = &slots[priority];
+	task = slot->task;
+	released_at = slot->released_at;
+	running_priority = priority;				/* before the ready bit goes, so a release in between is an overrun */
+	atomic_fetch_and_explicit(&ready_map, ~PRIORITY_BIT(priority), memory_order_relaxed);
+
+	start = systick_get_cycles();
+	(*task)(slot->arg);
+	exec = systick_get_cycles() - start;
+	running_priority = NO_TASK;
+
+	slot->stats.runs++;
+	slot->stats.exec_total += exec;
+	if (exec > slot->stats.exec_max)
+	{
+		slot->stats.exec_max = exec;
+	}
+	if ((start - released_at) > slot->stats.latency_max)
+	{
+		slot->stats.latency_max = start - released_at;
+	}
+	return (1);
+}
+
+/******************************************************************************
+* Function: systick_sched_idle()
+*//**
+* \b Description:
+*
+* 	Sleeps until the next interrupt unless a task is ready. The check and the
+* 	sleep are made with interrupts masked, so a release in between still
+* 	wakes the core.
+*
+*	PRE-CONDITION: Called from the main loop
+*
+*	POST-CONDITION: An interrupt has been taken, or a task is ready
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	if (systick_sched_run() == 0)
+*	{
+*		systick_sched_idle();
+*	}
+*	@endcode
+*
+*	@see	systick_sched_run
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sched_idle(void)
+{
+	uint32_t state = systick_port_irq_save();
+
+	if (atomic_load_explicit(&ready_map, memory_order_relaxed) == 0)
+	{
+#if SYSTICK_LOAD_ENABLED
+		systick_load_idle_enter();
+		systick_port_sleep();
+		systick_load_idle_exit();
+#else
+		systick_port_sleep();
+#endif
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_sched_stats_get()
+*//**
+* \b Description:
+*
+* 	Returns a consistent copy of a task's statistics
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@param 		priority	the task's priority
+*	@param 		stats		filled with the task's statistics
+*
+*	@return 	systick_sched_status_t SYSTICK_SCHED_OK, or SYSTICK_SCHED_NOT_FOUND
+*
+* \b Example:
+*
+*	@code
+*	systick_task_stats_t stats;
+*
+*	systick_sched_stats_get(2, &stats);
+*	if (stats.overruns != 0)
+*	{
+*		log_warning("sensor_poll late %lu times, longest run %lu", stats.overruns, stats.exec_max);
+*	}
+*	@endcode
+*
+*	@see	systick_sched_stats_reset
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_sched_status_t systick_sched_stats_get(uint32_t priority, systick_task_stats_t *stats)
+{
+	systick_sched_status_t status = SYSTICK_SCHED_NOT_FOUND;
+	uint32_t state;
+
+	if (priority >= SYSTICK_SCHED_PRIORITIES)
+	{
+		return (SYSTICK_SCHED_INVALID);
+	}
+	state = systick_port_irq_save();
+	if (slots[priority].task != NULL)
+	{
+		*stats = slots[priority].stats;
+		status = SYSTICK_SCHED_OK;
+	}
+	systick_port_irq_restore(state);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_sched_stats_reset()
+*//**
+* \b Description:
+*
+* 	Clears the statistics of every task, e.g. after start-up so it does not
+* 	dominate the maxima
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: All counters and maxima are zero
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_sched_stats_reset();
+*	@endcode
+*
+*	@see	systick_sched_stats_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sched_stats_reset(void)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t i;
+
+	for (i = 0; i < SYSTICK_SCHED_PRIORITIES; i++)
+	{
+		task_stats_clear(&slots[i].stats);
+	}
+	systick_port_irq_restore(state);
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+* Title                 :   Systick Task Scheduler
+* Filename              :   systick_sched.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_sched.h
+ *  @brief Run-to-completion scheduler for periodic and one-shot tasks with
+ *  		fixed, unique priorities. The tick interrupt only marks tasks ready;
+ *  		the task bodies run in thread mode from systick_sched_run, highest
+ *  		priority first, each to completion.
+ *
+ *  @code
+ *  systick_sched_init();
+ *  systick_sched_add(0, &motor_control, NULL, SYSTICK_TASK_PERIODIC, 1);
+ *  systick_sched_add(5, &ui_refresh, &display, SYSTICK_TASK_PERIODIC, 40);
+ *
+ *  for (;;)
+ *  {
+ *  	if (systick_sched_run() == 0)
+ *  	{
+ *  		systick_sched_idle();
+ *  	}
+ *  }
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_SCHED_H
+#define _SYSTICK_SCHED_H
+
+#include "systick_stm32f411_config.h"
+#include "systick_dispatch.h"
+
+/**
+ * Number of task priorities, one task each. 0 is the highest.
+ */
+#define SYSTICK_SCHED_PRIORITIES	(32U)
+
+/**
+ * Whether a task is released once or every period
+ */
+typedef enum
+{
+	SYSTICK_TASK_ONE_SHOT,
+	SYSTICK_TASK_PERIODIC
+}systick_task_mode_t;
+
+/**
+ * Task body, run in thread mode to completion
+ */
+typedef void (*systick_task_t) (void *arg);
+
+/**
+ * Result of a scheduler call
+ */
+typedef enum
+{
+	SYSTICK_SCHED_OK,
+	SYSTICK_SCHED_INVALID,			/**<Priority out of range, NULL task or zero period */
+	SYSTICK_SCHED_BUSY,				/**<Another task holds the priority */
+	SYSTICK_SCHED_NOT_FOUND			/**<No task at the priority */
+}systick_sched_status_t;
+
+/**
+ * Run time statistics of one task. Times are in counter clocks of
+ * systick_get_cycles.
+ */
+typedef struct
+{
+	uint32_t runs;					/**<Completed runs */
+	uint32_t overruns;				/**<Releases made before the previous one completed */
+	uint32_t latency_max;			/**<Longest time from release to start */
+	uint32_t exec_max;				/**<Longest run */
+	uint64_t exec_total;			/**<Sum of all runs */
+}systick_task_stats_t;
+
+systick_dispatch_status_t systick_sched_init(void);
+systick_sched_status_t systick_sched_add(uint32_t priority, systick_task_t task, void *arg,
+										 systick_task_mode_t mode, uint32_t period);
+systick_sched_status_t systick_sched_remove(uint32_t priority);
+systick_sched_status_t systick_sched_trigger(uint32_t priority);
+uint32_t systick_sched_run(void);
+void systick_sched_idle(void);
+systick_sched_status_t systick_sched_stats_get(uint32_t priority, systick_task_stats_t *stats);
+void systick_sched_stats_reset(void);
+
+#endif
@@ -28,9 +28,8 @@
 *****************************************************************************/
 
 /** @file systick_stm32f411.c
- *  @brief Chip specific implementation of systick control. Many functions
- *  are pointers to vendor created routines due to the very specific nature
- *  of system clocks and ticks.
+ *  @brief Chip specific backend of systick control. Implements systick_port.h
+ *  on top of the Cortex-M4 SysTick peripheral.
  *
  *  @note This implementation depends on CMSIS (core_cm4.h)
  */
@@ -39,59 +38,46 @@
 *******************************************************************************/
 #include "stm32f411xe.h"
 #include "core_cm4.h"
-#include <assert.h>
-#include "systick_interface.h"
+#include "systick_port.h"
 
 /**
- * Definition of NULL in case it is not defined elsewhere
+ * Returns the clock of the APB1 timers: PCLK1, doubled when APB1 is divided
  */
-#ifndef NULL
-#define NULL (void *) 0
-#endif
-
-static volatile uint32_t tick_ms= 0;		/**<Encapsulated tick value */
-static uint32_t tick_freq;					/**<Tick frequency (increment rate) */
+static uint32_t apb1_timer_hz(void)
+{
+	uint32_t ppre1 = (RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
 
-/**
- * Callback function which will be dereferenced upon systick interrupts
- * Default value is systick_increment, but can be changed through the callback_register function
- */
-static systick_callback_t systick_callback = systick_increment;
+	if (ppre1 < 4UL)
+	{
+		return (SystemCoreClock);
+	}
+	return (SystemCoreClock >> (ppre1 - 4UL));
+}
 
 /******************************************************************************
-* Function: systick_init()
+* Function: systick_port_init()
 *//**
 * \b Description:
 *
-* 	Carries out the initialisation of the the systick based on information in the
-* 	config table
+* 	Sets the SysTick interrupt to the highest priority and selects the counter
+* 	clock source. The counter is left disabled with its interrupt masked.
 *
 *	PRE-CONDITION: The clock system (RCC) has been initialised.
-*	PRE-CONDITION: The desired frequency (tick_freq_khz) results in a number small
-*					enough to fit the 0xFFFFFF mask
-*	PRE-CONDITION: (Soft Assert) the systick is enabled through its config register
 *
-*	POST-CONDITION: The systick has been configured to count with the desired frequency
-*	POST-CONDITION: The systick interrupt has been enabled (if desired) and its priority
-*						set to maximum.
-*	POST-CONDITION: The systick clock source has been set to the desired option
+*	POST-CONDITION: The SysTick interrupt priority is set to maximum
+*	POST-CONDITION: The SysTick clock source has been set to the desired option
 *
-*	@param 		config	a pointer to the systick configuration structure
+*	@param 		clock_source	the desired SysTick clock source
 *
 *	@return 	void
 *
 * \b Example:
 *
 *	@code
-*	systick_config_t *tick_config = systick_config_get();
-*	systick_init(tick_config);
+*	systick_port_init(SYSTICK_INTERNAL_CLOCK);
 *	@endcode
 *
-*	@see	systick_config_get
-*	@see	systick_tick_freq_set
-*	@see	systick_pause
-*	@see	systick_resume
-*	@see	systick_interrupt_control
+*	@see	systick_init
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -99,54 +85,35 @@ static systick_callback_t systick_callback = systick_increment;
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_init(systick_config_t *config)
+void systick_port_init(systick_clock_source_t clock_source)
 {
-	if (config->enable_systick == SYSTICK_ENABLED)
-	{
-		systick_pause();
-		systick_tick_freq_set(config);              		/* set reload register */
-		NVIC_SetPriority(SysTick_IRQn, (0)); 									/* set Max Priority for Systick Interrupt */                                   				/* Load the SysTick Counter Value */
-		SysTick->CTRL  = config->clock_source << SysTick_CTRL_CLKSOURCE_Pos;
-		systick_interrupt_control(config->enable_systick_interrupt);
-		systick_resume();
-	}
+	NVIC_SetPriority(SysTick_IRQn, (0)); 				/* set Max Priority for Systick Interrupt */
+	SysTick->CTRL  = clock_source << SysTick_CTRL_CLKSOURCE_Pos;
 }
 
 /******************************************************************************
-* Function: systick_tick_freq_set()
+* Function: systick_port_counter_hz()
 *//**
 * \b Description:
 *
-* 	Sets the frequency of the systick update to the desired value in kHz.
+* 	Returns the frequency the SysTick counter runs at from the given clock
+* 	source: the core clock, or the core clock / 8 for the external reference.
 *
-*	PRE-CONDITION: The desired frequency (tick_freq_khz) results in a number small
-*					enough to fit the 0xFFFFFF mask
-*	PRE-CONDITION: (Soft Assert) the systick is enabled through its config register
-*	PRE-CONDITION: (Soft Assert) the systick is paused
+*	PRE-CONDITION: SystemCoreClock is up to date
 *
+*	POST-CONDITION: None
 *
-*	POST-CONDITION: The systick has been configured to count with the desired frequency
+*	@param 		clock_source	the SysTick clock source
 *
-*	@param 		config	a pointer to the systick configuration structure
-*
-*	@return 	void
+*	@return 	uint32_t counter clock in Hz
 *
 * \b Example:
 *
 *	@code
-*	systick_config_t *tick_config = systick_config_get();
-*	systick_init(tick_config);
-*	//... later ...
-*	systick_pause();
-*	tick_config->tick_freq_khz = 5; //kHz
-*	systick_tick_freq_set(tick_config);
-*	systick_resume();
+*	uint32_t reload = (systick_port_counter_hz(SYSTICK_INTERNAL_CLOCK) / 1000UL) - 1UL;
 *	@endcode
 *
-*	@see	systick_init
-*	@see	systick_config_get
-*	@see	systick_pause
-*	@see	systick_resume
+*	@see	systick_tick_freq_set
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -154,47 +121,77 @@ void systick_init(systick_config_t *config)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_tick_freq_set(systick_config_t *config)
+uint32_t systick_port_counter_hz(systick_clock_source_t clock_source)
 {
-	if (config->enable_systick == SYSTICK_ENABLED)
-	{
-		if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0)
-		{
-			uint32_t num_ticks = SystemCoreClock / (1000UL / config->tick_freq_khz);
-			assert(num_ticks - 1UL > SysTick_LOAD_RELOAD_Msk);
-			tick_freq = config->tick_freq_khz;
+	return ((clock_source == SYSTICK_INTERNAL_CLOCK) ? SystemCoreClock : (SystemCoreClock / 8UL));
+}
 
-			SysTick->LOAD = (uint32_t)(num_ticks - 1UL);
-			SysTick->VAL = 0UL;
-		}
+/******************************************************************************
+* Function: systick_port_calib_tenms()
+*//**
+* \b Description:
+*
+* 	Returns the external reference clocks in 10 ms according to the SysTick
+* 	calibration register (TENMS plus one). The value is fixed in silicon for
+* 	the clock the part was designed to run at; when SKEW is set it is itself
+* 	rounded.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t counter clocks of the external reference in 10 ms, or
+*				0 if the core reports no reference (NOREF) or no value
+*
+* \b Example:
+*
+*	@code
+*	uint32_t calib_hz = systick_port_calib_tenms() * 100UL;
+*	@endcode
+*
+*	@see	systick_calib_tenms
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_calib_tenms(void)
+{
+	uint32_t calib = SysTick->CALIB;
+	uint32_t tenms = (calib & SysTick_CALIB_TENMS_Msk) >> SysTick_CALIB_TENMS_Pos;
 
+	if (((calib & SysTick_CALIB_NOREF_Msk) != 0) || (tenms == 0))
+	{
+		return (0);
 	}
+	return (tenms + 1UL);
 }
+
 /******************************************************************************
-* Function: systick_pause()
+* Function: systick_port_reload_set()
 *//**
 * \b Description:
 *
-* 	Pauses the counting of the systick.
+* 	Writes the SysTick reload register and clears the current value so the next
+* 	count starts from the new reload.
 *
-*	PRE-CONDITION: None
+*	PRE-CONDITION: reload fits the SYSTICK_PORT_RELOAD_MAX mask
 *
+*	POST-CONDITION: SysTick->LOAD holds reload and SysTick->VAL is cleared
 *
-*	POST-CONDITION: The systick timer is paused
+*	@param 		reload	number of counter clocks per tick minus one
 *
 *	@return 	void
 *
 * \b Example:
 *
 *	@code
-*	systick_pause();
-*	//... do things....
-*	systick_resume();
+*	systick_port_reload_set((SystemCoreClock / 1000UL) - 1UL);
 *	@endcode
 *
 *	@see	systick_tick_freq_set
-*	@see	systick_resume
-
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -202,35 +199,39 @@ void systick_tick_freq_set(systick_config_t *config)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_pause(void)
+void systick_port_reload_set(uint32_t reload)
 {
-	SysTick->CTRL &= ~(SysTick_CTRL_ENABLE_Msk);
+	SysTick->LOAD = reload & SysTick_LOAD_RELOAD_Msk;
+	SysTick->VAL = 0UL;
 }
 
 /******************************************************************************
-* Function: systick_resume()
+* Function: systick_port_load_set()
 *//**
 * \b Description:
 *
-* 	Resume the counting of the systick.
+* 	Writes the SysTick reload register without touching the running count. The
+* 	new value is used from the next reload on, so the period in progress keeps
+* 	its length.
 *
-*	PRE-CONDITION: None
+*	PRE-CONDITION: reload is no larger than SYSTICK_PORT_RELOAD_MAX
+*
+*	POST-CONDITION: The next reload loads the new value
 *
-*	POST-CONDITION: The systick timer is running
+*	@param		reload	counter clocks per period minus one
 *
 *	@return 	void
 *
 * \b Example:
 *
 *	@code
-*	systick_pause();
-*	//... do things....
-*	systick_resume();
+*	systick_port_reload_set(remainder - 1UL);	//short first period
+*	systick_port_resume();
+*	systick_port_load_set(period - 1UL);		//normal periods after it
 *	@endcode
 *
-*	@see	systick_tick_freq_set
-*	@see	systick_pause
-
+*	@see	systick_port_reload_set
+*	@see	systick_tickless_idle
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -238,22 +239,21 @@ void systick_pause(void)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_resume(void)
+void systick_port_load_set(uint32_t reload)
 {
-	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = reload & SysTick_LOAD_RELOAD_Msk;
 }
 
 /******************************************************************************
-* Function: systick_interrupt_control()
+* Function: systick_port_interrupt_set()
 *//**
 * \b Description:
 *
-* 	Enables or disables the systick interrupt
-*
-*	PRE-CONDITION: (Soft Assert) The systick is paused
+* 	Enables or disables the SysTick interrupt through the TICKINT bit
 *
+*	PRE-CONDITION: None
 *
-*	POST-CONDITION: The systick interrupt is enabled or disabled, as per the input
+*	POST-CONDITION: The SysTick interrupt is enabled or disabled, as per the input
 *
 *	@param		interrupt_control Control parameter defining if the interrupt will be
 *				activated or deactivated
@@ -262,16 +262,10 @@ void systick_resume(void)
 * \b Example:
 *
 *	@code
-*	systick_pause();
-*	systick_interrupt_control(SYSTICK_INT_ENABLED);
-*	systick_resume();
+*	systick_port_interrupt_set(SYSTICK_INT_ENABLED);
 *	@endcode
 *
-*	@see	systick_init
-*	@see	systick_tick_freq_set
-*	@see	systick_pause
-*	@see	systick_resume
-
+*	@see	systick_interrupt_control
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -279,45 +273,144 @@ void systick_resume(void)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_interrupt_control(systick_interrupt_t interrupt_control)
+void systick_port_interrupt_set(systick_interrupt_t interrupt_control)
 {
-	if((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0)
+	if (interrupt_control == SYSTICK_INT_ENABLED)
 	{
-		if (interrupt_control == SYSTICK_INT_ENABLED)
-		{
-			SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
-		}
-		else
-		{
-			SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk);
-		}
+		SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
 	}
+	else
+	{
+		SysTick->CTRL &= ~(SysTick_CTRL_TICKINT_Msk);
+	}
+}
 
+/******************************************************************************
+* Function: systick_port_pause()
+*//**
+* \b Description:
+*
+* 	Stops the SysTick counter by clearing its ENABLE bit.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The SysTick counter is stopped
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_pause();
+*	@endcode
+*
+*	@see	systick_pause
+*	@see	systick_port_resume
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_pause(void)
+{
+	SysTick->CTRL &= ~(SysTick_CTRL_ENABLE_Msk);
 }
 
+/******************************************************************************
+* Function: systick_port_resume()
+*//**
+* \b Description:
+*
+* 	Starts the SysTick counter by setting its ENABLE bit.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The SysTick counter is running
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_resume();
+*	@endcode
+*
+*	@see	systick_resume
+*	@see	systick_port_pause
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_resume(void)
+{
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+}
 
 /******************************************************************************
-* Function: systick_get_tick()
+* Function: systick_port_is_running()
 *//**
 * \b Description:
 *
-* 	DReturns the current value of the tick_ms variable
+* 	Reports whether the SysTick counter is currently enabled.
 *
 *	PRE-CONDITION: None
 *
-*	POST-CONDITION: The function has returned the current value of the tick variable.
-**
-*	@return 	uint32_t the current tick value
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t non-zero if the counter is running, 0 otherwise
 *
 * \b Example:
 *
 *	@code
-*	uint32_t current_tick = systick_get_tick();
+*	if (systick_port_is_running() == 0)
+*	{
+*		systick_port_reload_set(reload);
+*	}
 *	@endcode
 *
 *	@see	systick_tick_freq_set
-*	@see	systick_delay
+*	@see	systick_interrupt_control
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_is_running(void)
+{
+	return (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk);
+}
 
+/******************************************************************************
+* Function: systick_port_spin()
+*//**
+* \b Description:
+*
+* 	Called on every iteration of the driver's busy-wait loops. A single NOP on
+* 	target; gives simulated builds a point at which virtual time can move.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	while (systick_get_tick() - start < wait_ms)
+*	{
+*		systick_port_spin();
+*	}
+*	@endcode
+*
+*	@see	systick_delay
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -325,35 +418,146 @@ void systick_interrupt_control(systick_interrupt_t interrupt_control)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-uint32_t systick_get_tick(void)
+void systick_port_spin(void)
 {
-	return(tick_ms);
+	__NOP();
 }
 
 /******************************************************************************
-* Function: systick_delay()
+* Function: systick_port_sleep()
 *//**
 * \b Description:
 *
-* 	Delays the program for the duration of delay_ms in milliseconds
+* 	Puts the core to sleep until an interrupt is pending. With interrupts
+* 	masked through PRIMASK the core still wakes up, but the handler only runs
+* 	once the mask is lifted, which lets the caller fix up the tick accounting
+* 	first.
 *
 *	PRE-CONDITION: None
 *
-*	POST-CONDITION: delay_ms have gone by and the rest of the program will resume
+*	POST-CONDITION: An interrupt is pending, or has been serviced if unmasked
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_save();
+*	systick_port_sleep();
+*	//... account the time slept ...
+*	systick_port_irq_restore(state);
+*	@endcode
+*
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_sleep(void)
+{
+	__DSB();
+	__WFI();
+	__ISB();
+}
+
+/******************************************************************************
+* Function: systick_port_wait_event()
+*//**
+* \b Description:
+*
+* 	Waits for an event (WFE). Returns at once if the event register is set,
+* 	otherwise sleeps until an interrupt is taken or another master signals
+* 	SEV; the systick interrupt bounds the wait to one tick.
 *
-*	@param		delay_ms is the length of time the user wishes to way
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: An event or interrupt has occurred
 *
 *	@return 	void
 *
 * \b Example:
 *
 *	@code
-*	systick_delay(200);
+*	while (flag == 0)
+*	{
+*		systick_port_wait_event();
+*	}
 *	@endcode
 *
-*	@see	systick_tick_freq_set
-*	@see	systick_get_tick
+*	@see	systick_wait_until
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_wait_event(void)
+{
+	__WFE();
+}
+
+/******************************************************************************
+* Function: systick_port_counter_get()
+*//**
+* \b Description:
+*
+* 	Returns the live value of the SysTick down-counter
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t the current SysTick->VAL, between 0 and the reload value
+*
+* \b Example:
+*
+*	@code
+*	uint32_t elapsed = systick_port_clocks_since_edge(reload, systick_port_counter_get());
+*	@endcode
+*
+*	@see	systick_get_cycles
+*	@see	systick_port_tick_pending
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_counter_get(void)
+{
+	return (SysTick->VAL & SysTick_VAL_CURRENT_Msk);
+}
 
+/******************************************************************************
+* Function: systick_port_cycle_counter_init()
+*//**
+* \b Description:
+*
+* 	Starts the DWT cycle counter, a free running 32 bit count of core clocks,
+* 	if the core implements it
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: DWT->CYCCNT counts core clocks from 0, if present
+*
+*	@return 	uint32_t 1 if the cycle counter is running, 0 if the core has none
+*
+* \b Example:
+*
+*	@code
+*	if (systick_port_cycle_counter_init() != 0)
+*	{
+*		start = systick_port_cycle_counter_get();
+*	}
+*	@endcode
+*
+*	@see	systick_port_cycle_counter_get
+*	@see	systick_profile_init
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -361,47 +565,38 @@ uint32_t systick_get_tick(void)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_delay(uint32_t delay_ms)
+uint32_t systick_port_cycle_counter_init(void)
 {
-	uint32_t start = systick_get_tick();
-	uint32_t current_tick = systick_get_tick();
-	if (delay_ms < 0xFFFFFFFFUL)
-	{
-		delay_ms += tick_freq;
-	}
-	while (current_tick - start < delay_ms)
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;		/* power the trace blocks */
+	if ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) != 0)
 	{
-		current_tick = systick_get_tick();
+		return (0);
 	}
+	DWT->CYCCNT = 0UL;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	return (1);
 }
 
 /******************************************************************************
-* Function: systick_increment()
+* Function: systick_port_cycle_counter_get()
 *//**
 * \b Description:
 *
-* 	Increments the tick by the number of milliseconds between systick register
-* 	overflows. Called within systick_irq_handler.
+* 	Returns the DWT cycle counter
 *
-*	PRE-CONDITION: None.
+*	PRE-CONDITION: systick_port_cycle_counter_init has returned 1
 *
-*	POST-CONDITION: tick_ms has incremented by tick_freq milliseconds
+*	POST-CONDITION: None
 *
-*	@return		void
+*	@return 	uint32_t core clocks counted, modulo 2^32
 *
 * \b Example:
-* @code
 *
-*	//By default is called automatically upon SysTick interrupt
-* 	SysTick_IRQHandler(void)
-* 	{
-* 		systick_irq_handler();
-* 	}
-* @endcode
-*
-* @see systick_callback_register
-* @see systick_irq_handler
+*	@code
+*	uint32_t spent = systick_port_cycle_counter_get() - start;
+*	@endcode
 *
+*	@see	systick_port_cycle_counter_init
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -409,41 +604,73 @@ void systick_delay(uint32_t delay_ms)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_increment(void)
+uint32_t systick_port_cycle_counter_get(void)
 {
-	tick_ms += tick_freq;
+	return (DWT->CYCCNT);
 }
 
 /******************************************************************************
-* Function: systick_callback_register()
+* Function: systick_port_tick_pending()
 *//**
 * \b Description:
 *
-* 	Registers the callback function as the desired on-interrupt functionality.
+* 	Reports whether the SysTick exception is pending, i.e. the counter has been
+* 	reloaded but systick_irq_handler has not run for that tick yet. Read from
+* 	ICSR rather than COUNTFLAG so the check has no side effects.
 *
-*	PRE-CONDITION: None.
+*	PRE-CONDITION: None
 *
-*	POST-CONDITION: the systick_callback function pointer variable now points to
-*					the desired function
+*	POST-CONDITION: None
 *
-*	@param		callback_func 	a function pointer to a void (*function)(void)
-*	@return		void
+*	@return 	uint32_t non-zero if a tick is pending, 0 otherwise
 *
 * \b Example:
-* @code
 *
-*	systick_callback_register(&interrupt_behaviour);
+*	@code
+*	if (systick_port_tick_pending() != 0)
+*	{
+*		//the counter has wrapped past the last accounted tick
+*	}
+*	@endcode
+*
+*	@see	systick_get_cycles
+*	@see	systick_port_counter_get
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_tick_pending(void)
+{
+	return (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk);
+}
+
+/******************************************************************************
+* Function: systick_port_tick_pending_clear()
+*//**
+* \b Description:
 *
-*	//the irq handler will now call interrupt_behaviour
-* 	SysTick_IRQHandler(void)
-* 	{
-* 		systick_irq_handler();
-* 	}
-* @endcode
+* 	Withdraws a pending SysTick exception through ICSR.PENDSTCLR, for callers
+* 	which have accounted the tick themselves
 *
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: No SysTick exception is pending
+*
+*	@return 	void
 *
-* @see systick_irq_handler
+* \b Example:
+*
+*	@code
+*	if (systick_port_tick_pending() != 0)
+*	{
+*		systick_port_tick_pending_clear();
+*	}
+*	@endcode
 *
+*	@see	systick_port_tick_pending
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -451,41 +678,479 @@ void systick_increment(void)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_callback_register(systick_callback_t callback_func)
+void systick_port_tick_pending_clear(void)
 {
-	systick_callback = callback_func;
+	SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
 }
 
 /******************************************************************************
-* Function: systick_irq_handler()
+* Function: systick_port_irq_save()
 *//**
 * \b Description:
 *
-* 	Calls the systick callback function. The default callback is systick_increment.
+* 	Masks interrupts through PRIMASK so the caller cannot be preempted by the
+* 	systick ISR, returning the previous mask state for systick_port_irq_restore.
+* 	Nests correctly.
 *
-*	PRE-CONDITION: The callback function is non-NULL
+*	PRE-CONDITION: None
 *
-*	POST-CONDITION: the systick_callback function is called
+*	POST-CONDITION: Interrupts are masked
 *
-
-*	@return		void
+*	@return 	uint32_t the PRIMASK value before the call
 *
 * \b Example:
-* @code
 *
-*	systick_callback_register(&interrupt_behaviour);
-*
-*	//the irq handler will now call interrupt_behaviour
-* 	SysTick_IRQHandler(void)
-* 	{
-* 		systick_irq_handler();
-* 	}
-* @endcode
+*	@code
+*	uint32_t state = systick_port_irq_save();
+*	//... touch data shared with the systick ISR ...
+*	systick_port_irq_restore(state);
+*	@endcode
 *
+*	@see	systick_port_irq_restore
+* <br><b> - CHANGE HISTORY - </b>
 *
-* @see	systick_callback_register
-* @see	systick_increment
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_irq_save(void)
+{
+	uint32_t state = __get_PRIMASK();
+
+	__disable_irq();
+	return (state);
+}
+
+/******************************************************************************
+* Function: systick_port_irq_restore()
+*//**
+* \b Description:
+*
+* 	Restores the interrupt mask state returned by systick_port_irq_save
+*
+*	PRE-CONDITION: state comes from the matching systick_port_irq_save
+*
+*	POST-CONDITION: PRIMASK is back to its state before the matching save
+*
+*	@param		state	the value returned by systick_port_irq_save
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_save();
+*	//... touch data shared with the systick ISR ...
+*	systick_port_irq_restore(state);
+*	@endcode
+*
+*	@see	systick_port_irq_save
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_irq_restore(uint32_t state)
+{
+	__set_PRIMASK(state);
+}
+
+/******************************************************************************
+* Function: systick_port_irq_raise()
+*//**
+* \b Description:
+*
+* 	Masks the interrupts of the given NVIC priority and below (numerically
+* 	greater or equal) through BASEPRI, returning the previous BASEPRI for
+* 	systick_port_irq_lower. Never lowers a mask already in place, so it nests
+* 	correctly. Priority 0 cannot be masked this way; the systick interrupt
+* 	runs at 0 on this port and is only held off by systick_port_irq_save.
+*
+*	PRE-CONDITION: 0 < priority < (1 << __NVIC_PRIO_BITS)
+*
+*	POST-CONDITION: Interrupts at priority and below are masked
+*
+*	@param		priority	the most urgent priority to mask, unshifted as
+*							for NVIC_SetPriority
+*
+*	@return 	uint32_t the BASEPRI value before the call
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_raise(SYSTICK_INSTANCE_IRQ_PRIORITY);
+*	//... touch data shared with the TIM5 tick source ...
+*	systick_port_irq_lower(state);
+*	@endcode
+*
+*	@see	systick_port_irq_lower
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_irq_raise(uint32_t priority)
+{
+	uint32_t state = __get_BASEPRI();
+
+	__set_BASEPRI_MAX(priority << (8U - __NVIC_PRIO_BITS));
+	return (state);
+}
+
+/******************************************************************************
+* Function: systick_port_irq_lower()
+*//**
+* \b Description:
+*
+* 	Restores the BASEPRI value returned by systick_port_irq_raise
+*
+*	PRE-CONDITION: state comes from the matching systick_port_irq_raise
+*
+*	POST-CONDITION: BASEPRI is back to its value before the matching raise
+*
+*	@param		state	the value returned by systick_port_irq_raise
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_irq_raise(SYSTICK_INSTANCE_IRQ_PRIORITY);
+*	//... touch data shared with the TIM5 tick source ...
+*	systick_port_irq_lower(state);
+*	@endcode
+*
+*	@see	systick_port_irq_raise
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_irq_lower(uint32_t state)
+{
+	__set_BASEPRI(state);
+}
+
+/******************************************************************************
+* Function: systick_port_read_begin()
+*//**
+* \b Description:
+*
+* 	Opens a read of the tick accounting. Nothing to do on a single core: the
+* 	tick interrupt always completes before the reader it preempted resumes,
+* 	so the readers of systick.c stay lock-free.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t unused token, pass it to systick_port_read_end
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_read_begin();
+*	//... read the tick accounting ...
+*	systick_port_read_end(state);
+*	@endcode
+*
+*	@see	systick_port_read_end
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_read_begin(void)
+{
+	return (0);
+}
+
+/******************************************************************************
+* Function: systick_port_read_end()
+*//**
+* \b Description:
+*
+* 	Closes a read opened by systick_port_read_begin
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: None
+*
+*	@param		state	the value returned by systick_port_read_begin
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	uint32_t state = systick_port_read_begin();
+*	//... read the tick accounting ...
+*	systick_port_read_end(state);
+*	@endcode
+*
+*	@see	systick_port_read_begin
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_read_end(uint32_t state)
+{
+	(void)state;
+}
+
+/******************************************************************************
+* Function: systick_port_source_start()
+*//**
+* \b Description:
+*
+* 	Starts the timer behind a tick source other than SYSTICK_1 with its update
+* 	interrupt enabled. SYSTICK_2 is TIM5, whose 32 bit auto-reload covers any
+* 	rate from 1 Hz without a prescaler; the period is rounded to the nearest
+* 	timer clock.
+*
+*	PRE-CONDITION: The clock system (RCC) has been initialised.
+*	PRE-CONDITION: TIM5_IRQHandler calls systick_instance_irq_handler(SYSTICK_2)
+*
+*	POST-CONDITION: The timer interrupts at tick_freq_hz, first one period from now
+*
+*	@param 		source			the tick source to start
+*	@param 		tick_freq_hz	the desired tick rate
+*
+*	@return 	uint32_t non-zero if started, 0 if source has no timer or the
+*				rate exceeds half the timer clock
+*
+* \b Example:
+*
+*	@code
+*	systick_port_source_start(SYSTICK_2, 20000UL);
+*	@endcode
+*
+*	@see	systick_instance_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_source_start(systick_t source, uint32_t tick_freq_hz)
+{
+	uint32_t timer_hz;
+
+	if ((source != SYSTICK_2) || (tick_freq_hz == 0))
+	{
+		return (0);
+	}
+	timer_hz = apb1_timer_hz();
+	if (tick_freq_hz > (timer_hz / 2UL))
+	{
+		return (0);
+	}
+
+	RCC->APB1ENR |= RCC_APB1ENR_TIM5EN;
+	(void)RCC->APB1ENR;									/* let the clock enable settle */
+	TIM5->CR1 = 0UL;
+	TIM5->PSC = 0UL;
+	TIM5->ARR = ((timer_hz + (tick_freq_hz / 2UL)) / tick_freq_hz) - 1UL;
+	TIM5->CNT = 0UL;
+	TIM5->EGR = TIM_EGR_UG;								/* load PSC, sets UIF */
+	TIM5->SR = 0UL;
+	TIM5->DIER = TIM_DIER_UIE;
+	NVIC_SetPriority(TIM5_IRQn, SYSTICK_INSTANCE_IRQ_PRIORITY);
+	NVIC_ClearPendingIRQ(TIM5_IRQn);
+	NVIC_EnableIRQ(TIM5_IRQn);
+	TIM5->CR1 = TIM_CR1_CEN;
+	return (1);
+}
+
+/******************************************************************************
+* Function: systick_port_source_stop()
+*//**
+* \b Description:
+*
+* 	Stops the timer behind a tick source other than SYSTICK_1 and gates its clock
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The source raises no further interrupts
+*
+*	@param 		source	the tick source to stop
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_source_stop(SYSTICK_2);
+*	@endcode
+*
+*	@see	systick_instance_deinit
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_source_stop(systick_t source)
+{
+	if (source != SYSTICK_2)
+	{
+		return;
+	}
+	NVIC_DisableIRQ(TIM5_IRQn);
+	TIM5->CR1 = 0UL;
+	TIM5->DIER = 0UL;
+	TIM5->SR = 0UL;
+	NVIC_ClearPendingIRQ(TIM5_IRQn);
+	RCC->APB1ENR &= ~RCC_APB1ENR_TIM5EN;
+}
+
+/******************************************************************************
+* Function: systick_port_source_period_get()
+*//**
+* \b Description:
+*
+* 	Returns the tick period a source actually runs at, which differs from
+* 	1 / tick_freq_hz by the rounding of the timer's auto-reload value: TIM5
+* 	counts ARR + 1 clocks of the APB1 timer clock per tick.
+*
+*	PRE-CONDITION: systick_port_source_start has started source
+*
+*	POST-CONDITION: None
+*
+*	@param 		source		the tick source
+*	@param 		clock_hz	set to the clock the period is counted in
+*
+*	@return 	uint32_t clocks per tick, 0 if source is not a started source
+*
+* \b Example:
+*
+*	@code
+*	uint32_t clock_hz;
+*	uint32_t clocks = systick_port_source_period_get(SYSTICK_2, &clock_hz);
+*	@endcode
+*
+*	@see	systick_port_source_start
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_port_source_period_get(systick_t source, uint32_t *clock_hz)
+{
+	if (source != SYSTICK_2)
+	{
+		return (0);
+	}
+	*clock_hz = apb1_timer_hz();
+	return (TIM5->ARR + 1UL);
+}
+
+/******************************************************************************
+* Function: systick_port_source_ack()
+*//**
+* \b Description:
+*
+* 	Clears the interrupt flag of a tick source's timer, first thing in its ISR
+*
+*	PRE-CONDITION: Called from the interrupt of source's timer
+*
+*	POST-CONDITION: The timer interrupt is no longer pending
+*
+*	@param 		source	the tick source whose interrupt fired
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_source_ack(SYSTICK_2);
+*	@endcode
+*
+*	@see	systick_instance_irq_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_source_ack(systick_t source)
+{
+	if (source == SYSTICK_2)
+	{
+		TIM5->SR = ~(uint32_t)TIM_SR_UIF;							/* rc_w0, leave other flags alone */
+	}
+}
+
+/******************************************************************************
+* Function: systick_port_defer_init()
+*//**
+* \b Description:
+*
+* 	Gives PendSV, which runs the deferred work, the lowest interrupt priority so
+* 	every other interrupt preempts it
+*
+*	PRE-CONDITION: PendSV_Handler calls systick_defer_handler
+*
+*	POST-CONDITION: PendSV has the lowest priority
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_defer_init();
+*	@endcode
+*
+*	@see	systick_defer_init
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_port_defer_init(void)
+{
+	NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+}
+
+/******************************************************************************
+* Function: systick_port_defer_pend()
+*//**
+* \b Description:
+*
+* 	Pends PendSV. It runs as soon as no higher priority interrupt is active.
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: PendSV is pending
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_port_defer_pend();
+*	@endcode
 *
+*	@see	systick_defer_post
 * <br><b> - CHANGE HISTORY - </b>
 *
 * <table align="left" style="width:800px">
@@ -493,8 +1158,7 @@ void systick_callback_register(systick_callback_t callback_func)
 * </table><br><br>
 * <hr>
 *******************************************************************************/
-void systick_irq_handler(void)
+void systick_port_defer_pend(void)
 {
-	assert(systick_callback != NULL);
-	(*systick_callback)();
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
 }
@@ -40,9 +40,10 @@
  * at first with default values
  */
 static const systick_config_t systick_config_table[NUM_SYSTICKS] =
-{	//ENABLED			//TICK_FREQ			//INTERRUPT 		//CLOCK
+{	//ENABLED			//TICK_FREQ_HZ		//INTERRUPT 		//CLOCK
 											//ENABLED			//SOURCE
-		{SYSTICK_ENABLED,    1,			SYSTICK_INT_ENABLED, 	SYSTICK_INTERNAL_CLOCK}
+		{SYSTICK_ENABLED,    1000,		SYSTICK_INT_ENABLED, 	SYSTICK_INTERNAL_CLOCK},
+		{SYSTICK_DISABLED,   10,		SYSTICK_INT_ENABLED, 	SYSTICK_INTERNAL_CLOCK}
 };
 
 /**
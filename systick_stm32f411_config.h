@@ -29,7 +29,9 @@
 
 /** @file systick_stm32f411_config.h
  *  @brief Chip specific header containing all relevant enums and structs
- *  		to configure the systick.
+ *  		to configure the systick. Every feature macro is only a default and
+ *  		may be overridden from the compiler command line, e.g.
+ *  		-DSYSTICK_DEFER_ENABLED=1.
  */
 /******************************************************************************
 * Includes
@@ -45,12 +47,221 @@
 extern uint32_t SystemCoreClock;
 
 /**
- * Number of systicks used simple to define the size of the config "table".
- * Some chips have multiple system timers, though.
+ * Set to 1 to advance the software timers (systick_timer.c) from systick_irq_handler
+ */
+#ifndef SYSTICK_TIMERS_ENABLED
+#define SYSTICK_TIMERS_ENABLED		1
+#endif
+
+/**
+ * Number of software timers in the statically allocated pool
+ */
+#ifndef SYSTICK_TIMER_POOL_SIZE
+#define SYSTICK_TIMER_POOL_SIZE		32
+#endif
+
+/**
+ * Number of tick subscribers the dispatch table (systick_dispatch.c) can hold
+ */
+#ifndef SYSTICK_DISPATCH_MAX_SUBSCRIBERS
+#define SYSTICK_DISPATCH_MAX_SUBSCRIBERS	8
+#endif
+
+/**
+ * Set to 1 to run the tick work which may take long at the lowest interrupt
+ * priority (systick_defer.c): systick_callback_register subscribers and
+ * software timer callbacks run from PendSV instead of the tick ISR
+ */
+#ifndef SYSTICK_DEFER_ENABLED
+#define SYSTICK_DEFER_ENABLED		0
+#endif
+
+/**
+ * Number of work items the deferred work queue holds, a power of two
+ */
+#ifndef SYSTICK_DEFER_QUEUE_SIZE
+#define SYSTICK_DEFER_QUEUE_SIZE	16
+#endif
+
+/**
+ * Set to 1 to collect latency and execution time statistics of the systick
+ * interrupt (systick_isr_stats.c). At 0 the ISR path is unchanged.
+ */
+#ifndef SYSTICK_ISR_STATS_ENABLED
+#define SYSTICK_ISR_STATS_ENABLED	0
+#endif
+
+/**
+ * Number of buckets of the ISR latency histogram
+ */
+#ifndef SYSTICK_ISR_STATS_BUCKETS
+#define SYSTICK_ISR_STATS_BUCKETS	16
+#endif
+
+/**
+ * Width of one ISR latency histogram bucket, in counter clocks
+ */
+#ifndef SYSTICK_ISR_STATS_BUCKET_CLOCKS
+#define SYSTICK_ISR_STATS_BUCKET_CLOCKS	16
+#endif
+
+/**
+ * Set to 1 to time the critical sections entered through systick_critical.h
+ * and keep the longest ones (systick_critical.c). At 0 the wrappers are the
+ * plain port mask functions.
+ */
+#ifndef SYSTICK_CRITICAL_STATS_ENABLED
+#define SYSTICK_CRITICAL_STATS_ENABLED	0
+#endif
+
+/**
+ * Number of longest critical sections kept, one per call site
+ */
+#ifndef SYSTICK_CRITICAL_TOP_N
+#define SYSTICK_CRITICAL_TOP_N		8
+#endif
+
+/**
+ * Size in bytes of the blocks the compact event log (systick_log.c) hands to
+ * storage, e.g. a flash page. Every block starts with an absolute time.
+ */
+#ifndef SYSTICK_LOG_BLOCK_SIZE
+#define SYSTICK_LOG_BLOCK_SIZE		256
+#endif
+
+/**
+ * Number of zones the profiler (systick_profile.c) keeps statistics for
+ */
+#ifndef SYSTICK_PROFILE_MAX_ZONES
+#define SYSTICK_PROFILE_MAX_ZONES	16
+#endif
+
+/**
+ * Shortest reference interval, in microseconds, over which systick_calib.c
+ * measures the counter clock error before correcting it. Longer intervals
+ * average out more reference jitter; at most 2^31 us.
+ */
+#ifndef SYSTICK_CALIB_SPAN_US
+#define SYSTICK_CALIB_SPAN_US		10000000UL
+#endif
+
+/**
+ * Largest counter clock error, in parts per billion, systick_calib.c accepts
+ * as a measurement rather than a reference glitch. Also bounds the rate
+ * estimate of systick_sync.c.
+ */
+#ifndef SYSTICK_CALIB_MAX_PPB
+#define SYSTICK_CALIB_MAX_PPB		1000000L
+#endif
+
+/**
+ * Offset, in microseconds, past which systick_sync.c steps to a new reference
+ * sample instead of slewing towards it
+ */
+#ifndef SYSTICK_SYNC_STEP_US
+#define SYSTICK_SYNC_STEP_US		100000L
+#endif
+
+/**
+ * Proportional gain of the systick_sync.c servo, in 1/256: the share of a
+ * sample's offset corrected at once
+ */
+#ifndef SYSTICK_SYNC_KP_Q8
+#define SYSTICK_SYNC_KP_Q8			32
+#endif
+
+/**
+ * Integral gain of the systick_sync.c servo, in 1/256: the share of a
+ * sample's offset, spread over the time since the last sample, added to
+ * the rate
+ */
+#ifndef SYSTICK_SYNC_KI_Q8
+#define SYSTICK_SYNC_KI_Q8			2
+#endif
+
+/**
+ * Set to 1 to count the time the driver's idle and sleep paths
+ * (systick_sched_idle, systick_delay_sleep, systick_tickless_idle) spend
+ * asleep towards the CPU load meter (systick_load.c)
+ */
+#ifndef SYSTICK_LOAD_ENABLED
+#define SYSTICK_LOAD_ENABLED		0
+#endif
+
+/**
+ * Length of the CPU load meter's measurement window, in milliseconds
+ */
+#ifndef SYSTICK_LOAD_WINDOW_MS
+#define SYSTICK_LOAD_WINDOW_MS		10
+#endif
+
+/**
+ * Time constants of the CPU load meter's short and long moving averages, in
+ * milliseconds
+ */
+#ifndef SYSTICK_LOAD_SHORT_MS
+#define SYSTICK_LOAD_SHORT_MS		1000
+#endif
+#ifndef SYSTICK_LOAD_LONG_MS
+#define SYSTICK_LOAD_LONG_MS		10000
+#endif
+
+/**
+ * Position of the CPU load meter's window snapshot in the tick dispatch table,
+ * behind the scheduler so a window closes after the tick's tasks are released
+ */
+#ifndef SYSTICK_LOAD_DISPATCH_PRIORITY
+#define SYSTICK_LOAD_DISPATCH_PRIORITY	1
+#endif
+
+/**
+ * Position of the task scheduler (systick_sched.c) in the tick dispatch table
+ */
+#ifndef SYSTICK_SCHED_DISPATCH_PRIORITY
+#define SYSTICK_SCHED_DISPATCH_PRIORITY	0
+#endif
+
+/**
+ * Size of the table of functions called by systick_reconfigure after a change
+ * of the counter clock or tick rate
+ */
+#ifndef SYSTICK_CLOCK_CHANGE_MAX_LISTENERS
+#define SYSTICK_CLOCK_CHANGE_MAX_LISTENERS	4
+#endif
+
+/**
+ * Counter clocks lost each time the tickless idle code stops the counter to
+ * reprogram it, subtracted from the reprogrammed periods. Depends on the
+ * compiler and flash wait states, so measure it on target; 0 on the simulator.
+ */
+#ifndef SYSTICK_TICKLESS_COMPENSATION
+#define SYSTICK_TICKLESS_COMPENSATION	0
+#endif
+
+/**
+ * Number of times systick_wait_until polls its predicate back to back before
+ * it starts waiting for events (WFE) between polls
+ */
+#ifndef SYSTICK_WAIT_SPIN_POLLS
+#define SYSTICK_WAIT_SPIN_POLLS		64
+#endif
+
+/**
+ * NVIC priority of the timer interrupts of the tick sources other than
+ * SYSTICK_1 (systick_instance.c)
+ */
+#ifndef SYSTICK_INSTANCE_IRQ_PRIORITY
+#define SYSTICK_INSTANCE_IRQ_PRIORITY	1
+#endif
+
+/**
+ * Tick sources, indexing the config "table". SYSTICK_1 is the core SysTick,
+ * SYSTICK_2 the 32 bit general purpose timer TIM5 used as a second tick.
  */
 typedef enum
 {
 	SYSTICK_1,
+	SYSTICK_2,
 	NUM_SYSTICKS
 }systick_t;
 
@@ -90,8 +301,8 @@ typedef struct
 {
 	systick_enabled_t enable_systick; /**<Whether or not the systick should be
 			enabled. Recommended value is SYSTICK_ENABLED*/
-	uint32_t tick_freq_khz;	/**<How quickly the systick should trigger in kHz.
-	 	 	Recommended value is 1 */
+	uint32_t tick_freq_hz;	/**<How quickly the systick should trigger in Hz. Need
+			not divide the counter clock. Recommended value is 1000 */
 	systick_interrupt_t enable_systick_interrupt; /**< Whether or not the systick
 			interrupt should be enabled. Recommended value si SYSTICK_INT_ENABLED. */
 	systick_clock_source_t clock_source; /**< The systick clock source. Recommended
@@ -0,0 +1,315 @@
+/*******************************************************************************
+* Title                 :   Systick Reference Clock Sync
+* Filename              :   systick_sync.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_sync.c
+ *  @brief PI servo behind systick_sync.h. Every sample moves the mapping's
+ *  		origin to the sample's local time, at the reference time the old
+ *  		mapping predicted plus SYSTICK_SYNC_KP_Q8 of the offset, and adds
+ *  		SYSTICK_SYNC_KI_Q8 of the offset, as a rate over the time since the
+ *  		last sample, to the rate. With the default gains an offset decays
+ *  		by about 6 % per sample and an eighth of the sample jitter reaches
+ *  		the mapping; raise the gains for a reference with little jitter.
+ *
+ *  Updates and conversions run with interrupts masked for a few
+ *  instructions, so either may be called from an ISR.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_sync.h"
+#include "systick_port.h"
+
+#define PPB_PER_UNIT	1000000000LL	/**<Parts per billion in one */
+#define NS_PER_US		1000LL			/**<Nanoseconds in a microsecond */
+
+/**
+ * Reference time of local_us under the current mapping, in ns
+ */
+static int64_t sync_map(const systick_sync_t *sync, uint32_t local_us)
+{
+	int64_t delta = (int32_t)(local_us - sync->anchor_local);
+
+	return ((int64_t)sync->anchor_reference + (delta * NS_PER_US)
+			+ ((delta * sync->rate_ppb) / (PPB_PER_UNIT / NS_PER_US)));
+}
+
+/**
+ * Limits a rate estimate to SYSTICK_CALIB_MAX_PPB
+ */
+static int32_t sync_rate_clamp(int64_t rate_ppb)
+{
+	if (rate_ppb > SYSTICK_CALIB_MAX_PPB)
+	{
+		rate_ppb = SYSTICK_CALIB_MAX_PPB;
+	}
+	else if (rate_ppb < -SYSTICK_CALIB_MAX_PPB)
+	{
+		rate_ppb = -SYSTICK_CALIB_MAX_PPB;
+	}
+	return ((int32_t)rate_ppb);
+}
+
+/**
+ * Checks an offset in ns against SYSTICK_SYNC_STEP_US
+ */
+static uint32_t sync_is_step(int64_t offset_ns)
+{
+	return ((offset_ns > (SYSTICK_SYNC_STEP_US * NS_PER_US)) || (offset_ns < -(SYSTICK_SYNC_STEP_US * NS_PER_US)));
+}
+
+/**
+ * Moves the mapping's origin to a sample
+ */
+static void sync_anchor(systick_sync_t *sync, uint32_t local_us, uint64_t reference_ns)
+{
+	sync->anchor_local = local_us;
+	sync->anchor_reference = reference_ns;
+}
+
+/******************************************************************************
+* Function: systick_sync_init()
+*//**
+* \b Description:
+*
+* 	Clears a mapping to the unsynced state, with no rate estimate
+*
+*	PRE-CONDITION: None
+*
+*	POST-CONDITION: The next sample sets the offset
+*
+*	@param		sync	the mapping to clear
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	static systick_sync_t gateway;
+*
+*	systick_sync_init(&gateway);
+*	@endcode
+*
+*	@see	systick_sync_update
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_sync_init(systick_sync_t *sync)
+{
+	uint32_t state = systick_port_irq_save();
+
+	sync_anchor(sync, 0, 0);
+	sync->rate_ppb = 0;
+	sync->offset_us = 0;
+	sync->steps = 0;
+	sync->state = SYSTICK_SYNC_UNSYNCED;
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_sync_update()
+*//**
+* \b Description:
+*
+* 	Feeds one sample of the reference clock to the servo. The first sample
+* 	sets the offset and the second the rate, from the two of them. From
+* 	then on each sample corrects both through the PI servo, or steps the
+* 	mapping to the sample if it is off by more than SYSTICK_SYNC_STEP_US.
+* 	The rate is kept across steps. A sample more than
+* 	SYSTICK_SYNC_MAX_INTERVAL_US after the previous one cannot be placed in
+* 	the 32 bit local time and is rejected; after such a gap the mapping must
+* 	be restarted with systick_sync_init.
+*
+*	PRE-CONDITION: sync has been set up with systick_sync_init
+*	PRE-CONDITION: local_us is later than the previous sample's local time
+*
+*	POST-CONDITION: The mapping includes the sample, unless it was rejected
+*
+*	@param		sync			the mapping
+*	@param		local_us		systick_get_time_us when the reference time was valid
+*	@param		reference_us	reference time of the sample, in us
+*
+*	@return 	systick_sync_state_t the state after the sample,
+*				SYSTICK_SYNC_STEPPED if the mapping was stepped, or
+*				SYSTICK_SYNC_REJECTED if the sample was too late and ignored
+*
+* \b Example:
+*
+*	@code
+*	if (systick_sync_update(&gateway, rx_local_us, gateway_us) == SYSTICK_SYNC_STEPPED)
+*	{
+*		log_event(LOG_TIME_STEP, gateway.offset_us);
+*	}
+*	@endcode
+*
+*	@see	systick_sync_to_reference
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_sync_state_t systick_sync_update(systick_sync_t *sync, uint32_t local_us, uint64_t reference_us)
+{
+	uint32_t state = systick_port_irq_save();
+	uint32_t elapsed = local_us - sync->anchor_local;
+	uint64_t reference_ns = reference_us * (uint64_t)NS_PER_US;
+	systick_sync_state_t result;
+	int64_t predicted = 0;
+	int64_t offset;
+
+	if ((sync->state != SYSTICK_SYNC_UNSYNCED) && (elapsed > SYSTICK_SYNC_MAX_INTERVAL_US))
+	{
+		systick_port_irq_restore(state);
+		return (SYSTICK_SYNC_REJECTED);
+	}
+	if (sync->state == SYSTICK_SYNC_UNSYNCED)
+	{
+		sync->state = SYSTICK_SYNC_LOCKING;
+		offset = 0;
+	}
+	else
+	{
+		predicted = sync_map(sync, local_us);
+		offset = (int64_t)reference_ns - predicted;
+	}
+
+	if (sync_is_step(offset) != 0)
+	{
+		sync->steps++;
+		result = SYSTICK_SYNC_STEPPED;
+	}
+	else if ((sync->state == SYSTICK_SYNC_LOCKING) && (elapsed != 0))
+	{
+		/* second sample: the whole offset is rate error since the first */
+		sync->rate_ppb = sync_rate_clamp(sync->rate_ppb
+										 + ((offset * (PPB_PER_UNIT / NS_PER_US)) / (int64_t)elapsed));
+		sync->state = SYSTICK_SYNC_LOCKED;
+		result = SYSTICK_SYNC_LOCKED;
+	}
+	else if ((sync->state == SYSTICK_SYNC_LOCKED) && (elapsed != 0))
+	{
+		sync->rate_ppb = sync_rate_clamp(sync->rate_ppb
+										 + ((offset * (PPB_PER_UNIT / NS_PER_US) * SYSTICK_SYNC_KI_Q8)
+											/ ((int64_t)elapsed * 256LL)));
+		reference_ns = (uint64_t)(predicted + ((offset * SYSTICK_SYNC_KP_Q8) / 256LL));
+		result = SYSTICK_SYNC_LOCKED;
+	}
+	else
+	{
+		result = sync->state;
+	}
+	offset /= NS_PER_US;
+	sync->offset_us = (int32_t)((offset > INT32_MAX) ? INT32_MAX : ((offset < INT32_MIN) ? INT32_MIN : offset));
+	sync_anchor(sync, local_us, reference_ns);
+	systick_port_irq_restore(state);
+	return (result);
+}
+
+/******************************************************************************
+* Function: systick_sync_to_reference()
+*//**
+* \b Description:
+*
+* 	Converts a local timestamp to reference time under the current mapping,
+* 	in constant time
+*
+*	PRE-CONDITION: local_us is within 2^31 us of the last sample
+*
+*	POST-CONDITION: None
+*
+*	@param		sync		the mapping
+*	@param		local_us	systick_get_time_us value to convert
+*
+*	@return 	uint64_t reference time in us, 0 while unsynced
+*
+* \b Example:
+*
+*	@code
+*	record.time_us = systick_sync_to_reference(&gateway, capture_local_us);
+*	@endcode
+*
+*	@see	systick_sync_update
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint64_t systick_sync_to_reference(systick_sync_t *sync, uint32_t local_us)
+{
+	uint32_t state = systick_port_irq_save();
+	int64_t reference_ns = (sync->state != SYSTICK_SYNC_UNSYNCED) ? sync_map(sync, local_us) : 0;
+
+	systick_port_irq_restore(state);
+	return ((uint64_t)reference_ns / (uint64_t)NS_PER_US);
+}
+
+/******************************************************************************
+* Function: systick_sync_state_get()
+*//**
+* \b Description:
+*
+* 	Returns whether the mapping tracks the reference yet
+*
+*	PRE-CONDITION: sync has been set up with systick_sync_init
+*
+*	POST-CONDITION: None
+*
+*	@param		sync	the mapping
+*
+*	@return 	systick_sync_state_t SYSTICK_SYNC_UNSYNCED, SYSTICK_SYNC_LOCKING
+*				or SYSTICK_SYNC_LOCKED
+*
+* \b Example:
+*
+*	@code
+*	if (systick_sync_state_get(&gateway) != SYSTICK_SYNC_LOCKED)
+*	{
+*		record.flags |= RECORD_TIME_UNCERTAIN;
+*	}
+*	@endcode
+*
+*	@see	systick_sync_update
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_sync_state_t systick_sync_state_get(systick_sync_t *sync)
+{
+	return (sync->state);
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+* Title                 :   Systick Reference Clock Sync
+* Filename              :   systick_sync.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_sync.h
+ *  @brief Maps local timestamps to the time of a reference clock, e.g. the
+ *  		wall clock of a gateway, so device events can be stamped in
+ *  		reference time on the device.
+ *
+ *  Each (local time, reference time) pair fed to systick_sync_update drives
+ *  a PI servo in fixed point. The proportional part corrects the offset and
+ *  the integral part the rate. Offsets beyond SYSTICK_SYNC_STEP_US are
+ *  stepped to at once, so a reference that jumps is followed at the next
+ *  sample. Conversion is one subtraction, one multiply and one division,
+ *  whatever the history.
+ *
+ *  Local times are systick_get_time_us values. A millisecond tick multiplied
+ *  by 1000 is the same time base at a coarser resolution. Local times are
+ *  converted relative to the last sample and must be within
+ *  SYSTICK_SYNC_MAX_INTERVAL_US, 2^31 us or about 35 minutes, of it; a sample
+ *  further on than that is rejected. Reference times are kept in nanoseconds internally, so
+ *  they must stay below 2^63 ns; the Unix epoch in microseconds does.
+ *
+ *  @code
+ *  static systick_sync_t gateway;
+ *
+ *  systick_sync_init(&gateway);
+ *  ...
+ *  void time_beacon_received(uint64_t gateway_us, uint32_t rx_local_us)
+ *  {
+ *  	systick_sync_update(&gateway, rx_local_us, gateway_us);
+ *  }
+ *  ...
+ *  event.time_us = systick_sync_to_reference(&gateway, systick_get_time_us());
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_SYNC_H
+#define _SYSTICK_SYNC_H
+
+#include "systick_interface.h"
+
+/**
+ * Longest local time between two samples, in microseconds (2^31 - 1, about
+ * 35 minutes). Past it the 32 bit local time can no longer be ordered.
+ */
+#define SYSTICK_SYNC_MAX_INTERVAL_US	(0x7FFFFFFFUL)
+
+/**
+ * Servo state, also the result of systick_sync_update
+ */
+typedef enum
+{
+	SYSTICK_SYNC_UNSYNCED,			/**<No sample yet, conversions return 0 */
+	SYSTICK_SYNC_LOCKING,			/**<One sample: offset known, rate not yet */
+	SYSTICK_SYNC_LOCKED,			/**<Offset and rate are tracked */
+	SYSTICK_SYNC_STEPPED,			/**<The sample was too far off and was stepped to (result only) */
+	SYSTICK_SYNC_REJECTED			/**<The sample came too long after the last and was ignored (result only) */
+}systick_sync_state_t;
+
+/**
+ * Mapping from local to reference time. The mapping is the pair anchor_local,
+ * anchor_reference plus rate; the remaining fields describe the servo.
+ */
+typedef struct
+{
+	uint32_t anchor_local;			/**<Local time of the mapping's origin, in us */
+	uint64_t anchor_reference;		/**<Reference time of that origin, in ns */
+	int32_t rate_ppb;				/**<Reference clock rate minus the local rate, in ppb of local time */
+	int32_t offset_us;				/**<Offset of the last sample from the mapping, in us, saturated */
+	uint32_t steps;					/**<Times the mapping has been stepped */
+	systick_sync_state_t state;		/**<Servo state */
+}systick_sync_t;
+
+void systick_sync_init(systick_sync_t *sync);
+systick_sync_state_t systick_sync_update(systick_sync_t *sync, uint32_t local_us, uint64_t reference_us);
+uint64_t systick_sync_to_reference(systick_sync_t *sync, uint32_t local_us);
+systick_sync_state_t systick_sync_state_get(systick_sync_t *sync);
+
+#endif
@@ -0,0 +1,263 @@
+/*******************************************************************************
+* Title                 :   Systick Tickless Idle
+* Filename              :   systick_tickless.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_tickless.c
+ *  @brief Tickless idle on top of the port interface.
+ *
+ *  With interrupts masked, the counter is stopped and reloaded so that it
+ *  next underflows at the end of the last tick before something is due: the
+ *  clocks left in the current tick plus whole tick periods, capped by the 24
+ *  bit reload. The core then sleeps. On wake-up the counter value says exactly
+ *  how far into the window it got. The ticks passed are credited in one go,
+ *  and a short first period re-aligns the counter to the original tick grid.
+ *  Sleeping the full window leaves the final tick pending, so its interrupt runs
+ *  normally once the mask is lifted.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include "systick_tickless.h"
+#include "systick_interface.h"
+#include "systick_port.h"
+#include "systick_dispatch.h"
+#if SYSTICK_TIMERS_ENABLED
+#include "systick_timer.h"
+#endif
+#if SYSTICK_DEFER_ENABLED
+#include "systick_defer.h"
+#endif
+#if SYSTICK_LOAD_ENABLED
+#include "systick_load.h"
+#endif
+
+/**
+ * Shortest idle stretch worth reprogramming the counter for; below it the
+ * core just sleeps until the next tick
+ */
+#define TICKLESS_MIN_IDLE_TICKS		(2UL)
+
+/**
+ * Number of interrupts from now on which something is due, capped by the
+ * caller's limit
+ */
+static uint32_t tickless_idle_ticks(uint32_t max_idle_ticks)
+{
+	uint32_t idle_ticks = max_idle_ticks;
+	uint32_t due;
+
+#if SYSTICK_TIMERS_ENABLED
+	due = systick_timer_next_expiry();
+	if (due < idle_ticks)
+	{
+		idle_ticks = due;
+	}
+#endif
+	due = systick_dispatch_next_due();
+	if (due < idle_ticks)
+	{
+		idle_ticks = due;
+	}
+#if SYSTICK_DEFER_ENABLED
+	due = systick_defer_next_due();
+	if (due < idle_ticks)
+	{
+		idle_ticks = due;
+	}
+#endif
+	return (idle_ticks);
+}
+
+/**
+ * Accounts ticks which elapsed without an interrupt
+ */
+static void tickless_catch_up(uint32_t ticks)
+{
+	if (ticks != 0)
+	{
+		systick_tick_advance(ticks);
+#if SYSTICK_TIMERS_ENABLED
+		systick_timer_skip(ticks);
+#endif
+		systick_dispatch_skip(ticks);
+#if SYSTICK_DEFER_ENABLED
+		systick_defer_skip(ticks);
+#endif
+	}
+}
+
+/******************************************************************************
+* Function: systick_tickless_idle()
+*//**
+* \b Description:
+*
+* 	Sleeps until the next software timer expiry or subscriber call (deferred
+* 	subscribers of systick_defer.h included), or for max_idle_ticks ticks,
+* 	whichever comes first, taking no tick interrupts in between. The sleep is also cut short by the 24 bit reload limit (about
+* 	167 ticks at 100 MHz and 1 kHz) and by any other interrupt. On return
+* 	systick_get_tick and the high resolution timestamps are exactly where they
+* 	would have been had every tick been taken; the tick grid is not shifted.
+*
+* 	A subscriber with divider 1 (including a callback installed with
+* 	systick_callback_register) is due on every tick, in which case this is a
+* 	plain sleep until the next tick.
+*
+*	PRE-CONDITION: Called from thread mode, typically the idle loop
+*	PRE-CONDITION: The systick is running with its interrupt enabled
+*
+*	POST-CONDITION: The tick accounting, the timers and the subscribers have
+*					caught up with the time slept
+*
+*	@param		max_idle_ticks	longest sleep the caller allows, in ticks
+*								(SYSTICK_TICKLESS_NO_LIMIT for no limit)
+*
+*	@return 	uint32_t number of ticks credited without an interrupt
+*
+* \b Example:
+*
+*	@code
+*	for (;;)
+*	{
+*		if (work_pending() == 0)
+*		{
+*			systick_tickless_idle(SYSTICK_TICKLESS_NO_LIMIT);
+*		}
+*		work_run();
+*	}
+*	@endcode
+*
+*	@see	systick_timer_next_expiry
+*	@see	systick_dispatch_next_due
+*	@see	systick_defer_next_due
+*	@see	systick_tick_advance
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_tickless_idle(uint32_t max_idle_ticks)
+{
+	uint32_t period = systick_tick_reload_get() + 1UL;
+	uint32_t state = systick_port_irq_save();
+	uint32_t idle_ticks = tickless_idle_ticks(max_idle_ticks);
+	uint32_t limit;
+	uint32_t entry_val;
+	uint32_t sleep_reload;
+	uint32_t val;
+	uint32_t elapsed;
+	uint32_t skipped;
+	uint32_t remainder;
+
+#if SYSTICK_LOAD_ENABLED
+	systick_load_idle_enter();		/* the whole stretch is idle, measured before the counter is reprogrammed */
+#endif
+	if (idle_ticks < TICKLESS_MIN_IDLE_TICKS)
+	{
+		systick_port_sleep();
+#if SYSTICK_LOAD_ENABLED
+		systick_load_idle_exit();
+#endif
+		systick_port_irq_restore(state);
+		return (0);
+	}
+
+	systick_port_pause();
+	entry_val = systick_port_counter_get();
+	if (entry_val == 0)
+	{
+		entry_val = period;		/* at the reload edge, a whole tick ahead */
+	}
+	if ((systick_port_tick_pending() != 0) || (entry_val <= (SYSTICK_TICKLESS_COMPENSATION + 1UL)))
+	{
+		/* the tick is (about to be) due, just sleep until its interrupt */
+		systick_port_resume();
+		systick_port_sleep();
+#if SYSTICK_LOAD_ENABLED
+		systick_load_idle_exit();
+#endif
+		systick_port_irq_restore(state);
+		return (0);
+	}
+	entry_val -= SYSTICK_TICKLESS_COMPENSATION;
+
+	/* underflow at the end of the last idle tick: what is left of this one
+	 * plus whole periods */
+	limit = ((SYSTICK_PORT_RELOAD_MAX + 1UL - entry_val) / period) + 1UL;
+	if (idle_ticks > limit)
+	{
+		idle_ticks = limit;
+	}
+	sleep_reload = entry_val + ((idle_ticks - 1UL) * period) - 1UL;
+	systick_port_reload_set(sleep_reload);
+	systick_port_resume();
+
+	systick_port_sleep();
+
+	systick_port_pause();
+	val = systick_port_counter_get();
+	elapsed = systick_port_clocks_since_edge(sleep_reload, val);
+	if (systick_port_tick_pending() != 0)
+	{
+		/* slept the whole window: the pending interrupt accounts the last tick,
+		 * elapsed is how far the counter got into the next one */
+		skipped = (idle_ticks - 1UL) + (elapsed / period);
+		remainder = period - (elapsed % period);
+	}
+	else if (elapsed < entry_val)
+	{
+		/* woken by another interrupt before the current tick ended */
+		skipped = 0;
+		remainder = entry_val - elapsed;
+	}
+	else
+	{
+		/* woken by another interrupt part way through the window */
+		elapsed -= entry_val;
+		skipped = 1UL + (elapsed / period);
+		remainder = period - (elapsed % period);
+	}
+	if (remainder <= (SYSTICK_TICKLESS_COMPENSATION + 1UL))
+	{
+		/* too close to the tick edge to reprogram, account that tick now */
+		skipped++;
+		remainder += period;
+	}
+
+	/* short period up to the next tick edge, normal periods after it */
+	systick_port_reload_set(remainder - 1UL - SYSTICK_TICKLESS_COMPENSATION);
+	systick_port_resume();
+	systick_port_load_set(period - 1UL);
+
+	tickless_catch_up(skipped);
+#if SYSTICK_LOAD_ENABLED
+	systick_load_idle_exit();		/* after the catch up, when the cycle count is right again */
+#endif
+	systick_port_irq_restore(state);
+	return (skipped);
+}
@@ -0,0 +1,51 @@
+/*******************************************************************************
+* Title                 :   Systick Tickless Idle
+* Filename              :   systick_tickless.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_tickless.h
+ *  @brief Tickless idle. Instead of waking on every tick, the idle loop
+ *  		stretches the counter period up to the next software timer expiry
+ *  		or subscriber call, sleeps through it and credits the ticks it
+ *  		skipped, so systick_get_tick reads as if every interrupt had been
+ *  		taken.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_TICKLESS_H
+#define _SYSTICK_TICKLESS_H
+
+#include "systick_stm32f411_config.h"
+
+/**
+ * Pass to systick_tickless_idle to sleep for as long as nothing is due
+ */
+#define SYSTICK_TICKLESS_NO_LIMIT	(0xFFFFFFFFUL)
+
+uint32_t systick_tickless_idle(uint32_t max_idle_ticks);
+
+#endif
@@ -0,0 +1,803 @@
+/*******************************************************************************
+* Title                 :   Systick Software Timers
+* Filename              :   systick_timer.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_timer.c
+ *  @brief Hierarchical timing wheel behind the systick software timers.
+ *
+ *  The wheel has WHEEL_LEVELS levels of WHEEL_SLOTS slots. Level 0 holds
+ *  timers due within the next 64 ticks, one slot per tick; each further level
+ *  covers 64 times the span of the one below. Every tick the current level 0
+ *  slot is emptied, and every 64 ticks one slot of the next level is cascaded
+ *  (re-sorted) into the levels below, which keeps expiry amortised O(1) per
+ *  timer. Slots are circular doubly linked lists, so insert and cancel are O(1).
+ *  Timers further out than the wheel span park in the top level and are
+ *  re-sorted each time their slot comes round.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_timer.h"
+#include "systick_port.h"
+#if SYSTICK_DEFER_ENABLED
+#include "systick_defer.h"
+#endif
+
+#define WHEEL_LEVELS		(4U)							/**<Number of wheel levels */
+#define WHEEL_BITS			(6U)							/**<Tick bits resolved per level */
+#define WHEEL_SLOTS			(1UL << WHEEL_BITS)				/**<Slots per level */
+#define WHEEL_MASK			(WHEEL_SLOTS - 1UL)				/**<Slot index mask */
+#define WHEEL_MAX_DELTA		((1UL << (WHEEL_LEVELS * WHEEL_BITS)) - 1UL)	/**<Wheel span in ticks */
+
+/**
+ * Intrusive list link, also used as the slot list heads
+ */
+typedef struct timer_node
+{
+	struct timer_node *next;
+	struct timer_node *prev;
+}timer_node_t;
+
+/**
+ * Software timer. The link must stay the first member.
+ */
+struct systick_timer
+{
+	timer_node_t node;					/**<Link in a wheel slot or in the free list */
+	uint32_t expires;					/**<Tick number on which the timer fires */
+	uint32_t period;					/**<Ticks between firings of a periodic timer */
+	systick_timer_callback_t callback;	/**<Function called on expiry */
+	void *arg;							/**<Argument passed to the callback */
+	systick_timer_mode_t mode;			/**<One-shot or periodic */
+	uint8_t allocated;					/**<Non-zero while owned by a user */
+	uint8_t active;						/**<Non-zero while queued in the wheel */
+#if SYSTICK_DEFER_ENABLED
+	uint8_t unposted;					/**<Non-zero while a firing waits on retry_list for the defer queue */
+	uint32_t queued;					/**<Firings in the defer queue */
+	uint32_t stale;						/**<Oldest of queued to skip, posted before a stop, start or delete */
+	struct systick_timer *retry_next;	/**<Link in retry_list */
+#endif
+};
+
+static struct systick_timer timer_pool[SYSTICK_TIMER_POOL_SIZE];	/**<Statically allocated timers */
+static timer_node_t free_list;										/**<Unallocated timers */
+static timer_node_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];				/**<Slot list heads */
+static uint32_t wheel_next = 0;										/**<Next tick number to process */
+#if SYSTICK_DEFER_ENABLED
+static systick_timer_t *retry_list = NULL;							/**<Timers whose firing met a full defer queue */
+#endif
+
+/**
+ * Makes head an empty list
+ */
+static void list_init(timer_node_t *head)
+{
+	head->next = head;
+	head->prev = head;
+}
+
+/**
+ * Appends node at the tail of the list headed by head
+ */
+static void list_add_tail(timer_node_t *head, timer_node_t *node)
+{
+	node->prev = head->prev;
+	node->next = head;
+	head->prev->next = node;
+	head->prev = node;
+}
+
+/**
+ * Unlinks node from whatever list it is on
+ */
+static void list_del(timer_node_t *node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	list_init(node);
+}
+
+/**
+ * Moves every node of the list headed by from to the empty list headed by to
+ */
+static void list_move_all(timer_node_t *from, timer_node_t *to)
+{
+	if (from->next == from)
+	{
+		list_init(to);
+	}
+	else
+	{
+		to->next = from->next;
+		to->prev = from->prev;
+		to->next->prev = to;
+		to->prev->next = to;
+		list_init(from);
+	}
+}
+
+/**
+ * Queues a timer in the slot matching its expiry. Interrupts must be masked
+ * or the caller must be the systick ISR.
+ */
+static void wheel_insert(systick_timer_t *timer)
+{
+	uint32_t expires = timer->expires;
+	uint32_t delta = expires - wheel_next;
+	uint32_t level = 0;
+	timer_node_t *slot;
+
+	if ((int32_t)delta < 0)
+	{
+		slot = &wheel[0][wheel_next & WHEEL_MASK];		/* already due, fire on the next tick */
+	}
+	else
+	{
+		if (delta > WHEEL_MAX_DELTA)
+		{
+			delta = WHEEL_MAX_DELTA;
+			expires = wheel_next + WHEEL_MAX_DELTA;		/* park, re-sorted on cascade */
+		}
+		while ((level < (WHEEL_LEVELS - 1U)) && (delta >= (1UL << (WHEEL_BITS * (level + 1U)))))
+		{
+			level++;
+		}
+		slot = &wheel[level][(expires >> (WHEEL_BITS * level)) & WHEEL_MASK];
+	}
+	list_add_tail(slot, &timer->node);
+}
+
+/**
+ * Re-sorts the timers of one slot into the levels below and returns the slot index
+ */
+static uint32_t wheel_cascade(uint32_t level)
+{
+	uint32_t index = (wheel_next >> (WHEEL_BITS * level)) & WHEEL_MASK;
+	timer_node_t pending;
+	timer_node_t *node;
+
+	list_move_all(&wheel[level][index], &pending);
+	while (pending.next != &pending)
+	{
+		node = pending.next;
+		list_del(node);
+		wheel_insert((systick_timer_t *)node);
+	}
+	return (index);
+}
+
+#if SYSTICK_DEFER_ENABLED
+/**
+ * Bottom half side of a deferred firing: runs the callback unless the timer
+ * was stopped, restarted or deleted since the firing was posted
+ */
+static void timer_deferred_run(void *arg)
+{
+	systick_timer_t *timer = (systick_timer_t *)arg;
+	uint32_t state = systick_port_irq_save();
+	systick_timer_callback_t callback = timer->callback;
+	void *callback_arg = timer->arg;
+	uint32_t live = (timer->stale == 0);
+
+	timer->queued--;
+	if (live == 0)
+	{
+		timer->stale--;
+	}
+	systick_port_irq_restore(state);
+	if (live != 0)
+	{
+		(*callback)(callback_arg);
+	}
+}
+
+/**
+ * Posts a firing to the bottom half, or leaves it on retry_list for the next
+ * tick if the queue is full. A firing waiting there absorbs later ones.
+ */
+static void timer_deferred_post(systick_timer_t *timer)
+{
+	if (systick_defer_post(timer_deferred_run, timer) == SYSTICK_DEFER_OK)
+	{
+		timer->queued++;
+	}
+	else if (timer->unposted == 0)
+	{
+		timer->unposted = 1;
+		timer->retry_next = retry_list;
+		retry_list = timer;
+	}
+}
+
+/**
+ * Posts again the firings which met a full queue, oldest first
+ */
+static void timer_deferred_retry(void)
+{
+	systick_timer_t *pending = NULL;
+	systick_timer_t *timer;
+
+	while (retry_list != NULL)
+	{
+		timer = retry_list;					/* reverse the list into firing order */
+		retry_list = timer->retry_next;
+		timer->retry_next = pending;
+		pending = timer;
+	}
+	while (pending != NULL)
+	{
+		timer = pending;
+		pending = timer->retry_next;
+		timer->unposted = 0;
+		timer_deferred_post(timer);
+	}
+}
+
+/**
+ * Forgets the firings of timer not run yet: those queued are skipped when
+ * they reach the bottom half, one waiting for a retry is dropped
+ */
+static void timer_deferred_cancel(systick_timer_t *timer)
+{
+	systick_timer_t **link = &retry_list;
+
+	timer->stale = timer->queued;
+	if (timer->unposted != 0)
+	{
+		while (*link != timer)
+		{
+			link = &(*link)->retry_next;
+		}
+		*link = timer->retry_next;
+		timer->unposted = 0;
+	}
+}
+#endif
+
+/******************************************************************************
+* Function: systick_timer_init()
+*//**
+* \b Description:
+*
+* 	Empties the timing wheel and returns every timer to the pool. Called by
+* 	systick_init when SYSTICK_TIMERS_ENABLED is set.
+*
+*	PRE-CONDITION: The systick interrupt is not running
+*
+*	POST-CONDITION: All SYSTICK_TIMER_POOL_SIZE timers are free and stopped
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_timer_init();
+*	@endcode
+*
+*	@see	systick_init
+*	@see	systick_timer_create
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_timer_init(void)
+{
+	uint32_t level;
+	uint32_t slot;
+	uint32_t i;
+
+	for (level = 0; level < WHEEL_LEVELS; level++)
+	{
+		for (slot = 0; slot < WHEEL_SLOTS; slot++)
+		{
+			list_init(&wheel[level][slot]);
+		}
+	}
+	list_init(&free_list);
+	for (i = 0; i < SYSTICK_TIMER_POOL_SIZE; i++)
+	{
+		timer_pool[i].allocated = 0;
+		timer_pool[i].active = 0;
+#if SYSTICK_DEFER_ENABLED
+		timer_pool[i].unposted = 0;
+		timer_pool[i].queued = 0;
+		timer_pool[i].stale = 0;
+#endif
+		list_add_tail(&free_list, &timer_pool[i].node);
+	}
+	wheel_next = 0;
+#if SYSTICK_DEFER_ENABLED
+	retry_list = NULL;
+#endif
+}
+
+/******************************************************************************
+* Function: systick_timer_create()
+*//**
+* \b Description:
+*
+* 	Takes a timer from the pool and binds it to a callback. The timer is
+* 	created stopped.
+*
+*	PRE-CONDITION: systick_timer_init has been called (through systick_init)
+*	PRE-CONDITION: callback is non-NULL
+*
+*	POST-CONDITION: The returned timer is allocated and stopped
+*
+*	@param		callback	function called from the systick ISR on expiry
+*	@param		arg			argument passed to the callback
+*	@param		mode		SYSTICK_TIMER_ONE_SHOT or SYSTICK_TIMER_PERIODIC
+*
+*	@return 	systick_timer_t* the new timer, NULL if the pool is exhausted
+*
+* \b Example:
+*
+*	@code
+*	systick_timer_t *timeout = systick_timer_create(&i2c_timeout, &i2c1, SYSTICK_TIMER_ONE_SHOT);
+*	systick_timer_start(timeout, 25);
+*	@endcode
+*
+*	@see	systick_timer_start
+*	@see	systick_timer_delete
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_timer_t *systick_timer_create(systick_timer_callback_t callback, void *arg,
+									  systick_timer_mode_t mode)
+{
+	systick_timer_t *timer = NULL;
+	uint32_t state = systick_port_irq_save();
+
+	if (free_list.next != &free_list)
+	{
+		timer = (systick_timer_t *)free_list.next;
+		list_del(&timer->node);
+		timer->callback = callback;
+		timer->arg = arg;
+		timer->mode = mode;
+		timer->period = 0;
+		timer->expires = 0;
+		timer->active = 0;
+		timer->allocated = 1;
+	}
+	systick_port_irq_restore(state);
+	return (timer);
+}
+
+/******************************************************************************
+* Function: systick_timer_delete()
+*//**
+* \b Description:
+*
+* 	Stops a timer and returns it to the pool
+*
+*	PRE-CONDITION: timer was returned by systick_timer_create
+*
+*	POST-CONDITION: The timer is stopped and must no longer be used
+*
+*	@param		timer	the timer to release
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_timer_delete(timeout);
+*	@endcode
+*
+*	@see	systick_timer_create
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_timer_delete(systick_timer_t *timer)
+{
+	uint32_t state = systick_port_irq_save();
+
+	if (timer->allocated != 0)
+	{
+		if (timer->active != 0)
+		{
+			list_del(&timer->node);
+			timer->active = 0;
+		}
+#if SYSTICK_DEFER_ENABLED
+		timer_deferred_cancel(timer);
+#endif
+		timer->allocated = 0;
+		list_add_tail(&free_list, &timer->node);
+	}
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_timer_start()
+*//**
+* \b Description:
+*
+* 	Arms a timer to fire on the ticks-th systick interrupt from now, i.e. after
+* 	between ticks - 1 and ticks tick periods. A periodic timer then keeps
+* 	firing every ticks interrupts without accumulating drift. Starting a running
+* 	timer restarts it. May be called from the timer's own callback. A period
+* 	longer than SYSTICK_TIMER_MAX_TICKS is rejected and leaves the timer as
+* 	it was.
+*
+*	PRE-CONDITION: timer was returned by systick_timer_create
+*
+*	POST-CONDITION: The timer is queued in the wheel, unless ticks was rejected
+*
+*	@param		timer	the timer to arm
+*	@param		ticks	number of tick periods until expiry, up to
+*						SYSTICK_TIMER_MAX_TICKS (0 is treated as 1)
+*
+*	@return 	systick_timer_status_t SYSTICK_TIMER_OK or SYSTICK_TIMER_INVALID
+*
+* \b Example:
+*
+*	@code
+*	if (systick_timer_start(timeout, 25) != SYSTICK_TIMER_OK)
+*	{
+*		error_handler();
+*	}
+*	@endcode
+*
+*	@see	systick_timer_stop
+*	@see	systick_timer_is_active
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_timer_status_t systick_timer_start(systick_timer_t *timer, uint32_t ticks)
+{
+	uint32_t state;
+
+	if (ticks > SYSTICK_TIMER_MAX_TICKS)
+	{
+		return (SYSTICK_TIMER_INVALID);
+	}
+	state = systick_port_irq_save();
+	if (ticks == 0)
+	{
+		ticks = 1;
+	}
+	if (timer->active != 0)
+	{
+		list_del(&timer->node);
+	}
+#if SYSTICK_DEFER_ENABLED
+	timer_deferred_cancel(timer);
+#endif
+	timer->period = ticks;
+	timer->expires = wheel_next + ticks - 1UL;
+	timer->active = 1;
+	wheel_insert(timer);
+	systick_port_irq_restore(state);
+	return (SYSTICK_TIMER_OK);
+}
+
+/******************************************************************************
+* Function: systick_timer_stop()
+*//**
+* \b Description:
+*
+* 	Cancels a timer. Stopping a stopped timer has no effect. May be called from
+* 	any timer callback, including the timer's own. With SYSTICK_DEFER_ENABLED
+* 	set, firings already handed to the bottom half are skipped there.
+*
+*	PRE-CONDITION: timer was returned by systick_timer_create
+*
+*	POST-CONDITION: The timer will not fire until started again
+*
+*	@param		timer	the timer to cancel
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	if (transfer_complete)
+*	{
+*		systick_timer_stop(timeout);
+*	}
+*	@endcode
+*
+*	@see	systick_timer_start
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_timer_stop(systick_timer_t *timer)
+{
+	uint32_t state = systick_port_irq_save();
+
+	if (timer->active != 0)
+	{
+		list_del(&timer->node);
+		timer->active = 0;
+	}
+#if SYSTICK_DEFER_ENABLED
+	timer_deferred_cancel(timer);
+#endif
+	systick_port_irq_restore(state);
+}
+
+/******************************************************************************
+* Function: systick_timer_is_active()
+*//**
+* \b Description:
+*
+* 	Reports whether a timer is armed. A one-shot timer stops being active as
+* 	soon as it has expired.
+*
+*	PRE-CONDITION: timer was returned by systick_timer_create
+*
+*	POST-CONDITION: None
+*
+*	@param		timer	the timer to query
+*
+*	@return 	uint32_t non-zero if the timer is armed, 0 otherwise
+*
+* \b Example:
+*
+*	@code
+*	while (systick_timer_is_active(timeout) && !transfer_complete);
+*	@endcode
+*
+*	@see	systick_timer_start
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_timer_is_active(const systick_timer_t *timer)
+{
+	return (timer->active);
+}
+
+/******************************************************************************
+* Function: systick_timer_process()
+*//**
+* \b Description:
+*
+* 	Advances the wheel by one tick: cascades the upper levels when a level 0
+* 	rotation completes, then fires every timer due on this tick. Periodic timers
+* 	are re-armed before their callback runs so the callback may stop them.
+* 	With SYSTICK_DEFER_ENABLED set the callbacks are posted to the bottom half
+* 	of systick_defer.c instead of being called here; a firing which finds the
+* 	queue full is posted again on the following ticks until it fits, and one
+* 	whose timer has since been stopped, restarted or deleted is skipped when
+* 	the bottom half reaches it. Called from
+* 	systick_irq_handler when SYSTICK_TIMERS_ENABLED is set.
+*
+*	PRE-CONDITION: Called from the systick ISR, once per tick
+*
+*	POST-CONDITION: Every timer due on this tick has fired
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	//called automatically upon SysTick interrupt
+* 	SysTick_IRQHandler(void)
+* 	{
+* 		systick_irq_handler();
+* 	}
+*	@endcode
+*
+*	@see	systick_irq_handler
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_timer_process(void)
+{
+	uint32_t processed = wheel_next;
+	uint32_t level = 1;
+	timer_node_t expired;
+	systick_timer_t *timer;
+
+	if ((processed & WHEEL_MASK) == 0)
+	{
+		while ((level < WHEEL_LEVELS) && (wheel_cascade(level) == 0))
+		{
+			level++;
+		}
+	}
+#if SYSTICK_DEFER_ENABLED
+	timer_deferred_retry();
+#endif
+	list_move_all(&wheel[0][processed & WHEEL_MASK], &expired);
+	wheel_next++;
+
+	while (expired.next != &expired)
+	{
+		timer = (systick_timer_t *)expired.next;
+		list_del(&timer->node);
+		if ((int32_t)(timer->expires - processed) > 0)
+		{
+			wheel_insert(timer);						/* parked far timer, not due yet */
+			continue;
+		}
+		if (timer->mode == SYSTICK_TIMER_PERIODIC)
+		{
+			timer->expires += timer->period;
+			wheel_insert(timer);
+		}
+		else
+		{
+			timer->active = 0;
+		}
+#if SYSTICK_DEFER_ENABLED
+		timer_deferred_post(timer);
+#else
+		(*timer->callback)(timer->arg);
+#endif
+	}
+}
+
+/******************************************************************************
+* Function: systick_timer_next_expiry()
+*//**
+* \b Description:
+*
+* 	Returns how many systick interrupts from now the wheel next needs to be
+* 	processed: the interrupt on which the earliest level 0 timer fires, or the
+* 	one on which the earliest occupied slot of an upper level is cascaded,
+* 	whichever comes first. A cascade is not an expiry, but the wheel must be
+* 	processed there to learn when the cascaded timers fire. A firing waiting
+* 	for room in the defer queue makes it the next interrupt. Used by the
+* 	tickless idle code to size its sleep.
+*
+*	PRE-CONDITION: Interrupts are masked, or called from the systick ISR
+*
+*	POST-CONDITION: None
+*
+*	@return 	uint32_t interrupts until the wheel needs processing (1 = the next
+*				one), SYSTICK_TIMER_NO_EXPIRY if no timer is running
+*
+* \b Example:
+*
+*	@code
+*	uint32_t idle_ticks = systick_timer_next_expiry();
+*	@endcode
+*
+*	@see	systick_timer_skip
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_timer_next_expiry(void)
+{
+	uint32_t next = SYSTICK_TIMER_NO_EXPIRY;
+	uint32_t level;
+	uint32_t shift;
+	uint32_t first;
+	uint32_t cascade;
+	uint32_t i;
+
+#if SYSTICK_DEFER_ENABLED
+	if (retry_list != NULL)
+	{
+		return (1);		/* a firing waits to be posted again on the next tick */
+	}
+#endif
+	for (i = 0; i < WHEEL_SLOTS; i++)
+	{
+		if (wheel[0][(wheel_next + i) & WHEEL_MASK].next != &wheel[0][(wheel_next + i) & WHEEL_MASK])
+		{
+			next = i + 1UL;
+			break;
+		}
+	}
+	for (level = 1; level < WHEEL_LEVELS; level++)
+	{
+		shift = WHEEL_BITS * level;
+		first = wheel_next + ((0UL - wheel_next) & ((1UL << shift) - 1UL));	/* next tick cascading this level */
+		for (i = 0; i <= WHEEL_SLOTS; i++)
+		{
+			cascade = first + (i << shift);
+			if (wheel[level][(cascade >> shift) & WHEEL_MASK].next != &wheel[level][(cascade >> shift) & WHEEL_MASK])
+			{
+				if ((cascade - wheel_next + 1UL) < next)
+				{
+					next = cascade - wheel_next + 1UL;
+				}
+				break;
+			}
+		}
+	}
+	return (next);
+}
+
+/******************************************************************************
+* Function: systick_timer_skip()
+*//**
+* \b Description:
+*
+* 	Advances the wheel by several ticks which elapsed without a systick
+* 	interrupt, as if systick_timer_process had run once for each of them. Any
+* 	timer found due on the way fires late rather than being lost. The cost is
+* 	linear in ticks, which the 24 bit reload keeps small.
+*
+*	PRE-CONDITION: Interrupts are masked
+*
+*	POST-CONDITION: The wheel is at the same position as after ticks interrupts
+*
+*	@param		ticks	number of ticks to catch up on
+*
+*	@return 	void
+*
+* \b Example:
+*
+*	@code
+*	systick_timer_skip(slept_ticks);
+*	@endcode
+*
+*	@see	systick_timer_next_expiry
+*	@see	systick_tickless_idle
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+void systick_timer_skip(uint32_t ticks)
+{
+	while (ticks > 0)
+	{
+		systick_timer_process();
+		ticks--;
+	}
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* Title                 :   Systick Software Timers
+* Filename              :   systick_timer.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_timer.h
+ *  @brief One-shot and periodic software timers advanced by the systick
+ *  		interrupt. Timers come from a static pool of SYSTICK_TIMER_POOL_SIZE
+ *  		entries and are kept in a hierarchical timing wheel, so starting and
+ *  		stopping are O(1) and the per-tick cost does not grow with the number
+ *  		of running timers.
+ *
+ *  Timer callbacks run inside systick_irq_handler and must be kept short,
+ *  unless SYSTICK_DEFER_ENABLED moves them to the bottom half of
+ *  systick_defer.h.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_TIMER_H
+#define _SYSTICK_TIMER_H
+
+#include "systick_stm32f411_config.h"
+
+/**
+ * Returned by systick_timer_next_expiry when no timer is running
+ */
+#define SYSTICK_TIMER_NO_EXPIRY		(0xFFFFFFFFUL)
+
+/**
+ * Longest timer period, in ticks. Expiries are tick numbers compared modulo
+ * 2^32, so a timer must be due within half the tick range.
+ */
+#define SYSTICK_TIMER_MAX_TICKS		(0x7FFFFFFFUL)
+
+/**
+ * Result of a timer operation
+ */
+typedef enum
+{
+	SYSTICK_TIMER_OK,
+	SYSTICK_TIMER_INVALID				/**<Period above SYSTICK_TIMER_MAX_TICKS */
+}systick_timer_status_t;
+
+/**
+ * Whether a timer stops after expiring once or is re-armed with its period
+ */
+typedef enum
+{
+	SYSTICK_TIMER_ONE_SHOT,
+	SYSTICK_TIMER_PERIODIC
+}systick_timer_mode_t;
+
+/**
+ * Function called from the systick interrupt when a timer expires
+ */
+typedef void (*systick_timer_callback_t) (void *arg);
+
+/**
+ * Opaque software timer handle, obtained from systick_timer_create
+ */
+typedef struct systick_timer systick_timer_t;
+
+void systick_timer_init(void);
+systick_timer_t *systick_timer_create(systick_timer_callback_t callback, void *arg,
+									  systick_timer_mode_t mode);
+void systick_timer_delete(systick_timer_t *timer);
+systick_timer_status_t systick_timer_start(systick_timer_t *timer, uint32_t ticks);
+void systick_timer_stop(systick_timer_t *timer);
+uint32_t systick_timer_is_active(const systick_timer_t *timer);
+void systick_timer_process(void);
+uint32_t systick_timer_next_expiry(void);
+void systick_timer_skip(uint32_t ticks);
+
+#endif
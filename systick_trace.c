@@ -0,0 +1,379 @@
+/*******************************************************************************
+* Title                 :   Systick Event Trace
+* Filename              :   systick_trace.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_trace.c
+ *  @brief Bounded ring with a sequence number per slot. Position p of the
+ *  		ring lives in slot p & mask; the slot's sequence is p while the slot
+ *  		is free for that position and p + 1 once the record for it has been
+ *  		written. Producers therefore never wait for each other: a producer
+ *  		preempted between claiming a position and filling it only hides the
+ *  		records after it from the consumer until it finishes. Positions are
+ *  		free running 32 bit counters, compared by difference.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stddef.h>
+#include "systick_trace.h"
+#include "systick_interface.h"
+
+/**
+ * Claims position pos for writing, from a single producer or by CAS
+ */
+static uint32_t trace_claim(systick_trace_t *ring, uint32_t pos)
+{
+	if (ring->producers == SYSTICK_TRACE_SPSC)
+	{
+		atomic_store_explicit(&ring->head, pos + 1UL, memory_order_relaxed);
+		return (1);
+	}
+	return (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1UL,
+												  memory_order_relaxed, memory_order_relaxed) ? 1UL : 0UL);
+}
+
+/**
+ * Frees the slot of position pos, which still holds the record of the
+ * previous lap, for the write at pos. Evicts that record if the consumer
+ * has not released it yet. Returns 1 if a record was evicted.
+ */
+static uint32_t trace_evict(systick_trace_t *ring, uint32_t pos)
+{
+	uint32_t size = ring->mask + 1UL;
+	uint32_t oldest = pos - size;
+	uint32_t committed = oldest + 1UL;
+	uint32_t evicted = atomic_compare_exchange_strong_explicit(&ring->tail, &oldest, oldest + 1UL,
+															   memory_order_acq_rel, memory_order_relaxed) ? 1UL : 0UL;
+
+	(void)atomic_compare_exchange_strong_explicit(&ring->records[pos & ring->mask].sequence, &committed,
+												  pos, memory_order_acq_rel, memory_order_relaxed);
+	return (evicted);
+}
+
+/******************************************************************************
+* Function: systick_trace_init()
+*//**
+* \b Description:
+*
+* 	Sets up an empty ring on user supplied storage
+*
+*	PRE-CONDITION: No producer or consumer uses the ring during the call
+*
+*	POST-CONDITION: The ring is empty and its drop counter is 0
+*
+*	@param		ring		ring to set up
+*	@param		records		storage for size records
+*	@param		size		number of records, a power of two
+*	@param		producers	SYSTICK_TRACE_SPSC or SYSTICK_TRACE_MPSC
+*	@param		policy		behaviour when the ring is full
+*
+*	@return 	systick_trace_status_t SYSTICK_TRACE_OK, or SYSTICK_TRACE_INVALID
+*				if size is not a power of two or records is NULL
+*
+* \b Example:
+*
+*	@code
+*	static systick_trace_record_t trace_storage[256];
+*	static systick_trace_t trace;
+*
+*	systick_trace_init(&trace, trace_storage, 256, SYSTICK_TRACE_MPSC,
+*					   SYSTICK_TRACE_DROP_NEWEST);
+*	@endcode
+*
+*	@see	systick_trace_write
+*	@see	systick_trace_peek
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_trace_status_t systick_trace_init(systick_trace_t *ring, systick_trace_record_t *records,
+										  uint32_t size, systick_trace_producers_t producers,
+										  systick_trace_policy_t policy)
+{
+	uint32_t i;
+
+	if ((records == NULL) || (size == 0) || ((size & (size - 1UL)) != 0))
+	{
+		return (SYSTICK_TRACE_INVALID);
+	}
+	ring->records = records;
+	ring->mask = size - 1UL;
+	ring->producers = producers;
+	ring->policy = policy;
+	for (i = 0; i < size; i++)
+	{
+		atomic_init(&records[i].sequence, i);
+	}
+	atomic_init(&ring->head, 0UL);
+	atomic_init(&ring->tail, 0UL);
+	atomic_init(&ring->dropped, 0UL);
+	ring->peek_tail = 0;
+	atomic_thread_fence(memory_order_release);
+	return (SYSTICK_TRACE_OK);
+}
+
+/******************************************************************************
+* Function: systick_trace_write()
+*//**
+* \b Description:
+*
+* 	Appends a record stamped with systick_get_cycles. Never blocks and never
+* 	masks interrupts, so it may be called from any ISR; on an SPSC ring only
+* 	from one context.
+*
+*	PRE-CONDITION: The ring has been set up by systick_trace_init
+*
+*	POST-CONDITION: The record is visible to the consumer, unless the ring was
+*					full under SYSTICK_TRACE_DROP_NEWEST
+*
+*	@param		ring	ring to write to
+*	@param		event	event identifier
+*	@param		arg		event argument
+*
+*	@return 	systick_trace_status_t SYSTICK_TRACE_OK, or SYSTICK_TRACE_DROPPED
+*				if the new (DROP_NEWEST) or the oldest (OVERWRITE) record was
+*				discarded
+*
+* \b Example:
+*
+*	@code
+*	void USART2_IRQHandler(void)
+*	{
+*		systick_trace_write(&trace, TRACE_UART_RX, USART2->DR);
+*	}
+*	@endcode
+*
+*	@see	systick_trace_peek
+*	@see	systick_trace_dropped
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_trace_status_t systick_trace_write(systick_trace_t *ring, uint32_t event, uint32_t arg)
+{
+	systick_trace_status_t status = SYSTICK_TRACE_OK;
+	systick_trace_record_t *slot;
+	uint32_t pos;
+	uint32_t sequence;
+
+	for (;;)
+	{
+		pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+		slot = &ring->records[pos & ring->mask];
+		sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		if (sequence == pos)
+		{
+			if (trace_claim(ring, pos) != 0)
+			{
+				break;
+			}
+		}
+		else if ((sequence == (pos - ring->mask)) && (ring->policy == SYSTICK_TRACE_OVERWRITE))
+		{
+			/* full, the slot holds the record of position pos - size */
+			if (trace_evict(ring, pos) != 0)
+			{
+				atomic_fetch_add_explicit(&ring->dropped, 1UL, memory_order_relaxed);
+				status = SYSTICK_TRACE_DROPPED;
+			}
+		}
+		else if ((int32_t)(sequence - pos) < 0)
+		{
+			/* full, or the previous lap of this slot is still being written */
+			atomic_fetch_add_explicit(&ring->dropped, 1UL, memory_order_relaxed);
+			return (SYSTICK_TRACE_DROPPED);
+		}
+		/* else another producer claimed pos first, retry with the new head */
+	}
+
+	slot->timestamp = systick_get_cycles();
+	slot->event = event;
+	slot->arg = arg;
+	atomic_store_explicit(&slot->sequence, pos + 1UL, memory_order_release);
+	return (status);
+}
+
+/******************************************************************************
+* Function: systick_trace_peek()
+*//**
+* \b Description:
+*
+* 	Returns the oldest unread records in place: span points at the first of
+* 	them and the return value says how many follow contiguously in memory.
+* 	At the end of the storage the span stops, and the rest comes with the
+* 	next peek after the release. Nothing is consumed until
+* 	systick_trace_release.
+*
+*	PRE-CONDITION: Called from the single consumer context
+*
+*	POST-CONDITION: span points at the returned records
+*
+*	@param		ring	ring to read from
+*	@param		span	set to the first unread record
+*
+*	@return 	uint32_t number of records in the span, 0 if none is ready
+*
+* \b Example:
+*
+*	@code
+*	const systick_trace_record_t *span;
+*	uint32_t count;
+*
+*	while ((count = systick_trace_peek(&trace, &span)) != 0)
+*	{
+*		uart_dma_send(span, count * sizeof(*span));
+*		systick_trace_release(&trace, count);
+*	}
+*	@endcode
+*
+*	@see	systick_trace_release
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_trace_peek(systick_trace_t *ring, const systick_trace_record_t **span)
+{
+	uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	uint32_t first = tail & ring->mask;
+	uint32_t count = 0;
+
+	while (((first + count) <= ring->mask)
+		   && (atomic_load_explicit(&ring->records[first + count].sequence, memory_order_acquire)
+			   == (tail + count + 1UL)))
+	{
+		count++;
+	}
+	ring->peek_tail = tail;
+	*span = &ring->records[first];
+	return (count);
+}
+
+/******************************************************************************
+* Function: systick_trace_release()
+*//**
+* \b Description:
+*
+* 	Consumes the first count records of the last peeked span and hands their
+* 	slots back to the producers. On a SYSTICK_TRACE_OVERWRITE ring a producer
+* 	may have overwritten the span while it was being read; this is reported
+* 	so the consumer can discard what it read, and the next peek starts at the
+* 	oldest record still in the ring.
+*
+*	PRE-CONDITION: count is at most the value returned by the last peek
+*
+*	POST-CONDITION: The records are consumed
+*
+*	@param		ring	ring to release records of
+*	@param		count	number of records consumed
+*
+*	@return 	systick_trace_status_t SYSTICK_TRACE_OK, or SYSTICK_TRACE_LOST
+*				if records of the span were overwritten
+*
+* \b Example:
+*
+*	@code
+*	if (systick_trace_release(&trace, count) == SYSTICK_TRACE_LOST)
+*	{
+*		log_discard_last();
+*	}
+*	@endcode
+*
+*	@see	systick_trace_peek
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+systick_trace_status_t systick_trace_release(systick_trace_t *ring, uint32_t count)
+{
+	uint32_t tail = ring->peek_tail;
+	uint32_t committed;
+	uint32_t i;
+
+	if (atomic_compare_exchange_strong_explicit(&ring->tail, &tail, tail + count,
+												memory_order_acq_rel, memory_order_acquire) == 0)
+	{
+		return (SYSTICK_TRACE_LOST);
+	}
+	for (i = 0; i < count; i++)
+	{
+		committed = tail + i + 1UL;
+		(void)atomic_compare_exchange_strong_explicit(&ring->records[(tail + i) & ring->mask].sequence,
+													  &committed, tail + i + ring->mask + 1UL,
+													  memory_order_acq_rel, memory_order_relaxed);
+	}
+	ring->peek_tail = tail + count;
+	return (SYSTICK_TRACE_OK);
+}
+
+/******************************************************************************
+* Function: systick_trace_dropped()
+*//**
+* \b Description:
+*
+* 	Returns how many records were discarded because the ring was full
+*
+*	PRE-CONDITION: The ring has been set up by systick_trace_init
+*
+*	POST-CONDITION: None
+*
+*	@param		ring	ring to query
+*
+*	@return 	uint32_t records dropped or overwritten since systick_trace_init
+*
+* \b Example:
+*
+*	@code
+*	if (systick_trace_dropped(&trace) != 0)
+*	{
+*		trace_buffer_too_small();
+*	}
+*	@endcode
+*
+*	@see	systick_trace_write
+* <br><b> - CHANGE HISTORY - </b>
+*
+* <table align="left" style="width:800px">
+* <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+* </table><br><br>
+* <hr>
+*******************************************************************************/
+uint32_t systick_trace_dropped(const systick_trace_t *ring)
+{
+	return (atomic_load_explicit(&ring->dropped, memory_order_relaxed));
+}
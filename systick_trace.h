@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Title                 :   Systick Event Trace
+* Filename              :   systick_trace.h
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   None
+* Target                :   None
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file systick_trace.h
+ *  @brief Lock-free event trace rings. Producers (ISRs or threads) append
+ *  		records stamped with systick_get_cycles; one consumer in thread mode
+ *  		drains them in place, as contiguous spans of the ring, without
+ *  		copying and without masking interrupts.
+ *
+ *  A ring is either single producer (SYSTICK_TRACE_SPSC), or multi producer
+ *  (SYSTICK_TRACE_MPSC) where the write index is claimed with a C11
+ *  compare-and-swap (LDREX/STREX on the Cortex-M4). When the ring is full the
+ *  new record is dropped (SYSTICK_TRACE_DROP_NEWEST) or the oldest record is
+ *  overwritten (SYSTICK_TRACE_OVERWRITE); either way the ring's drop counter
+ *  is incremented.
+ *
+ *  @code
+ *  const systick_trace_record_t *span;
+ *  uint32_t count = systick_trace_peek(&ring, &span);
+ *  log_write(span, count);
+ *  systick_trace_release(&ring, count);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#ifndef _SYSTICK_TRACE_H
+#define _SYSTICK_TRACE_H
+
+#include <stdatomic.h>
+#include "systick_stm32f411_config.h"
+
+/**
+ * Producers a ring is safe for
+ */
+typedef enum
+{
+	SYSTICK_TRACE_SPSC,				/**<One producer context */
+	SYSTICK_TRACE_MPSC				/**<Any number of producer contexts */
+}systick_trace_producers_t;
+
+/**
+ * What a write to a full ring does
+ */
+typedef enum
+{
+	SYSTICK_TRACE_DROP_NEWEST,		/**<The new record is discarded */
+	SYSTICK_TRACE_OVERWRITE			/**<The oldest unread record is discarded */
+}systick_trace_policy_t;
+
+/**
+ * Result of a ring operation
+ */
+typedef enum
+{
+	SYSTICK_TRACE_OK,
+	SYSTICK_TRACE_INVALID,			/**<Size not a power of two, or NULL storage */
+	SYSTICK_TRACE_DROPPED,			/**<The ring was full and a record was discarded */
+	SYSTICK_TRACE_LOST				/**<Records of the released span were overwritten while
+										they were being read */
+}systick_trace_status_t;
+
+/**
+ * One trace record
+ */
+typedef struct
+{
+	_Atomic uint32_t sequence;		/**<Ring position the slot holds, internal */
+	uint32_t timestamp;				/**<systick_get_cycles at the write */
+	uint32_t event;					/**<Event identifier */
+	uint32_t arg;					/**<Event argument */
+}systick_trace_record_t;
+
+/**
+ * Trace ring. The storage is supplied by the user, see systick_trace_init.
+ */
+typedef struct
+{
+	systick_trace_record_t *records;	/**<Storage, size records */
+	uint32_t mask;						/**<size - 1 */
+	systick_trace_producers_t producers;	/**<Single or multi producer */
+	systick_trace_policy_t policy;		/**<Full ring behaviour */
+	_Atomic uint32_t head;				/**<Next position to write */
+	_Atomic uint32_t tail;				/**<Next position to read */
+	_Atomic uint32_t dropped;			/**<Records discarded because the ring was full */
+	uint32_t peek_tail;					/**<tail seen by the last systick_trace_peek */
+}systick_trace_t;
+
+systick_trace_status_t systick_trace_init(systick_trace_t *ring, systick_trace_record_t *records,
+										  uint32_t size, systick_trace_producers_t producers,
+										  systick_trace_policy_t policy);
+systick_trace_status_t systick_trace_write(systick_trace_t *ring, uint32_t event, uint32_t arg);
+uint32_t systick_trace_peek(systick_trace_t *ring, const systick_trace_record_t **span);
+systick_trace_status_t systick_trace_release(systick_trace_t *ring, uint32_t count);
+uint32_t systick_trace_dropped(const systick_trace_t *ring);
+
+#endif
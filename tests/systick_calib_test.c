@@ -0,0 +1,237 @@
+/*******************************************************************************
+* Title                 :   Systick Calibration Tests
+* Filename              :   tests/systick_calib_test.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host (simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file tests/systick_calib_test.c
+ *  @brief Counter clock calibration against the simulator's true time. The
+ *  		simulated oscillator is given an error, and the calibration must
+ *  		bring the driver's time into line with the true time:
+ *
+ *  - reference: systick_calib_reference fed with systick_sim_reference_us,
+ *    as a GPS pulse per second would be, at errors up to the range limit.
+ *  - tenms: systick_calib_tenms with SystemCoreClock set off the clock the
+ *    calibration register was made for.
+ *
+ *  After calibrating, the driver's time is compared with the true time over
+ *  a further minute; the residual error must be within TEST_RESIDUAL_PPB.
+ *
+ *  Build and run from the repository root:
+ *
+ *      gcc -O2 -Isim -I. tests/systick_calib_test.c $(ls systick*.c | grep -v linux) \
+ *          sim/systick_sim.c -o systick_calib_test && ./systick_calib_test
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_calib.h"
+#include "systick_sim.h"
+
+/**
+ * Core clock of every test
+ */
+#define TEST_CORE_HZ			(16000000UL)
+
+/**
+ * Residual clock error allowed after calibrating, in parts per billion
+ */
+#define TEST_RESIDUAL_PPB		(1000LL)
+
+/**
+ * Reference samples fed per error, one a second
+ */
+#define TEST_SAMPLES			(60U)
+
+/**
+ * Seconds the residual error is measured over
+ */
+#define TEST_CHECK_S			(60ULL)
+
+static uint32_t failures = 0;	/**<Failed checks */
+
+/**
+ * Records a failed check
+ */
+static void test_check(uint32_t condition, const char *what, int32_t error_ppb, int64_t got)
+{
+	if (condition == 0)
+	{
+		printf("FAIL %s at %ld ppb: %lld\n", what, (long)error_ppb, (long long)got);
+		failures++;
+	}
+}
+
+/**
+ * Resets the simulator and starts the systick at 1 kHz. The calibration
+ * register is made for TEST_CORE_HZ, while the driver assumes core_hz and
+ * the oscillator runs error_ppb off core_hz.
+ */
+static void test_start(uint32_t core_hz, int32_t error_ppb)
+{
+	systick_config_t config = {SYSTICK_ENABLED, 1000, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+
+	SystemCoreClock = TEST_CORE_HZ;
+	systick_sim_reset();
+	SystemCoreClock = core_hz;
+	systick_sim_clock_error_set(error_ppb);
+	systick_dispatch_init();
+	systick_init(&config);
+	systick_trim_set(0);
+	systick_calib_reference_reset();
+}
+
+/**
+ * Runs for one second of true time, give or take a few microseconds
+ */
+static void test_second(void)
+{
+	systick_sim_advance((uint64_t)SystemCoreClock + ((uint64_t)rand() % 64ULL));
+}
+
+/**
+ * Clock error left in the driver's time against the true time over
+ * TEST_CHECK_S seconds, in parts per billion
+ */
+static int64_t test_residual(void)
+{
+	uint32_t local_start = systick_get_time_us();
+	uint64_t reference_start = systick_sim_reference_us();
+	int64_t local_span;
+	int64_t reference_span;
+	uint32_t i;
+
+	for (i = 0; i < TEST_CHECK_S; i++)
+	{
+		test_second();
+	}
+	local_span = (int64_t)(uint32_t)(systick_get_time_us() - local_start);
+	reference_span = (int64_t)(systick_sim_reference_us() - reference_start);
+	return (((local_span - reference_span) * 1000000000LL) / reference_span);
+}
+
+/**
+ * Calibration from a reference fed once a second
+ */
+static void test_reference(int32_t error_ppb)
+{
+	uint32_t calibrated = 0;
+	uint32_t i;
+	int64_t residual;
+
+	test_start(TEST_CORE_HZ, error_ppb);
+	/* uncalibrated, the driver's time runs off by the injected error */
+	residual = test_residual();
+	test_check(llabs(residual - error_ppb) <= TEST_RESIDUAL_PPB, "uncalibrated residual, ppb", error_ppb, residual);
+	for (i = 0; i < TEST_SAMPLES; i++)
+	{
+		test_second();
+		if (systick_calib_reference(systick_get_time_us(), (uint32_t)systick_sim_reference_us()) == SYSTICK_CALIB_OK)
+		{
+			calibrated++;
+		}
+	}
+	/* SYSTICK_CALIB_SPAN_US is 10 s: one interval per 10 samples after the first */
+	test_check(calibrated >= ((TEST_SAMPLES - 1U) / (SYSTICK_CALIB_SPAN_US / 1000000UL)), "intervals completed",
+			   error_ppb, calibrated);
+	test_check(llabs((int64_t)systick_trim_get() - error_ppb) <= TEST_RESIDUAL_PPB, "trim", error_ppb,
+			   systick_trim_get());
+	residual = test_residual();
+	test_check(llabs(residual) <= TEST_RESIDUAL_PPB, "residual, ppb", error_ppb, residual);
+}
+
+/**
+ * A reference further off than SYSTICK_CALIB_MAX_PPB is refused and leaves
+ * the trim alone
+ */
+static void test_reference_range(int32_t error_ppb)
+{
+	uint32_t refused = 0;
+	uint32_t i;
+
+	test_start(TEST_CORE_HZ, error_ppb);
+	for (i = 0; i < TEST_SAMPLES; i++)
+	{
+		test_second();
+		if (systick_calib_reference(systick_get_time_us(), (uint32_t)systick_sim_reference_us())
+			== SYSTICK_CALIB_OUT_OF_RANGE)
+		{
+			refused++;
+		}
+	}
+	test_check(refused != 0, "out of range reference accepted", error_ppb, refused);
+	test_check(systick_trim_get() == 0, "trim after refused reference", error_ppb, systick_trim_get());
+}
+
+/**
+ * Calibration from the SysTick calibration register, with SystemCoreClock
+ * off by assumed_ppb from the clock the core actually runs at
+ */
+static void test_tenms(int32_t assumed_ppb, systick_calib_status_t expected)
+{
+	uint32_t core_hz = (uint32_t)(((int64_t)TEST_CORE_HZ * (1000000000LL + assumed_ppb)) / 1000000000LL);
+	/* the oscillator runs at TEST_CORE_HZ, i.e. off from what the driver assumes */
+	int32_t error_ppb = (int32_t)((((int64_t)TEST_CORE_HZ - (int64_t)core_hz) * 1000000000LL) / (int64_t)core_hz);
+	int32_t measured_ppb = 0;
+	systick_calib_status_t status;
+	int64_t residual;
+
+	test_start(core_hz, error_ppb);
+	status = systick_calib_tenms(&measured_ppb);
+	test_check(status == expected, "tenms status", error_ppb, status);
+	if (expected != SYSTICK_CALIB_OK)
+	{
+		test_check(systick_trim_get() == 0, "trim after refused tenms", error_ppb, systick_trim_get());
+		return;
+	}
+	/* one TENMS count in TEST_CORE_HZ / 8 / 100 resolves 0.5 ppm */
+	test_check(llabs((int64_t)measured_ppb - error_ppb) <= TEST_RESIDUAL_PPB, "tenms error", error_ppb, measured_ppb);
+	residual = test_residual();
+	test_check(llabs(residual) <= TEST_RESIDUAL_PPB, "tenms residual, ppb", error_ppb, residual);
+}
+
+int main(void)
+{
+	static const int32_t errors_ppb[] = {0L, 42000L, -42000L, 150000L, -999000L, 999000L};
+	uint32_t e;
+
+	srand(1);
+	for (e = 0; e < (sizeof(errors_ppb) / sizeof(errors_ppb[0])); e++)
+	{
+		test_reference(errors_ppb[e]);
+	}
+	test_reference_range(2000000L);
+	test_reference_range(-2000000L);
+	test_tenms(0L, SYSTICK_CALIB_OK);
+	test_tenms(500000L, SYSTICK_CALIB_OK);
+	test_tenms(-300000L, SYSTICK_CALIB_OK);
+	test_tenms(5000000L, SYSTICK_CALIB_OUT_OF_RANGE);
+	printf("%s: %lu failures\n", (failures == 0) ? "PASS" : "FAIL", (unsigned long)failures);
+	return ((failures == 0) ? 0 : 1);
+}
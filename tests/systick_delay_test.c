@@ -0,0 +1,248 @@
+/*******************************************************************************
+* Title                 :   Systick Delay and Drift Tests
+* Filename              :   tests/systick_delay_test.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host (simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file tests/systick_delay_test.c
+ *  @brief Accuracy tests of the tick time base at tick rates that do and do
+ *  		not divide the core clock into whole milliseconds, run against the
+ *  		simulator:
+ *
+ *  - drift: after an hour of virtual time the millisecond tick, the 64 bit
+ *    tick and systick_get_time_us agree with virtual time to within a tick.
+ *  - stepped drift: the same over a million ticks taken one by one, so every
+ *    tick goes through the interrupt's own accounting rather than a warp.
+ *  - delay: systick_delay, systick_delay_us and deadlines, started at random
+ *    phases within the tick, never end early and overshoot by a bounded
+ *    amount.
+ *
+ *  Build and run from the repository root:
+ *
+ *      gcc -O2 -Isim -I. tests/systick_delay_test.c $(ls systick*.c | grep -v linux) \
+ *          sim/systick_sim.c -o systick_delay_test && ./systick_delay_test
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_deadline.h"
+#include "systick_sim.h"
+
+/**
+ * Core clock of every test
+ */
+#define TEST_CORE_HZ			(16000000ULL)
+
+/**
+ * Delays measured per tick rate and function
+ */
+#define TEST_DELAY_RUNS			(400U)
+
+/**
+ * Ticks taken one by one in the stepped drift test
+ */
+#define TEST_STEPPED_TICKS		(1000000UL)
+
+/**
+ * Virtual cycles consumed per register access, so polling loops move time on
+ */
+#define TEST_AUTOSTEP			(7UL)
+
+static uint32_t failures = 0;	/**<Failed checks */
+
+/**
+ * Records a failed check
+ */
+static void test_check(uint32_t condition, const char *what, uint32_t tick_hz, int64_t got)
+{
+	if (condition == 0)
+	{
+		printf("FAIL %s at %lu Hz: %lld\n", what, (unsigned long)tick_hz, (long long)got);
+		failures++;
+	}
+}
+
+/**
+ * Resets the simulator and starts the systick at the given rate
+ */
+static void test_start(uint32_t tick_hz)
+{
+	systick_config_t config = {SYSTICK_ENABLED, tick_hz, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+
+	systick_sim_reset();
+	SystemCoreClock = (uint32_t)TEST_CORE_HZ;
+	systick_dispatch_init();
+	systick_init(&config);
+	systick_sim_autostep_set(TEST_AUTOSTEP);
+}
+
+/**
+ * Tick time against virtual time after an hour. The tick carries on across
+ * systick_init, so both are measured from the start of the test.
+ */
+static void test_drift(uint32_t tick_hz)
+{
+	uint64_t period = TEST_CORE_HZ / tick_hz;
+	uint64_t start_ms;
+	uint32_t start_tick;
+	uint32_t start_us;
+	uint64_t true_us;
+	int64_t error_ms;
+	int64_t error_us;
+
+	test_start(tick_hz);
+	start_ms = systick_get_tick64();
+	start_tick = systick_get_tick();
+	start_us = systick_get_time_us();
+	systick_sim_warp(3600ULL * TEST_CORE_HZ);
+	systick_sim_advance((uint64_t)rand() % period);
+	true_us = (systick_sim_cycles() * 1000000ULL) / TEST_CORE_HZ;
+	error_ms = (int64_t)(systick_get_tick64() - start_ms) - (int64_t)(true_us / 1000ULL);
+	error_us = (int32_t)((systick_get_time_us() - start_us) - (uint32_t)true_us);
+	/* the ms count lags by the part of a tick not yet counted and at most a ms of rounding */
+	test_check((error_ms <= 0) && (-error_ms <= (int64_t)((1000ULL / tick_hz) + 1ULL)),
+			   "tick64 drift after 1 h, ms", tick_hz, error_ms);
+	test_check((error_ms == (int64_t)(int32_t)((systick_get_tick() - start_tick) - (uint32_t)(true_us / 1000ULL))),
+			   "tick and tick64 disagree", tick_hz, error_ms);
+	test_check((error_us >= -2) && (error_us <= 2), "time_us drift after 1 h, us", tick_hz, error_us);
+}
+
+/**
+ * Tick time against virtual time after every one of TEST_STEPPED_TICKS ticks
+ */
+static void test_drift_stepped(uint32_t tick_hz)
+{
+	uint64_t period = (TEST_CORE_HZ + (tick_hz / 2UL)) / tick_hz;
+	uint64_t start_ms;
+	uint32_t start_us;
+	uint64_t true_us;
+	int64_t error_ms;
+	int64_t error_us;
+	int64_t min_ms = 0;
+	int64_t max_ms = 0;
+	int64_t min_us = 0;
+	int64_t max_us = 0;
+	uint32_t i;
+
+	test_start(tick_hz);
+	start_ms = systick_get_tick64();
+	start_us = systick_get_time_us();
+	for (i = 0; i < TEST_STEPPED_TICKS; i++)
+	{
+		systick_sim_advance(period);
+		error_ms = (int64_t)(systick_get_tick64() - start_ms);
+		error_us = (int32_t)(systick_get_time_us() - start_us);
+		true_us = (systick_sim_cycles() * 1000000ULL) / TEST_CORE_HZ;
+		error_ms -= (int64_t)(true_us / 1000ULL);
+		error_us -= (int32_t)(uint32_t)true_us;
+		min_ms = (error_ms < min_ms) ? error_ms : min_ms;
+		max_ms = (error_ms > max_ms) ? error_ms : max_ms;
+		min_us = (error_us < min_us) ? error_us : min_us;
+		max_us = (error_us > max_us) ? error_us : max_us;
+	}
+	/* the ms count lags by up to a tick and a ms, and may look one ms ahead
+	 * from the sub-millisecond phase the tick carried into the test */
+	test_check(max_ms <= 1, "stepped tick64 ahead, ms", tick_hz, max_ms);
+	test_check(-min_ms <= (int64_t)((1000ULL / tick_hz) + 1ULL), "stepped tick64 behind, ms", tick_hz, min_ms);
+	test_check(max_us <= 2, "stepped time_us ahead, us", tick_hz, max_us);
+	test_check(min_us >= -2, "stepped time_us behind, us", tick_hz, min_us);
+}
+
+/**
+ * Early return and overshoot of both delays and of a deadline from random
+ * phases
+ */
+static void test_delay(uint32_t tick_hz)
+{
+	uint64_t period = TEST_CORE_HZ / tick_hz;
+	uint64_t start;
+	int64_t overshoot;
+	int64_t worst_ms = 0;
+	int64_t worst_us = 0;
+	int64_t worst_deadline = 0;
+	systick_deadline_t deadline;
+	uint32_t delay;
+	uint32_t i;
+
+	test_start(tick_hz);
+	for (i = 0; i < TEST_DELAY_RUNS; i++)
+	{
+		systick_sim_advance((uint64_t)rand() % period);
+		delay = 1UL + ((uint32_t)rand() % 20UL);
+		start = systick_sim_cycles();
+		systick_delay(delay);
+		overshoot = (int64_t)(systick_sim_cycles() - start) - (int64_t)((delay * TEST_CORE_HZ) / 1000ULL);
+		test_check(overshoot >= 0, "systick_delay early, cycles", tick_hz, overshoot);
+		worst_ms = (overshoot > worst_ms) ? overshoot : worst_ms;
+
+		systick_sim_advance((uint64_t)rand() % period);
+		delay = 1UL + ((uint32_t)rand() % 2000UL);
+		start = systick_sim_cycles();
+		(void)systick_delay_us(delay);
+		overshoot = (int64_t)(systick_sim_cycles() - start) - (int64_t)((delay * TEST_CORE_HZ) / 1000000ULL);
+		test_check(overshoot >= 0, "systick_delay_us early, cycles", tick_hz, overshoot);
+		worst_us = (overshoot > worst_us) ? overshoot : worst_us;
+
+		systick_sim_advance((uint64_t)rand() % period);
+		delay = 1UL + ((uint32_t)rand() % 20UL);
+		start = systick_sim_cycles();
+		systick_deadline_start(&deadline, delay);
+		while (systick_deadline_expired(&deadline) == 0)
+		{
+			systick_sim_advance(TEST_AUTOSTEP);
+		}
+		overshoot = (int64_t)(systick_sim_cycles() - start) - (int64_t)((delay * TEST_CORE_HZ) / 1000ULL);
+		test_check(overshoot >= 0, "deadline early, cycles", tick_hz, overshoot);
+		worst_deadline = (overshoot > worst_deadline) ? overshoot : worst_deadline;
+	}
+	/* the ms delay may wait its slack (a period rounded up, plus 1 ms) and a period more */
+	test_check(worst_ms <= (int64_t)((2ULL * period) + ((2ULL * TEST_CORE_HZ) / 1000ULL)),
+			   "systick_delay overshoot, cycles", tick_hz, worst_ms);
+	test_check(worst_deadline <= (int64_t)((2ULL * period) + ((2ULL * TEST_CORE_HZ) / 1000ULL)),
+			   "deadline overshoot, cycles", tick_hz, worst_deadline);
+	test_check(worst_us <= (int64_t)(TEST_CORE_HZ / 100000ULL), "systick_delay_us overshoot, cycles",
+			   tick_hz, worst_us);
+}
+
+int main(void)
+{
+	static const uint32_t tick_rates[] = {100UL, 1000UL, 1500UL, 1600UL, 3000UL, 4000UL, 7000UL, 30000UL};
+	uint32_t r;
+
+	srand(1);
+	for (r = 0; r < (sizeof(tick_rates) / sizeof(tick_rates[0])); r++)
+	{
+		test_drift(tick_rates[r]);
+		test_delay(tick_rates[r]);
+	}
+	test_drift_stepped(1500UL);
+	test_drift_stepped(7UL);
+	printf("%s: %lu failures\n", (failures == 0) ? "PASS" : "FAIL", (unsigned long)failures);
+	return ((failures == 0) ? 0 : 1);
+}
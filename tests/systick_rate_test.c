@@ -0,0 +1,217 @@
+/*******************************************************************************
+* Title                 :   Systick Rate Limiter Tests
+* Filename              :   tests/systick_rate_test.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host (simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file tests/systick_rate_test.c
+ *  @brief Long-run and wraparound tests of the rate limiters, run against
+ *  		the simulator. Long idle stretches are skipped with
+ *  		systick_sim_warp, so days of virtual time take no real time.
+ *  		Prints one line per failed check and exits non-zero if any failed.
+ *
+ *  Build and run from the repository root:
+ *
+ *      gcc -O2 -Isim -I. tests/systick_rate_test.c $(ls systick*.c | grep -v linux) \
+ *          sim/systick_sim.c -o systick_rate_test && ./systick_rate_test
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdio.h>
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_rate.h"
+#include "systick_sim.h"
+
+/**
+ * Core clock of every test, 1 ms is TEST_CYCLES_PER_MS cycles at a 1 kHz tick
+ */
+#define TEST_CORE_HZ			(16000000UL)
+#define TEST_CYCLES_PER_MS		(TEST_CORE_HZ / 1000UL)
+
+static uint32_t failures = 0;	/**<Failed checks */
+
+/**
+ * Records a failed check
+ */
+static void test_check(uint32_t condition, const char *what, uint64_t got, uint64_t expected)
+{
+	if (condition == 0)
+	{
+		printf("FAIL %s: got %llu, expected %llu\n", what, (unsigned long long)got,
+			   (unsigned long long)expected);
+		failures++;
+	}
+}
+
+/**
+ * Resets the simulator and starts a 1 kHz tick
+ */
+static void test_start(void)
+{
+	systick_config_t config = {SYSTICK_ENABLED, 1000, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+
+	systick_sim_reset();
+	SystemCoreClock = TEST_CORE_HZ;
+	systick_dispatch_init();
+	systick_init(&config);
+}
+
+/**
+ * Skips ms milliseconds of idle time
+ */
+static void test_idle_ms(uint64_t ms)
+{
+	systick_sim_warp(ms * TEST_CYCLES_PER_MS);
+}
+
+/**
+ * Takes single tokens every ms for span_ms, returning how many were admitted
+ */
+static uint32_t test_token_run(systick_bucket_t *bucket, uint32_t span_ms)
+{
+	uint32_t admitted = 0;
+	uint32_t ms;
+
+	for (ms = 0; ms < span_ms; ms++)
+	{
+		while (systick_token_bucket_take(bucket, 1) == SYSTICK_RATE_OK)
+		{
+			admitted++;
+		}
+		systick_sim_advance(TEST_CYCLES_PER_MS);
+	}
+	return (admitted);
+}
+
+/**
+ * Token bucket: exact long-run rate, and full again after idling across the
+ * 32 bit tick wrap and across the old 32 bit unit wrap
+ */
+static void test_token_bucket(void)
+{
+	systick_bucket_t bucket;
+	uint32_t admitted;
+
+	test_start();
+	systick_token_bucket_init(&bucket, 3, 1000, 2);
+	admitted = test_token_run(&bucket, 1000000);		/* the burst plus a refill every 333.3 ms before 1000 s */
+	test_check(admitted == (2UL + 2999UL), "token bucket 3/1000 ms over 1000 s", admitted, 3001);
+
+	test_start();
+	systick_token_bucket_init(&bucket, 1000, 1, 1000);
+	test_check(systick_token_bucket_take(&bucket, 1000) == SYSTICK_RATE_OK, "token bucket initial burst", 0, 0);
+	test_idle_ms(4294968ULL);
+	admitted = systick_token_bucket_available(&bucket);
+	test_check(admitted == 1000, "token bucket available after 2^32 units idle", admitted, 1000);
+	test_check(systick_token_bucket_take(&bucket, 1000) == SYSTICK_RATE_OK,
+			   "token bucket burst after 2^32 units idle", 0, 0);
+
+	test_start();
+	systick_token_bucket_init(&bucket, 5, 1000, 5);
+	test_idle_ms(0xFFFFFFFFULL - 2000ULL);
+	admitted = test_token_run(&bucket, 4000);
+	test_check(admitted == (5UL + 19UL), "token bucket across the tick wrap", admitted, 24);
+	test_idle_ms(0x100000000ULL);
+	admitted = systick_token_bucket_available(&bucket);
+	test_check(admitted == 5, "token bucket after 2^32 ms idle", admitted, 5);
+}
+
+/**
+ * Leaky bucket: evenly spaced waits, also across the 32 bit tick wrap
+ */
+static void test_leaky_bucket(void)
+{
+	systick_bucket_t bucket;
+	uint32_t wait_ms;
+	uint32_t i;
+
+	test_start();
+	systick_leaky_bucket_init(&bucket, 1, 100, 4);
+	test_idle_ms(0xFFFFFFFFULL - 150ULL);
+	for (i = 0; i < 4; i++)
+	{
+		wait_ms = 0xFFFFFFFFUL;
+		test_check(systick_leaky_bucket_reserve(&bucket, &wait_ms) == SYSTICK_RATE_OK,
+				   "leaky bucket reserve", i, i);
+		test_check(wait_ms == (i * 100UL), "leaky bucket wait", wait_ms, i * 100UL);
+	}
+	test_check(systick_leaky_bucket_reserve(&bucket, &wait_ms) == SYSTICK_RATE_LIMITED,
+			   "leaky bucket full", 0, 0);
+	test_idle_ms(250);
+	test_check(systick_leaky_bucket_reserve(&bucket, &wait_ms) == SYSTICK_RATE_OK,
+			   "leaky bucket after draining", 0, 0);
+	test_check(wait_ms == 150, "leaky bucket wait after the tick wrap", wait_ms, 150);
+}
+
+/**
+ * Sliding window: never aliases old counts back in, whatever the idle time
+ */
+static void test_window(void)
+{
+	systick_window_t window;
+	uint32_t admitted;
+	uint64_t idle[] = {255000ULL, 256000ULL, 257000ULL, 0x100000000ULL, 0x100000000ULL * 256ULL};
+	uint32_t i;
+	uint32_t j;
+
+	for (i = 0; i < (sizeof(idle) / sizeof(idle[0])); i++)
+	{
+		test_start();
+		systick_window_init(&window, 10, 1000);
+		for (j = 0; j < 10; j++)
+		{
+			(void)systick_window_take(&window);
+		}
+		test_idle_ms(idle[i]);
+		admitted = 0;
+		for (j = 0; j < 10; j++)
+		{
+			admitted += (systick_window_take(&window) == SYSTICK_RATE_OK);
+		}
+		test_check(admitted == 10, "window after idle", admitted, 10);
+	}
+
+	test_start();
+	systick_window_init(&window, 10, 1000);
+	admitted = 0;
+	for (i = 0; i < 100000; i++)
+	{
+		admitted += (systick_window_take(&window) == SYSTICK_RATE_OK);
+		systick_sim_advance(TEST_CYCLES_PER_MS);
+	}
+	/* the weighted estimate admits 9 of 10 per window at a steady rate, and never more than 10 */
+	test_check((admitted >= 900) && (admitted <= 1010), "window 10/s over 100 s", admitted, 1000);
+}
+
+int main(void)
+{
+	test_token_bucket();
+	test_leaky_bucket();
+	test_window();
+	printf("%s: %lu failures\n", (failures == 0) ? "PASS" : "FAIL", (unsigned long)failures);
+	return ((failures == 0) ? 0 : 1);
+}
@@ -0,0 +1,226 @@
+/*******************************************************************************
+* Title                 :   Systick Reference Time Tests
+* Filename              :   tests/systick_sync_test.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host (simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file tests/systick_sync_test.c
+ *  @brief The reference time servo against the simulator's true time. The
+ *  		simulated oscillator is given a rate error, and a reference clock
+ *  		derived from the true time is sampled once a second, with jitter
+ *  		on every sample and a step part way through:
+ *
+ *  - the servo locks on the second sample and stays locked;
+ *  - the step is reported as SYSTICK_SYNC_STEPPED on the sample it happens;
+ *  - once settled, before and after the step, the RMS error of
+ *    systick_sync_to_reference against the true reference time is within
+ *    TEST_RMS_US, and the rate estimate matches the injected error;
+ *  - a sample more than SYSTICK_SYNC_MAX_INTERVAL_US after the previous one
+ *    is rejected and leaves the mapping alone.
+ *
+ *  Build and run from the repository root:
+ *
+ *      gcc -O2 -Isim -I. tests/systick_sync_test.c $(ls systick*.c | grep -v linux) \
+ *          sim/systick_sim.c -lm -o systick_sync_test && ./systick_sync_test
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_sync.h"
+#include "systick_sim.h"
+
+/**
+ * Core clock of every test
+ */
+#define TEST_CORE_HZ			(16000000UL)
+
+/**
+ * Reference time at reset, the Unix epoch in microseconds of a date in 2026
+ */
+#define TEST_EPOCH_US			(1791000000000000ULL)
+
+/**
+ * Samples per run, one a second
+ */
+#define TEST_SAMPLES			(1200U)
+
+/**
+ * Sample on which the reference steps, and by how much
+ */
+#define TEST_STEP_SAMPLE		(600U)
+#define TEST_STEP_US			(2500000LL)
+
+/**
+ * Samples left out of the RMS error while the servo settles
+ */
+#define TEST_SETTLE				(200U)
+
+/**
+ * Largest jitter of a sample either way, in microseconds
+ */
+#define TEST_JITTER_US			(200L)
+
+/**
+ * RMS error allowed once settled, and rate error allowed, with the default gains
+ */
+#define TEST_RMS_US				(60.0)
+#define TEST_RATE_PPB			(5000LL)
+
+static uint32_t failures = 0;	/**<Failed checks */
+
+/**
+ * Records a failed check
+ */
+static void test_check(uint32_t condition, const char *what, int32_t error_ppb, double got)
+{
+	if (condition == 0)
+	{
+		printf("FAIL %s at %ld ppb: %.3f\n", what, (long)error_ppb, got);
+		failures++;
+	}
+}
+
+/**
+ * Resets the simulator with the given oscillator error and starts the
+ * systick at 1 kHz
+ */
+static void test_start(int32_t error_ppb)
+{
+	systick_config_t config = {SYSTICK_ENABLED, 1000, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+
+	SystemCoreClock = TEST_CORE_HZ;
+	systick_sim_reset();
+	systick_sim_clock_error_set(error_ppb);
+	systick_dispatch_init();
+	systick_init(&config);
+}
+
+/**
+ * One run of TEST_SAMPLES samples at an oscillator error
+ */
+static void test_servo(int32_t error_ppb)
+{
+	systick_sync_t sync;
+	systick_sync_state_t result;
+	uint64_t reference_us;
+	uint32_t local_us;
+	int64_t step_us = 0;
+	int64_t error_us;
+	double square_sum = 0.0;
+	uint32_t counted = 0;
+	uint32_t unlocked = 0;
+	uint32_t stepped = 0;
+	uint32_t i;
+	double rms;
+
+	test_start(error_ppb);
+	systick_sync_init(&sync);
+	for (i = 0; i < TEST_SAMPLES; i++)
+	{
+		systick_sim_advance((uint64_t)TEST_CORE_HZ + ((uint64_t)rand() % 1000ULL));
+		if (i == TEST_STEP_SAMPLE)
+		{
+			step_us = TEST_STEP_US;
+		}
+		local_us = systick_get_time_us();
+		reference_us = TEST_EPOCH_US + systick_sim_reference_us() + (uint64_t)step_us;
+
+		/* the mapping's prediction of this sample against the true reference */
+		if ((i > TEST_SETTLE) && ((i < TEST_STEP_SAMPLE) || (i > (TEST_STEP_SAMPLE + TEST_SETTLE))))
+		{
+			error_us = (int64_t)(systick_sync_to_reference(&sync, local_us) - reference_us);
+			square_sum += (double)error_us * (double)error_us;
+			counted++;
+		}
+
+		result = systick_sync_update(&sync, local_us,
+									 reference_us + (uint64_t)(int64_t)((rand() % ((2 * TEST_JITTER_US) + 1))
+																	   - TEST_JITTER_US));
+		if (result == SYSTICK_SYNC_STEPPED)
+		{
+			stepped++;
+			test_check(i == TEST_STEP_SAMPLE, "stepped on sample", error_ppb, i);
+		}
+		else if ((i >= 1U) && (result != SYSTICK_SYNC_LOCKED))
+		{
+			unlocked++;
+		}
+	}
+	rms = sqrt(square_sum / (double)counted);
+	test_check(stepped == 1U, "steps", error_ppb, stepped);
+	test_check(sync.steps == 1U, "steps counted", error_ppb, sync.steps);
+	test_check(unlocked == 0U, "samples not locked", error_ppb, unlocked);
+	test_check(systick_sync_state_get(&sync) == SYSTICK_SYNC_LOCKED, "state", error_ppb, sync.state);
+	test_check(rms <= TEST_RMS_US, "RMS error, us", error_ppb, rms);
+	/* the local clock runs error_ppb fast, so the reference runs slow against it */
+	test_check(llabs((int64_t)sync.rate_ppb + error_ppb) <= TEST_RATE_PPB, "rate, ppb", error_ppb, sync.rate_ppb);
+}
+
+/**
+ * A sample past SYSTICK_SYNC_MAX_INTERVAL_US is refused and leaves the
+ * mapping as it was
+ */
+static void test_interval(void)
+{
+	systick_sync_t sync;
+	systick_sync_t before;
+	uint32_t i;
+	uint32_t local_us;
+
+	test_start(0);
+	systick_sync_init(&sync);
+	for (i = 0; i < 10U; i++)
+	{
+		systick_sim_advance(TEST_CORE_HZ);
+		(void)systick_sync_update(&sync, systick_get_time_us(), TEST_EPOCH_US + systick_sim_reference_us());
+	}
+	before = sync;
+	systick_sim_warp(((uint64_t)SYSTICK_SYNC_MAX_INTERVAL_US + 1000000ULL) * (TEST_CORE_HZ / 1000000UL));
+	local_us = systick_get_time_us();
+	test_check(systick_sync_update(&sync, local_us, TEST_EPOCH_US + systick_sim_reference_us())
+			   == SYSTICK_SYNC_REJECTED, "late sample accepted", 0, sync.state);
+	test_check((sync.anchor_local == before.anchor_local) && (sync.anchor_reference == before.anchor_reference)
+			   && (sync.rate_ppb == before.rate_ppb) && (sync.state == before.state), "mapping moved", 0, 0);
+}
+
+int main(void)
+{
+	static const int32_t errors_ppb[] = {0L, 42000L, -42000L, 250000L, -250000L};
+	uint32_t e;
+
+	srand(1);
+	for (e = 0; e < (sizeof(errors_ppb) / sizeof(errors_ppb[0])); e++)
+	{
+		test_servo(errors_ppb[e]);
+	}
+	test_interval();
+	printf("%s: %lu failures\n", (failures == 0) ? "PASS" : "FAIL", (unsigned long)failures);
+	return ((failures == 0) ? 0 : 1);
+}
@@ -0,0 +1,317 @@
+/*******************************************************************************
+* Title                 :   Systick Tickless Idle Tests
+* Filename              :   tests/systick_tickless_test.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host (simulator)
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file tests/systick_tickless_test.c
+ *  @brief Tickless idle against a run which takes every tick, on the
+ *  		simulator. The same subscribers and software timers run twice:
+ *
+ *  - tickless: the idle loop calls systick_tickless_idle, and other
+ *    "interrupts" wake it at random points of its sleep.
+ *  - reference: time is advanced one tick at a time up to each point where
+ *    the tickless run woke.
+ *
+ *  Every callback must run on the same tick and at the same virtual cycle in
+ *  both runs, and systick_get_tick64, systick_get_time_us and
+ *  systick_get_cycles must read the same at every wake-up.
+ *
+ *  The tick carries on across systick_init, sub-millisecond phase included,
+ *  so each run is made in a child process forked from the same state. The
+ *  model's instructions take no time, while on target at least a clock
+ *  passes between restarting the counter and reading it back; the idle loop
+ *  lets a cycle pass after each wake-up before it reads the time.
+ *
+ *  Build and run from the repository root:
+ *
+ *      gcc -O2 -Isim -I. tests/systick_tickless_test.c $(ls systick*.c | grep -v linux) \
+ *          sim/systick_sim.c -o systick_tickless_test && ./systick_tickless_test
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "systick_interface.h"
+#include "systick_dispatch.h"
+#include "systick_timer.h"
+#include "systick_tickless.h"
+#include "systick_sim.h"
+
+/**
+ * Core clock of every test
+ */
+#define TEST_CORE_HZ			(16000000ULL)
+
+/**
+ * Ticks each run covers
+ */
+#define TEST_TICKS				(20000ULL)
+
+/**
+ * Most callbacks and wake-ups recorded per run
+ */
+#define TEST_MAX_RECORDS		(8192U)
+
+/**
+ * A callback or a wake-up of the idle loop
+ */
+typedef struct
+{
+	uint32_t what;				/**<Callback number, or TEST_WAKE */
+	uint64_t tick;				/**<systick_get_tick64 from the start of the run */
+	uint64_t cycle;				/**<Virtual cycle */
+	uint32_t time_us;			/**<systick_get_time_us from the start of the run, wake-ups only */
+	uint32_t cycles;			/**<systick_get_cycles from the start of the run, wake-ups only */
+}test_record_t;
+
+#define TEST_WAKE				(0U)
+
+/**
+ * Recorded events of one run
+ */
+typedef struct
+{
+	test_record_t records[TEST_MAX_RECORDS];
+	uint32_t count;
+	uint64_t slept;				/**<Ticks credited by systick_tickless_idle */
+}test_run_t;
+
+static test_run_t *runs;				/**<Tickless and reference run, shared with the children */
+static test_run_t *recording;			/**<Run the callbacks record into */
+static uint64_t base_tick;				/**<systick_get_tick64 at the start of the run */
+static uint32_t base_us;				/**<systick_get_time_us at the start of the run */
+static uint32_t base_cycles;			/**<systick_get_cycles at the start of the run */
+static systick_timer_t *one_shot;		/**<Restarted from its own callback */
+static uint32_t failures = 0;			/**<Failed checks */
+
+/**
+ * Records a failed check
+ */
+static void test_check(uint32_t condition, const char *what, uint32_t tick_hz, uint64_t got, uint64_t expected)
+{
+	if (condition == 0)
+	{
+		printf("FAIL %s at %lu Hz: got %llu, expected %llu\n", what, (unsigned long)tick_hz,
+			   (unsigned long long)got, (unsigned long long)expected);
+		failures++;
+	}
+}
+
+/**
+ * Appends an event with the time readers' values to the running record
+ */
+static void test_record(uint32_t what)
+{
+	test_record_t *record;
+
+	if (recording->count < TEST_MAX_RECORDS)
+	{
+		record = &recording->records[recording->count++];
+		record->what = what;
+		record->tick = systick_get_tick64() - base_tick;
+		record->cycle = systick_sim_cycles();
+		record->time_us = 0;
+		record->cycles = 0;
+		if (what == TEST_WAKE)
+		{
+			record->time_us = systick_get_time_us() - base_us;
+			record->cycles = systick_get_cycles() - base_cycles;
+		}
+	}
+}
+
+static void test_subscriber(void)
+{
+	test_record(1);
+}
+
+static void test_periodic(void *arg)
+{
+	(void)arg;
+	test_record(2);
+}
+
+static void test_one_shot(void *arg)
+{
+	(void)arg;
+	test_record(3);
+	(void)systick_timer_start(one_shot, 300UL + (uint32_t)((systick_get_tick64() - base_tick) % 400ULL));
+}
+
+/**
+ * Resets the simulator and starts the systick at the given rate with the
+ * same subscribers and timers for both runs
+ */
+static void test_start(uint32_t tick_hz, test_run_t *run)
+{
+	systick_config_t config = {SYSTICK_ENABLED, tick_hz, SYSTICK_INT_ENABLED, SYSTICK_INTERNAL_CLOCK};
+
+	systick_sim_reset();
+	SystemCoreClock = (uint32_t)TEST_CORE_HZ;
+	systick_dispatch_init();
+	systick_init(&config);
+	systick_sim_advance(1);
+	base_tick = systick_get_tick64();
+	base_us = systick_get_time_us();
+	base_cycles = systick_get_cycles();
+	recording = run;
+	run->count = 0;
+	(void)systick_subscribe(test_subscriber, 50, 0);
+	(void)systick_timer_start(systick_timer_create(test_periodic, NULL, SYSTICK_TIMER_PERIODIC), 137);
+	one_shot = systick_timer_create(test_one_shot, NULL, SYSTICK_TIMER_ONE_SHOT);
+	(void)systick_timer_start(one_shot, 1000);
+}
+
+/**
+ * Tickless run: the idle loop sleeps through the ticks, with other
+ * interrupts waking it at random points
+ */
+static void test_run_tickless(uint32_t tick_hz)
+{
+	uint64_t period = (TEST_CORE_HZ + (tick_hz / 2UL)) / tick_hz;
+	uint64_t end = TEST_TICKS * period;
+	test_run_t *run = &runs[0];
+
+	srand(tick_hz);
+	test_start(tick_hz, run);
+	run->slept = 0;
+	while (systick_sim_cycles() < end)
+	{
+		if ((rand() % 4) == 0)
+		{
+			/* another interrupt, anywhere up to a few ticks ahead */
+			systick_sim_wake_at(systick_sim_cycles() + 1U + ((uint64_t)rand() % (4ULL * period)));
+		}
+		run->slept += systick_tickless_idle(SYSTICK_TICKLESS_NO_LIMIT);
+		systick_sim_advance(1);
+		test_record(TEST_WAKE);
+	}
+}
+
+/**
+ * Reference run: takes every tick, stopping where the tickless run woke
+ */
+static void test_run_reference(uint32_t tick_hz)
+{
+	const test_run_t *tickless = &runs[0];
+	uint32_t i;
+
+	test_start(tick_hz, &runs[1]);
+	for (i = 0; i < tickless->count; i++)
+	{
+		if (tickless->records[i].what == TEST_WAKE)
+		{
+			systick_sim_advance(tickless->records[i].cycle - systick_sim_cycles());
+			test_record(TEST_WAKE);
+		}
+	}
+}
+
+/**
+ * Makes a run in a child process, so it starts from the driver state the
+ * parent never changes
+ */
+static void test_fork(void (*run)(uint32_t tick_hz), uint32_t tick_hz)
+{
+	pid_t child = fork();
+	int status;
+
+	if (child == 0)
+	{
+		run(tick_hz);
+		_exit(0);
+	}
+	if ((child < 0) || (waitpid(child, &status, 0) != child) || (WIFEXITED(status) == 0))
+	{
+		printf("FAIL run at %lu Hz did not complete\n", (unsigned long)tick_hz);
+		failures++;
+	}
+}
+
+/**
+ * Both runs at one tick rate, compared record by record
+ */
+static void test_rate(uint32_t tick_hz)
+{
+	const test_run_t *tickless = &runs[0];
+	const test_run_t *reference = &runs[1];
+	uint32_t shown = 0;
+	uint32_t i;
+
+	runs[0].count = 0;
+	runs[1].count = 0;
+	test_fork(test_run_tickless, tick_hz);
+	test_fork(test_run_reference, tick_hz);
+
+	test_check(tickless->count == reference->count, "records", tick_hz, tickless->count, reference->count);
+	for (i = 0; (i < tickless->count) && (i < reference->count); i++)
+	{
+		const test_record_t *got = &tickless->records[i];
+		const test_record_t *expected = &reference->records[i];
+
+		if ((got->what != expected->what) || (got->tick != expected->tick) || (got->cycle != expected->cycle)
+			|| (got->time_us != expected->time_us) || (got->cycles != expected->cycles))
+		{
+			if (shown++ < 8U)
+			{
+				printf("FAIL record %lu at %lu Hz: what %lu/%lu tick %llu/%llu cycle %llu/%llu us %lu/%lu "
+					   "cycles %lu/%lu\n", (unsigned long)i, (unsigned long)tick_hz,
+					   (unsigned long)got->what, (unsigned long)expected->what,
+					   (unsigned long long)got->tick, (unsigned long long)expected->tick,
+					   (unsigned long long)got->cycle, (unsigned long long)expected->cycle,
+					   (unsigned long)got->time_us, (unsigned long)expected->time_us,
+					   (unsigned long)got->cycles, (unsigned long)expected->cycles);
+			}
+			failures++;
+		}
+	}
+	/* the idle loop must actually have slept through most ticks */
+	test_check(tickless->slept >= ((TEST_TICKS * 3ULL) / 4ULL), "ticks slept", tick_hz, tickless->slept,
+			   TEST_TICKS);
+}
+
+int main(void)
+{
+	static const uint32_t tick_rates[] = {7UL, 1000UL, 1500UL, 30000UL};
+	uint32_t r;
+
+	runs = mmap(NULL, 2U * sizeof(test_run_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (runs == MAP_FAILED)
+	{
+		perror("mmap");
+		return (1);
+	}
+	for (r = 0; r < (sizeof(tick_rates) / sizeof(tick_rates[0])); r++)
+	{
+		test_rate(tick_rates[r]);
+	}
+	printf("%s: %lu failures\n", (failures == 0) ? "PASS" : "FAIL", (unsigned long)failures);
+	return ((failures == 0) ? 0 : 1);
+}
@@ -0,0 +1,267 @@
+/*******************************************************************************
+* Title                 :   Systick Event Log Decoder
+* Filename              :   tools/systick_log_decode.c
+* Origin Date           :   16/10/2026
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   Host
+* Notes                 :   None
+*
+*
+*******************************************************************************/
+/****************************************************************************
+* Doxygen C Template
+* Copyright (c) 2013 - Jacob Beningo - All Rights Reserved
+*
+* Feel free to use this Doxygen Code Template at your own risk for your own
+* purposes.  The latest license and updates for this Doxygen C template can be
+* found at www.beningo.com or by contacting Jacob at jacob@beningo.com.
+*
+* For updates, free software, training and to stay up to date on the latest
+* embedded software techniques sign-up for Jacobs newsletter at
+* http://www.beningo.com/814-2/
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Template.
+*
+*****************************************************************************/
+
+/** @file tools/systick_log_decode.c
+ *  @brief Host decoder for the systick_log.h stream. It reads a dump of
+ *  		log blocks, e.g. a copy of the flash log area. It sorts the blocks
+ *  		by sequence number, so a circular area decodes oldest first. Each
+ *  		event is printed as one line with its absolute time:
+ *
+ *      <time> <event> <arg>
+ *
+ *  Blocks that do not start with a sync record, such as erased pages, are
+ *  skipped. Gaps in the sequence, e.g. blocks overwritten or never stored,
+ *  and damaged blocks are reported on stderr. Decoding continues with the
+ *  next block.
+ *
+ *  Build from the repository root:
+ *
+ *      gcc -O2 -I. tools/systick_log_decode.c -o systick_log_decode
+ *      ./systick_log_decode [-b block_size] [file]
+ *
+ *  The block size defaults to SYSTICK_LOG_BLOCK_SIZE. Without a file the
+ *  stream is read from stdin.
+ */
+/******************************************************************************
+* Includes
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "systick_log.h"
+
+/**
+ * A block found in the dump
+ */
+typedef struct
+{
+	uint32_t sequence;			/**<Sequence number from its sync record */
+	const uint8_t *data;		/**<Start of the block */
+}decode_block_t;
+
+/**
+ * Reads a LEB128 varint at *position, returning 0 if it runs past end
+ */
+static uint32_t decode_varint(const uint8_t *data, uint32_t *position, uint32_t end, uint64_t *value)
+{
+	uint32_t shift = 0;
+	uint8_t byte;
+
+	*value = 0;
+	do
+	{
+		if ((*position >= end) || (shift > 63U))
+		{
+			return (0);
+		}
+		byte = data[(*position)++];
+		*value |= (uint64_t)(byte & 0x7FU) << shift;
+		shift += 7U;
+	} while ((byte & 0x80U) != 0);
+	return (1);
+}
+
+/**
+ * Reads the whole of a stream into memory
+ */
+static uint8_t *decode_read(FILE *file, uint32_t *size)
+{
+	uint8_t *data = NULL;
+	uint8_t *grown;
+	size_t capacity = 0;
+	size_t length = 0;
+	size_t got;
+
+	*size = 0;
+	do
+	{
+		if (length == capacity)
+		{
+			capacity = (capacity != 0) ? (capacity * 2U) : 65536U;
+			grown = realloc(data, capacity);
+			if (grown == NULL)
+			{
+				free(data);
+				return (NULL);
+			}
+			data = grown;
+		}
+		got = fread(&data[length], 1, capacity - length, file);
+		length += got;
+	} while (got != 0);
+	*size = (uint32_t)length;
+	return (data);
+}
+
+/**
+ * Orders blocks by sequence number
+ */
+static int decode_block_compare(const void *a, const void *b)
+{
+	uint32_t sequence_a = ((const decode_block_t *)a)->sequence;
+	uint32_t sequence_b = ((const decode_block_t *)b)->sequence;
+
+	return ((sequence_a > sequence_b) - (sequence_a < sequence_b));
+}
+
+/**
+ * Prints the events of one block, returning the number printed
+ */
+static uint32_t decode_block(const decode_block_t *block, uint32_t block_size)
+{
+	const uint8_t *data = block->data;
+	uint32_t position = 0;
+	uint32_t events = 0;
+	uint64_t time = 0;
+	uint64_t lead;
+	uint64_t sequence;
+	uint64_t event;
+	uint64_t arg;
+
+	while ((position < block_size) && (data[position] != SYSTICK_LOG_PAD))
+	{
+		if (decode_varint(data, &position, block_size, &lead) == 0)
+		{
+			break;
+		}
+		if (lead == SYSTICK_LOG_SYNC)
+		{
+			if ((decode_varint(data, &position, block_size, &sequence) == 0)
+				|| (decode_varint(data, &position, block_size, &time) == 0))
+			{
+				break;
+			}
+			continue;
+		}
+		if (((lead & 1U) != 0) || (decode_varint(data, &position, block_size, &event) == 0)
+			|| (decode_varint(data, &position, block_size, &arg) == 0))
+		{
+			break;
+		}
+		time += lead >> 1;
+		printf("%llu %llu %llu\n", (unsigned long long)time, (unsigned long long)event,
+			   (unsigned long long)arg);
+		events++;
+	}
+	if ((position < block_size) && (data[position] != SYSTICK_LOG_PAD))
+	{
+		fprintf(stderr, "block %lu: damaged at byte %lu, rest of the block skipped\n",
+				(unsigned long)block->sequence, (unsigned long)position);
+	}
+	return (events);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t block_size = SYSTICK_LOG_BLOCK_SIZE;
+	const char *path = NULL;
+	FILE *file = stdin;
+	decode_block_t *blocks;
+	uint8_t *data;
+	uint32_t size;
+	uint32_t count = 0;
+	uint32_t events = 0;
+	uint32_t position;
+	uint32_t offset;
+	uint64_t sequence;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-b") == 0) && ((i + 1) < argc))
+		{
+			block_size = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (argv[i][0] != '-')
+		{
+			path = argv[i];
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-b block_size] [file]\n", argv[0]);
+			return (2);
+		}
+	}
+	if (block_size < (SYSTICK_LOG_SYNC_MAX + SYSTICK_LOG_EVENT_MAX))
+	{
+		fprintf(stderr, "block size %lu too small\n", (unsigned long)block_size);
+		return (2);
+	}
+	if ((path != NULL) && ((file = fopen(path, "rb")) == NULL))
+	{
+		perror(path);
+		return (1);
+	}
+	data = decode_read(file, &size);
+	if (file != stdin)
+	{
+		fclose(file);
+	}
+	blocks = (data != NULL) ? malloc(((size / block_size) + 1U) * sizeof(decode_block_t)) : NULL;
+	if (blocks == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		free(data);
+		return (1);
+	}
+	if ((size % block_size) != 0)
+	{
+		fprintf(stderr, "%lu trailing bytes ignored\n", (unsigned long)(size % block_size));
+	}
+
+	for (offset = 0; (offset + block_size) <= size; offset += block_size)
+	{
+		position = offset + 1U;
+		if ((data[offset] == SYSTICK_LOG_SYNC)
+			&& (decode_varint(data, &position, offset + block_size, &sequence) != 0))
+		{
+			blocks[count].sequence = (uint32_t)sequence;
+			blocks[count].data = &data[offset];
+			count++;
+		}
+	}
+	qsort(blocks, count, sizeof(decode_block_t), decode_block_compare);
+
+	for (i = 0; (uint32_t)i < count; i++)
+	{
+		if ((i > 0) && (blocks[i].sequence == blocks[i - 1].sequence))
+		{
+			fprintf(stderr, "block %lu appears twice\n", (unsigned long)blocks[i].sequence);
+		}
+		else if ((i > 0) && (blocks[i].sequence != (blocks[i - 1].sequence + 1U)))
+		{
+			fprintf(stderr, "blocks %lu to %lu missing\n", (unsigned long)(blocks[i - 1].sequence + 1U),
+					(unsigned long)(blocks[i].sequence - 1U));
+		}
+		events += decode_block(&blocks[i], block_size);
+	}
+	fprintf(stderr, "%lu events in %lu blocks\n", (unsigned long)events, (unsigned long)count);
+	free(blocks);
+	free(data);
+	return (0);
+}